@@ -7,9 +7,71 @@ const char *DEFAULT_RESULT_PATH = "./../results/";
 
 const char *DEFAULT_INPUT_FILENAME = "sample.png";
 
+const char *GRAY_ALPHA_MODE = "ignore";   // 'premultiply' darkens the transparent areas of RGBA and gray + alpha images
 const char BRIGHTNESS_DEFAULT = 20;
 const char SOBEL_THRESHOLD = 100;
 const double STRENGTH_RATIO = .3;
+const char *EDGE_OPERATOR = "scharr";
+const char *COLOR_EDGE_MODE = "dizenzo";   // 'max' keeps the strongest channel, 'dizenzo' combines them
+const char *SOBEL_ROI_REGIONS = "0,0,300,225;200,150,300,225";   // 'x,y,width,height' rectangles or a png mask
+const char *VIDEO_INPUT_FILENAME = "sample.y4m";
+const char *VIDEO_RESULT_FILENAME = "sample_sobel.y4m";
+const char *VIDEO_FORMAT = "y4m";
+const char *HDR_INPUT_FILENAME = "sample.png";   // a 16 bit png or a radiance hdr image
+const long PREVIEW_REDUCTION = 8;   // the preview is 1 / 2, 1 / 4 or 1 / 8 of the size of the image
+const char *GIF_INPUT_FILENAME = "sample.gif";
+const char *GIF_EDGE_OPERATOR = "sobel";
+const char *GIF_OUTPUT = "gif";   // 'gif' for an animated GIF, 'png' for one png file per frame
+
+const char *SEQUENCE_PREFIX = "";   // the frames of a sequence are the png files starting with this prefix
+const unsigned char SEQUENCE_TOLERANCE = 0;   // 0 reuses only the unchanged tiles and keeps every frame exact
+const unsigned char FLAT_TOLERANCE = 0;   // 0 skips only the constant tiles and keeps the result exact
+const char *SOBEL_AUTO_THRESHOLD_MODE = "otsu";
+const char *SOBEL_SWEEP_THRESHOLDS = "50,100,150";
+const char *SOBEL_SWEEP_RATIOS = "0.1,0.3,0.5";
+const char *ADAPTIVE_THRESHOLD_MODE = "sauvola";
+const long ADAPTIVE_WINDOW = 31;
+const double ADAPTIVE_K = 0.2;
+
+const char *MORPHOLOGY_OPERATION = "dilate";
+const long MORPHOLOGY_ELEMENT_SIZE = 3;
+
+const long PYRAMID_LEVELS = 3;
+const long MAX_PYRAMID_LEVELS = 16;
+const bool PYRAMID_COMBINE = true;   // combine the levels by their upsampled maximum, or write every level
+
+const long FOCUS_TILE_SIZE = 64;   // 0 for the whole image only
+const double FOCUS_BLUR_THRESHOLD = 100;   // images with a lower variance of Laplacian are reported as blurry
+
+const char *HASH_METHOD = "phash";
+const char *HASH_FILENAME = "hashes.txt";
+const long HASH_MAX_DISTANCE = 10;
+
+const long RESIZE_WIDTH = 640;
+const long RESIZE_HEIGHT = 360;
+const char *RESIZE_METHOD = "area";
+
+const double SMOOTHING_SIGMA = 1.5;
+const double MAX_SIGMA = 100;
+
+const char *ZERO_CROSSING_OPERATOR = "log";
+const double ZERO_CROSSING_SIGMA = 2;
+const unsigned char ZERO_CROSSING_THRESHOLD = 20;
+
+const unsigned short CANNY_LOW_THRESHOLD = 50;
+const unsigned short CANNY_HIGH_THRESHOLD = 150;
+
+const char *CORNER_RESPONSE = "harris";
+const size_t CORNER_WINDOW = 5;
+const double CORNER_HARRIS_K = 0.04;
+const double CORNER_QUALITY = 0.01;
+const size_t CORNER_MIN_DISTANCE = 5;
+const size_t CORNER_MAX_CORNERS = 500;
+
+const double HOUGH_ANGLE_WINDOW = 10;   // in degrees, 0 votes for every theta
+const size_t HOUGH_THETA_BINS = 180;
+const long HOUGH_MIN_VOTES = 150;
+const long HOUGH_MAX_LINES = 10;
 
 
 #endif //CPU_CONFIG_H
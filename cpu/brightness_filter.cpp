@@ -1,5 +1,6 @@
 
 #include "../filters/brightness_filter.h"
+#include "../filters/parallel.h"
 
 
 /**
@@ -7,18 +8,23 @@
  *
  * The input image is assumed to have a single grayscale channel per pixel,
  * and the output image is stored in a separate buffer allocated by this function.
+ * The change is in the units of the pixel type (levels of 8 or 16 bit pixels, values of float pixels).
+ * Integer pixels are clipped to their range, float pixels are only clipped at 0.
  *
  * @param gray_scaled_img A pointer to the input grayscale image data.
  * @param brightness_changed_img A pointer to a buffer that will hold the resulting brightness-changed image data.
  * @param width The width of the image in pixels.
  * @param height The height of the image in pixels.
  * @param channels The number of color channels per pixel in the input image (should be 1 for grayscale images).
- * @param brightness_change The amount to change the brightness by, in the range [-128, 127].
+ * @param brightness_change The amount to change the brightness by.
  * @return 0 if the brightness change succeeded, or 1 if memory allocation failed or the input image has an invalid number of channels.
  */
-int change_brightness(const ubyte *gray_scaled_img, ubyte **brightness_changed_img, size_t width, size_t height,
+template<typename Pixel>
+int change_brightness(const Pixel *gray_scaled_img, Pixel **brightness_changed_img, size_t width, size_t height,
                       size_t channels,
-                      byte brightness_change) {
+                      double brightness_change) {
+    typedef typename pixel_traits<Pixel>::real real;
+
     // Check if the input image and channels are valid
     if (gray_scaled_img == nullptr || channels != 1) {
         std::cout << "Invalid input image or number of channels. Expected a single-channel grayscale image.\n";
@@ -26,7 +32,7 @@ int change_brightness(const ubyte *gray_scaled_img, ubyte **brightness_changed_i
     }
 
     // Allocate memory for the brightness-changed image
-    *brightness_changed_img = (ubyte *) malloc(width * height * sizeof(ubyte));
+    *brightness_changed_img = (Pixel *) malloc(width * height * sizeof(Pixel));
 
     // Check if the memory was allocated
     if (*brightness_changed_img == nullptr) {
@@ -34,29 +40,30 @@ int change_brightness(const ubyte *gray_scaled_img, ubyte **brightness_changed_i
         return 1;
     }
 
-    // Change the brightness of the image
-    for (int i = 0; i < width * height; i++) {
-        // Get the pixel value
-        ubyte pixel_color = gray_scaled_img[i];
+    // Change the brightness of the image, the clipping is branchless so the loop is vectorized
+    auto change = (real) brightness_change;
+    Pixel *output = *brightness_changed_img;
+    parallel_for(0, width * height, [&](size_t begin, size_t end, size_t) {
+        for (size_t i = begin; i < end; i++) output[i] = to_pixel<Pixel>((real) gray_scaled_img[i] + change);
+    }, width);
 
-        // Change the brightness of the pixel
-        int16 r_ex = pixel_color;
-        int16 b_ex = brightness_change;
+    return 0;
+}
 
-        r_ex = (int16) (r_ex + b_ex);
+template int change_brightness<ubyte>(const ubyte *, ubyte **, size_t, size_t, size_t, double);
 
-        // Clip the pixel value to the range [0, 255]
-        if (r_ex > UCHAR_MAX) {
-            pixel_color = UCHAR_MAX;
-        } else if (r_ex < 0) {
-            pixel_color = 0;
-        } else {
-            pixel_color = r_ex & 0xFF;
-        }
+template int change_brightness<uint16>(const uint16 *, uint16 **, size_t, size_t, size_t, double);
 
-        // Set the pixel in the output buffer
-        (*brightness_changed_img)[i] = pixel_color;
-    }
+template int change_brightness<float>(const float *, float **, size_t, size_t, size_t, double);
 
-    return 0;
-}
\ No newline at end of file
+/**
+ * Changes the brightness of an 8 bit grayscale image (see the template above).
+ *
+ * @param brightness_change The amount to change the brightness by, in the range [-128, 127].
+ */
+int change_brightness(const ubyte *gray_scaled_img, ubyte **brightness_changed_img, size_t width, size_t height,
+                      size_t channels,
+                      byte brightness_change) {
+    return change_brightness<ubyte>(gray_scaled_img, brightness_changed_img, width, height, channels,
+                                    (double) brightness_change);
+}
@@ -0,0 +1,355 @@
+#include <iostream>
+#include <vector>
+#include "../filters/canny_filter.h"
+#include "../filters/sobel_filter.h"
+#include "../filters/parallel.h"
+
+
+#define NOT_EDGE 0
+#define WEAK_EDGE 1
+#define STRONG_EDGE 2
+
+// tan(22.5) and tan(67.5) in Q15 fixed point, used to quantize the gradient direction
+#define TAN_22_5_Q15 13573
+#define TAN_67_5_Q15 79109
+
+// minimum number of rows per band, smaller bands are not worth a thread
+#define MIN_BAND_ROWS 16
+
+
+static void gaussian_smooth(const ubyte *image, ubyte *smoothed, size_t width, size_t height);
+
+static void non_max_suppression(const int16 *gx, const int16 *gy,
+                                const unsigned short *magnitude,
+                                ubyte *edge_class,
+                                size_t width, size_t height,
+                                size_t row_begin, size_t row_end,
+                                unsigned short low_threshold, unsigned short high_threshold);
+
+static void hysteresis(ubyte *edge_class, size_t width, size_t height);
+
+
+/**
+ * Detect Edges by using the Canny edge detector
+ *
+ * The detector runs the following stages, each of them parallelized over bands of rows:
+ * 1. (optional) 5x5 Gaussian smoothing
+ * 2. Sobel gradients (compute_gradients, the same pass detect_edges uses)
+ * 3. non-maximum suppression along the quantized gradient direction and strong/weak classification
+ * 4. hysteresis, weak edges are kept only if they are connected to a strong edge
+ *
+ * @param image input image (single channel)
+ * @param edges_detected_image output image (255 for edge pixels, 0 otherwise)
+ * @param width width of input image
+ * @param height height of input image
+ * @param low_threshold gradient magnitudes above this value are (weak) edge candidates, in [0, CANNY_MAX_MAGNITUDE]
+ * @param high_threshold gradient magnitudes above this value are strong edges, in [0, CANNY_MAX_MAGNITUDE]
+ * @param smooth if true, the image is smoothed with a Gaussian before computing the gradients
+ * @return 1 if any error occurs
+ */
+int detect_edges_canny(const ubyte *image, ubyte **edges_detected_image, size_t width, size_t height,
+                       unsigned short low_threshold,
+                       unsigned short high_threshold,
+                       bool smooth) {
+
+    // Check if the input image and thresholds are valid
+    if (image == nullptr) {
+        std::cout << "Invalid input image\n";
+        return 1;
+    }
+    if (low_threshold > high_threshold) {
+        std::cout << "Invalid thresholds. The low threshold should not be greater than the high threshold.\n";
+        return 1;
+    }
+
+    size_t size = width * height;
+    *edges_detected_image = (ubyte *) malloc(size * sizeof(ubyte));
+    auto *magnitude = (unsigned short *) malloc(size * sizeof(unsigned short));
+    ubyte *smoothed = smooth ? (ubyte *) malloc(size * sizeof(ubyte)) : nullptr;
+
+    // check if the memory was allocated
+    if (*edges_detected_image == nullptr || magnitude == nullptr || (smooth && smoothed == nullptr)) {
+        std::cout << "Failed to allocate memory for the edge detected image!\n";
+        free(*edges_detected_image);
+        free(magnitude);
+        free(smoothed);
+        return 1;
+    }
+
+    // 1. smoothing
+    const ubyte *source = image;
+    if (smooth) {
+        gaussian_smooth(image, smoothed, width, height);
+        source = smoothed;
+    }
+
+    // 2. gradients
+    int16 *gx, *gy;
+    if (compute_gradients(source, &gx, &gy, width, height) != 0) {
+        free(*edges_detected_image);
+        free(magnitude);
+        free(smoothed);
+        return 1;
+    }
+    free(smoothed);
+
+    parallel_for(0, size, [&](size_t begin, size_t end, size_t) {
+        for (size_t i = begin; i < end; i++) {
+            float x = gx[i], y = gy[i];
+            magnitude[i] = (unsigned short) sqrtf(x * x + y * y);
+        }
+    }, MIN_BAND_ROWS * width);
+
+    // 3. non-maximum suppression, the classes are stored in the output buffer
+    ubyte *edge_class = *edges_detected_image;
+    parallel_for(0, height, [&](size_t row_begin, size_t row_end, size_t) {
+        non_max_suppression(gx, gy, magnitude, edge_class,
+                            width, height,
+                            row_begin, row_end,
+                            low_threshold, high_threshold);
+    }, MIN_BAND_ROWS);
+
+    free(gx);
+    free(gy);
+    free(magnitude);
+
+    // 4. hysteresis
+    hysteresis(edge_class, width, height);
+
+    parallel_for(0, size, [&](size_t begin, size_t end, size_t) {
+        for (size_t i = begin; i < end; i++) {
+            edge_class[i] = edge_class[i] == STRONG_EDGE ? UCHAR_MAX : 0;
+        }
+    }, MIN_BAND_ROWS * width);
+
+    return 0;
+}
+
+/**
+ * Smooths an image with the separable 5x5 binomial approximation of a Gaussian ([1, 4, 6, 4, 1] / 16).
+ *
+ * Each row is produced by a vertical pass into a row buffer followed by a horizontal pass, so no
+ * intermediate frame is allocated. Pixels outside the image are replaced by the nearest border pixel.
+ *
+ * @param image The input image.
+ * @param smoothed The output image (width * height elements).
+ * @param width The width of the image in pixels.
+ * @param height The height of the image in pixels.
+ */
+static void gaussian_smooth(const ubyte *image, ubyte *smoothed, size_t width, size_t height) {
+    parallel_for(0, height, [&](size_t row_begin, size_t row_end, size_t) {
+        std::vector<unsigned short> column_sum(width + 4);
+
+        for (size_t i = row_begin; i < row_end; i++) {
+            const ubyte *rows[5];
+            for (long k = -2; k <= 2; k++) {
+                long r = (long) i + k;
+                r = r < 0 ? 0 : (r >= (long) height ? (long) height - 1 : r);
+                rows[k + 2] = image + r * width;
+            }
+
+            // vertical pass, column_sum[j + 2] holds the sum of column j
+            unsigned short *sum = column_sum.data() + 2;
+            for (size_t j = 0; j < width; j++) {
+                sum[j] = (unsigned short) (rows[0][j] + 4 * rows[1][j] + 6 * rows[2][j] + 4 * rows[3][j] +
+                                           rows[4][j]);
+            }
+            sum[-2] = sum[-1] = sum[0];
+            sum[width] = sum[width + 1] = sum[width - 1];
+
+            // horizontal pass, rounded back to a byte
+            ubyte *out = smoothed + i * width;
+            for (size_t j = 0; j < width; j++) {
+                unsigned int value = sum[(long) j - 2] + 4 * sum[(long) j - 1] + 6 * sum[j] + 4 * sum[j + 1] +
+                                     sum[j + 2];
+                out[j] = (ubyte) ((value + 128) >> 8);
+            }
+        }
+    }, MIN_BAND_ROWS);
+}
+
+/**
+ * Thins the gradient magnitude to one pixel wide ridges and classifies the remaining pixels.
+ *
+ * A pixel survives if its magnitude is a local maximum along the gradient direction, quantized to
+ * 0, 45, 90 or 135 degrees. Ties are broken towards the first pixel so that plateaus do not
+ * produce double edges. Pixels on the image border are always suppressed.
+ *
+ * @param gx The x dir gradient.
+ * @param gy The y dir gradient.
+ * @param magnitude The gradient magnitude.
+ * @param edge_class Output classes (NOT_EDGE, WEAK_EDGE or STRONG_EDGE).
+ * @param width The width of the image in pixels.
+ * @param height The height of the image in pixels.
+ * @param row_begin The first row to process.
+ * @param row_end One past the last row to process.
+ * @param low_threshold Magnitudes above this value are weak edges.
+ * @param high_threshold Magnitudes above this value are strong edges.
+ */
+static void non_max_suppression(const int16 *gx, const int16 *gy,
+                                const unsigned short *magnitude,
+                                ubyte *edge_class,
+                                size_t width, size_t height,
+                                size_t row_begin, size_t row_end,
+                                unsigned short low_threshold, unsigned short high_threshold) {
+
+    for (size_t i = row_begin; i < row_end; i++) {
+        for (size_t j = 0; j < width; j++) {
+            size_t index = i * width + j;
+            unsigned short m = magnitude[index];
+
+            // the zero padded border always has a strong gradient, it is never an edge
+            if (m <= low_threshold || i == 0 || j == 0 || i + 1 == height || j + 1 == width) {
+                edge_class[index] = NOT_EDGE;
+                continue;
+            }
+
+            long ax = abs(gx[index]), ay = abs(gy[index]);
+            long di, dj; // offset of the neighbor along the gradient direction
+
+            if ((ay << 15) < ax * TAN_22_5_Q15) {
+                di = 0, dj = 1;
+            } else if ((ay << 15) > ax * TAN_67_5_Q15) {
+                di = 1, dj = 0;
+            } else {
+                di = 1, dj = (gx[index] < 0) == (gy[index] < 0) ? 1 : -1;
+            }
+
+            long ip = (long) i + di, jp = (long) j + dj;
+            long in = (long) i - di, jn = (long) j - dj;
+
+            unsigned short forward = 0, backward = 0;
+            if (ip >= 0 && ip < (long) height && jp >= 0 && jp < (long) width)
+                forward = magnitude[ip * width + jp];
+            if (in >= 0 && in < (long) height && jn >= 0 && jn < (long) width)
+                backward = magnitude[in * width + jn];
+
+            if (m > backward && m >= forward) {
+                edge_class[index] = m > high_threshold ? STRONG_EDGE : WEAK_EDGE;
+            } else {
+                edge_class[index] = NOT_EDGE;
+            }
+        }
+    }
+}
+
+/**
+ * Promotes the weak edge pixels of one band that are in reach of the given seeds.
+ *
+ * The flood fill is 8-connected and does not leave the rows of the band.
+ *
+ * @param edge_class The edge classes of the whole image.
+ * @param width The width of the image in pixels.
+ * @param row_begin The first row of the band.
+ * @param row_end One past the last row of the band.
+ * @param stack The seeds (already marked as strong). Emptied by this function.
+ */
+static void flood_band(ubyte *edge_class, size_t width,
+                       size_t row_begin, size_t row_end,
+                       std::vector<size_t> &stack) {
+    while (!stack.empty()) {
+        size_t index = stack.back();
+        stack.pop_back();
+
+        size_t i = index / width, j = index % width;
+        for (long di = -1; di <= 1; di++) {
+            long r = (long) i + di;
+            if (r < (long) row_begin || r >= (long) row_end) continue;
+            for (long dj = -1; dj <= 1; dj++) {
+                long c = (long) j + dj;
+                if (c < 0 || c >= (long) width) continue;
+
+                size_t neighbor = r * width + c;
+                if (edge_class[neighbor] == WEAK_EDGE) {
+                    edge_class[neighbor] = STRONG_EDGE;
+                    stack.push_back(neighbor);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Collects the weak pixels of a band border row that touch a strong pixel of the adjacent band.
+ *
+ * @param edge_class The edge classes of the whole image.
+ * @param width The width of the image in pixels.
+ * @param row The border row of the band.
+ * @param other_row The border row of the adjacent band.
+ * @param seeds The collected pixels are appended here.
+ */
+static void collect_border_seeds(const ubyte *edge_class, size_t width,
+                                 size_t row, size_t other_row,
+                                 std::vector<size_t> &seeds) {
+    const ubyte *current = edge_class + row * width;
+    const ubyte *other = edge_class + other_row * width;
+
+    for (size_t j = 0; j < width; j++) {
+        if (current[j] != WEAK_EDGE) continue;
+
+        bool touches = other[j] == STRONG_EDGE ||
+                       (j > 0 && other[j - 1] == STRONG_EDGE) ||
+                       (j + 1 < width && other[j + 1] == STRONG_EDGE);
+        if (touches) seeds.push_back(row * width + j);
+    }
+}
+
+/**
+ * Hysteresis thresholding with a band-parallel wavefront.
+ *
+ * Every band first floods the weak pixels connected to its own strong pixels. The bands then
+ * exchange their border rows: weak border pixels touching a strong pixel of the adjacent band become
+ * seeds of the next round. Seeds are collected while nothing is written and flooded while every band
+ * only writes its own rows, so the rounds do not need any locking. The rounds stop once no band
+ * received a new seed.
+ *
+ * @param edge_class The edge classes, weak pixels are promoted to STRONG_EDGE in place.
+ * @param width The width of the image in pixels.
+ * @param height The height of the image in pixels.
+ */
+static void hysteresis(ubyte *edge_class, size_t width, size_t height) {
+    size_t bands = worker_count();
+    if (bands > height / MIN_BAND_ROWS) bands = height / MIN_BAND_ROWS;
+    if (bands == 0) bands = 1;
+
+    std::vector<size_t> band_start(bands + 1);
+    for (size_t b = 0; b <= bands; b++) band_start[b] = b * height / bands;
+
+    std::vector<std::vector<size_t>> seeds(bands);
+
+    // first round, seeded by the strong pixels of each band
+    parallel_for(0, bands, [&](size_t band_begin, size_t band_end, size_t) {
+        for (size_t b = band_begin; b < band_end; b++) {
+            std::vector<size_t> stack;
+            for (size_t index = band_start[b] * width; index < band_start[b + 1] * width; index++) {
+                if (edge_class[index] == STRONG_EDGE) stack.push_back(index);
+            }
+            flood_band(edge_class, width, band_start[b], band_start[b + 1], stack);
+        }
+    });
+
+    // next rounds, seeded across the band borders
+    bool changed = bands > 1;
+    while (changed) {
+        parallel_for(0, bands, [&](size_t band_begin, size_t band_end, size_t) {
+            for (size_t b = band_begin; b < band_end; b++) {
+                seeds[b].clear();
+                if (b > 0)
+                    collect_border_seeds(edge_class, width, band_start[b], band_start[b] - 1, seeds[b]);
+                if (b + 1 < bands)
+                    collect_border_seeds(edge_class, width, band_start[b + 1] - 1, band_start[b + 1], seeds[b]);
+            }
+        });
+
+        changed = false;
+        for (auto &band_seeds: seeds) changed |= !band_seeds.empty();
+        if (!changed) break;
+
+        parallel_for(0, bands, [&](size_t band_begin, size_t band_end, size_t) {
+            for (size_t b = band_begin; b < band_end; b++) {
+                for (size_t index: seeds[b]) edge_class[index] = STRONG_EDGE;
+                flood_band(edge_class, width, band_start[b], band_start[b + 1], seeds[b]);
+            }
+        });
+    }
+}
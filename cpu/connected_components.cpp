@@ -0,0 +1,256 @@
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include "../filters/connected_components.h"
+#include "../filters/parallel.h"
+
+
+// marks a background pixel in the union-find forest
+#define BACKGROUND UINT_MAX
+
+// minimum number of rows per band, smaller bands are not worth a thread
+#define MIN_BAND_ROWS 16
+
+
+/**
+ * Finds the root of a pixel, halving the path on the way.
+ */
+static unsigned int find_root(unsigned int *parent, unsigned int index) {
+    while (parent[index] != index) {
+        parent[index] = parent[parent[index]];
+        index = parent[index];
+    }
+    return index;
+}
+
+/**
+ * Finds the root of a pixel without modifying the forest (safe to call from several threads).
+ */
+static unsigned int find_root_const(const unsigned int *parent, unsigned int index) {
+    while (parent[index] != index) index = parent[index];
+    return index;
+}
+
+/**
+ * Merges the trees of two pixels. The smaller root (the first pixel in raster order) wins, so the
+ * root of a component is always its first pixel, whatever the order of the merges.
+ */
+static void unite(unsigned int *parent, unsigned int a, unsigned int b) {
+    a = find_root(parent, a);
+    b = find_root(parent, b);
+    if (a < b) parent[b] = a;
+    else if (b < a) parent[a] = b;
+}
+
+/**
+ * Merges a foreground pixel with its foreground neighbors in the row above (8-connectivity).
+ */
+static void unite_above(unsigned int *parent, size_t width, size_t i, size_t j) {
+    size_t index = i * width + j, above = index - width;
+    if (j > 0 && parent[above - 1] != BACKGROUND) unite(parent, (unsigned int) index, (unsigned int) (above - 1));
+    if (parent[above] != BACKGROUND) unite(parent, (unsigned int) index, (unsigned int) above);
+    if (j + 1 < width && parent[above + 1] != BACKGROUND)
+        unite(parent, (unsigned int) index, (unsigned int) (above + 1));
+}
+
+
+/**
+ * Labels the 8-connected components of a thresholded edge map and computes their statistics.
+ *
+ * The labeling is block based: every band of rows is labeled in parallel with its own union-find
+ * forest over pixel indices, then the trees are merged across the band borders, which only touches
+ * one row per band. The components are numbered from 1 in raster order of their first pixel, so the
+ * result does not depend on the number of threads. The statistics of a component are accumulated by
+ * the band of its first pixel. The other bands only keep the few components that enter them through
+ * their first row, and these are merged at the end.
+ *
+ * @param edges The edge map (e.g. the output of detect_edges).
+ * @param labels A pointer to a buffer that will hold the label of every pixel (0 for the background).
+ * @param stats A pointer to a buffer that will hold the statistics of every component.
+ * @param count Receives the number of components.
+ * @param width The width of the image in pixels.
+ * @param height The height of the image in pixels.
+ * @param threshold Pixels above this value are foreground.
+ * @return 0 if the labeling succeeded, or 1 if memory allocation failed or the input is invalid.
+ */
+int label_components(const ubyte *edges, unsigned int **labels, component_stats **stats, size_t *count,
+                     size_t width, size_t height,
+                     ubyte threshold) {
+    // Check if the input edges are valid
+    if (edges == nullptr || width * height >= BACKGROUND) {
+        std::cout << "Invalid input edges or image too large\n";
+        return 1;
+    }
+
+    size_t size = width * height;
+    *labels = (unsigned int *) malloc(size * sizeof(unsigned int));
+    auto *parent = (unsigned int *) malloc(size * sizeof(unsigned int));
+
+    // Check if the memory was allocated
+    if (*labels == nullptr || parent == nullptr) {
+        std::cout << "Failed to allocate memory for the labels!\n";
+        free(*labels);
+        free(parent);
+        return 1;
+    }
+
+    // bands
+    size_t bands = worker_count();
+    if (bands > height / MIN_BAND_ROWS) bands = height / MIN_BAND_ROWS;
+    if (bands == 0) bands = 1;
+
+    std::vector<size_t> band_start(bands + 1);
+    for (size_t b = 0; b <= bands; b++) band_start[b] = b * height / bands;
+
+    // 1. local labeling of every band
+    parallel_for(0, bands, [&](size_t band_begin, size_t band_end, size_t) {
+        for (size_t b = band_begin; b < band_end; b++) {
+            for (size_t i = band_start[b]; i < band_start[b + 1]; i++) {
+                for (size_t j = 0; j < width; j++) {
+                    size_t index = i * width + j;
+                    if (edges[index] <= threshold) {
+                        parent[index] = BACKGROUND;
+                        continue;
+                    }
+
+                    parent[index] = (unsigned int) index;
+                    if (j > 0 && parent[index - 1] != BACKGROUND)
+                        unite(parent, (unsigned int) index, (unsigned int) (index - 1));
+                    if (i > band_start[b]) unite_above(parent, width, i, j);
+                }
+            }
+        }
+    });
+
+    // 2. merge the trees across the band borders
+    for (size_t b = 1; b < bands; b++) {
+        size_t i = band_start[b];
+        for (size_t j = 0; j < width; j++) {
+            if (parent[i * width + j] != BACKGROUND) unite_above(parent, width, i, j);
+        }
+    }
+
+    // 3. number the roots in raster order
+    std::vector<size_t> roots_per_band(bands + 1, 0);
+    parallel_for(0, bands, [&](size_t band_begin, size_t band_end, size_t) {
+        for (size_t b = band_begin; b < band_end; b++) {
+            for (size_t index = band_start[b] * width; index < band_start[b + 1] * width; index++)
+                roots_per_band[b + 1] += parent[index] == index;
+        }
+    });
+    for (size_t b = 0; b < bands; b++) roots_per_band[b + 1] += roots_per_band[b];
+    *count = roots_per_band[bands];
+
+    parallel_for(0, bands, [&](size_t band_begin, size_t band_end, size_t) {
+        for (size_t b = band_begin; b < band_end; b++) {
+            auto next = (unsigned int) roots_per_band[b];
+            for (size_t index = band_start[b] * width; index < band_start[b + 1] * width; index++) {
+                if (parent[index] == index) (*labels)[index] = ++next;
+            }
+        }
+    });
+
+    // 4. label every pixel with the label of its root
+    parallel_for(0, size, [&](size_t begin, size_t end, size_t) {
+        for (size_t index = begin; index < end; index++) {
+            if (parent[index] == BACKGROUND) (*labels)[index] = 0;
+            else if (parent[index] != index) (*labels)[index] = (*labels)[find_root_const(parent, (unsigned int) index)];
+        }
+    }, width);
+
+    free(parent);
+
+    // 5. statistics, accumulated per band
+    *stats = (component_stats *) malloc((*count > 0 ? *count : 1) * sizeof(component_stats));
+    if (*stats == nullptr) {
+        std::cout << "Failed to allocate memory for the component statistics!\n";
+        free(*labels);
+        return 1;
+    }
+
+    struct accumulator {
+        size_t area, min_x, min_y, max_x, max_y;
+        unsigned long long sum_x, sum_y;
+    };
+    const accumulator empty = {0, SIZE_MAX, SIZE_MAX, 0, 0, 0, 0};
+
+    // the labels of a band are the ones first seen in it, plus the components of earlier bands that
+    // continue into it: these are connected, so they cross the first row of the band
+    std::vector<accumulator> totals(*count, empty);
+    std::vector<std::vector<unsigned int>> entering_labels(bands);
+    std::vector<std::vector<accumulator>> entering(bands);
+
+    parallel_for(0, bands, [&](size_t band_begin, size_t band_end, size_t) {
+        for (size_t b = band_begin; b < band_end; b++) {
+            auto first_label = (unsigned int) roots_per_band[b] + 1;
+
+            std::vector<unsigned int> &band_labels = entering_labels[b];
+            const unsigned int *first_row = *labels + band_start[b] * width;
+            for (size_t j = 0; j < width; j++) {
+                if (first_row[j] != 0 && first_row[j] < first_label) band_labels.push_back(first_row[j]);
+            }
+            std::sort(band_labels.begin(), band_labels.end());
+            band_labels.erase(std::unique(band_labels.begin(), band_labels.end()), band_labels.end());
+            entering[b].assign(band_labels.size(), empty);
+
+            unsigned int last_label = 0;
+            accumulator *a = nullptr;
+            for (size_t i = band_start[b]; i < band_start[b + 1]; i++) {
+                for (size_t j = 0; j < width; j++) {
+                    unsigned int label = (*labels)[i * width + j];
+                    if (label == 0) continue;
+
+                    if (label != last_label) {
+                        if (label >= first_label) {
+                            a = &totals[label - 1];
+                        } else {
+                            auto slot = std::lower_bound(band_labels.begin(), band_labels.end(), label);
+                            a = &entering[b][slot - band_labels.begin()];
+                        }
+                        last_label = label;
+                    }
+
+                    a->area++;
+                    a->min_x = j < a->min_x ? j : a->min_x;
+                    a->min_y = i < a->min_y ? i : a->min_y;
+                    a->max_x = j > a->max_x ? j : a->max_x;
+                    a->max_y = i > a->max_y ? i : a->max_y;
+                    a->sum_x += j;
+                    a->sum_y += i;
+                }
+            }
+        }
+    });
+
+    for (size_t b = 1; b < bands; b++) {
+        for (size_t k = 0; k < entering_labels[b].size(); k++) {
+            accumulator &total = totals[entering_labels[b][k] - 1];
+            const accumulator &a = entering[b][k];
+            total.area += a.area;
+            total.min_x = a.min_x < total.min_x ? a.min_x : total.min_x;
+            total.min_y = a.min_y < total.min_y ? a.min_y : total.min_y;
+            total.max_x = a.max_x > total.max_x ? a.max_x : total.max_x;
+            total.max_y = a.max_y > total.max_y ? a.max_y : total.max_y;
+            total.sum_x += a.sum_x;
+            total.sum_y += a.sum_y;
+        }
+    }
+
+    parallel_for(0, *count, [&](size_t begin, size_t end, size_t) {
+        for (size_t k = begin; k < end; k++) {
+            const accumulator &total = totals[k];
+
+            component_stats &s = (*stats)[k];
+            s.label = (unsigned int) (k + 1);
+            s.area = total.area;
+            s.min_x = total.min_x, s.min_y = total.min_y;
+            s.max_x = total.max_x, s.max_y = total.max_y;
+            s.centroid_x = (double) total.sum_x / (double) total.area;
+            s.centroid_y = (double) total.sum_y / (double) total.area;
+        }
+    });
+
+    return 0;
+}
@@ -0,0 +1,238 @@
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include "../filters/corner_detector.h"
+#include "../filters/sobel_filter.h"
+#include "../filters/parallel.h"
+
+
+// minimum number of rows per band, smaller bands are not worth a thread
+#define MIN_BAND_ROWS 16
+
+
+/**
+ * Sums a padded row over a sliding window of 2 * radius + 1 pixels.
+ *
+ * The window offset is the outer loop, so the inner loop is a plain vectorizable addition of two rows.
+ *
+ * @param padded The input row with radius zeros on both sides (width + 2 * radius elements).
+ * @param output Output buffer for the sums (width elements).
+ * @param width The number of pixels in the row.
+ * @param radius The radius of the window.
+ */
+static void box_sum_row(const float *padded, float *output, size_t width, size_t radius) {
+    std::fill(output, output + width, 0.0f);
+    for (size_t k = 0; k <= 2 * radius; k++) {
+        const float *shifted = padded + k;
+        for (size_t j = 0; j < width; j++) output[j] += shifted[j];
+    }
+}
+
+/**
+ * Computes the corner response of a row from the summed structure tensor.
+ *
+ * The tensor is [[a, b], [b, c]]. Harris uses det - k * trace^2, Shi-Tomasi the smaller eigenvalue.
+ * Both loops are branch free and vectorize.
+ */
+static void response_row(const float *a, const float *b, const float *c, float *output, size_t width,
+                         corner_response response, float harris_k) {
+    if (response == CORNER_HARRIS) {
+        for (size_t j = 0; j < width; j++) {
+            float trace = a[j] + c[j];
+            output[j] = a[j] * c[j] - b[j] * b[j] - harris_k * trace * trace;
+        }
+    } else {
+        for (size_t j = 0; j < width; j++) {
+            float half_difference = (a[j] - c[j]) * 0.5f;
+            output[j] = (a[j] + c[j]) * 0.5f - sqrtf(half_difference * half_difference + b[j] * b[j]);
+        }
+    }
+}
+
+
+/**
+ * Detects the Sobel edges and the corners of an image in a single pass over its rows.
+ *
+ * Every band of rows computes the Sobel gradients of its rows once (plus a halo of window / 2 rows
+ * on each side) and uses them twice: the magnitudes are thresholded into the edge map exactly like
+ * detect_edges does, and the gradient products Gx^2, Gy^2 and Gx*Gy are summed over a separable
+ * window x window box into the structure tensor, from which the corner response is computed.
+ *
+ * The corners are then found by a parallel non-maximum suppression over bands of the response map:
+ * a corner is a pixel whose response is at least quality times the strongest response and that is
+ * the maximum of its (2 * min_distance + 1) square neighborhood. Pixels whose window reaches past the
+ * image border are skipped, the zero padding of the Sobel filter makes them look like corners.
+ *
+ * @param image A pointer to the input image data (single channel).
+ * @param edges_detected_image A pointer to a buffer that will hold the edge map.
+ * @param corners A pointer to a buffer that will hold the corners, strongest first.
+ * @param count Receives the number of corners.
+ * @param width The width of the image in pixels.
+ * @param height The height of the image in pixels.
+ * @param threshold The threshold value for edge detection.
+ * @param strength_ratio The ratio used to strengthen or weaken the edges.
+ * @param response CORNER_HARRIS or CORNER_SHI_TOMASI.
+ * @param window The size of the (square) window of the structure tensor, odd.
+ * @param harris_k The sensitivity of the Harris response (usually 0.04 - 0.06).
+ * @param quality The minimum response of a corner, relative to the strongest response.
+ * @param min_distance The radius of the non-maximum suppression in pixels.
+ * @param max_corners The maximum number of corners to return.
+ * @return 0 if the detection succeeded, or 1 if memory allocation failed or the input is invalid.
+ */
+int detect_edges_and_corners(const ubyte *image, ubyte **edges_detected_image,
+                             corner **corners, size_t *count,
+                             size_t width, size_t height,
+                             ubyte threshold,
+                             double strength_ratio,
+                             corner_response response,
+                             size_t window,
+                             double harris_k,
+                             double quality,
+                             size_t min_distance,
+                             size_t max_corners) {
+    // Check if the input image and window are valid
+    if (image == nullptr || window == 0 || window % 2 == 0) {
+        std::cout << "Invalid input image or window size\n";
+        return 1;
+    }
+
+    size_t size = width * height;
+    *edges_detected_image = (ubyte *) malloc(size * sizeof(ubyte));
+    auto *responses = (float *) malloc(size * sizeof(float));
+
+    // check if the memory was allocated
+    if (*edges_detected_image == nullptr || responses == nullptr) {
+        std::cout << "Failed to allocate memory for the edges and corners!\n";
+        free(*edges_detected_image);
+        free(responses);
+        return 1;
+    }
+
+    ubyte table[SOBEL_MAGNITUDE_LEVELS];
+    build_edge_strength_table(threshold, strength_ratio, table);
+
+    size_t radius = window / 2;
+    std::vector<float> band_max(worker_count(), 0.0f);
+
+    // 1. edges and corner responses, one traversal of the rows
+    parallel_for(0, height, [&](size_t row_begin, size_t row_end, size_t worker) {
+        size_t halo_begin = row_begin > radius ? row_begin - radius : 0;
+        size_t halo_end = row_end + radius < height ? row_end + radius : height;
+        size_t rows = halo_end - halo_begin;
+
+        // horizontally summed gradient products of the band and its halo
+        std::vector<float> sum_xx(rows * width), sum_yy(rows * width), sum_xy(rows * width);
+
+        std::vector<int16> gx(width), gy(width);
+        std::vector<unsigned short> magnitudes(width);
+        std::vector<float> xx(width + 2 * radius, 0.0f), yy(width + 2 * radius, 0.0f), xy(width + 2 * radius, 0.0f);
+
+        for (size_t i = halo_begin; i < halo_end; i++) {
+            const ubyte *above = i > 0 ? image + (i - 1) * width : nullptr;
+            const ubyte *below = i + 1 < height ? image + (i + 1) * width : nullptr;
+            sobel_gradient_row(above, image + i * width, below, gx.data(), gy.data(), width);
+
+            if (i >= row_begin && i < row_end) {
+                sobel_magnitude_row(gx.data(), gy.data(), magnitudes.data(), width);
+                ubyte *output = *edges_detected_image + i * width;
+                for (size_t j = 0; j < width; j++) output[j] = table[magnitudes[j]];
+            }
+
+            for (size_t j = 0; j < width; j++) {
+                auto x = (float) gx[j], y = (float) gy[j];
+                xx[j + radius] = x * x;
+                yy[j + radius] = y * y;
+                xy[j + radius] = x * y;
+            }
+
+            size_t offset = (i - halo_begin) * width;
+            box_sum_row(xx.data(), sum_xx.data() + offset, width, radius);
+            box_sum_row(yy.data(), sum_yy.data() + offset, width, radius);
+            box_sum_row(xy.data(), sum_xy.data() + offset, width, radius);
+        }
+
+        std::vector<float> a(width), b(width), c(width);
+        float maximum = 0;
+
+        for (size_t i = row_begin; i < row_end; i++) {
+            size_t top = i > radius ? i - radius : 0;
+            size_t bottom = i + radius + 1 < height ? i + radius + 1 : height;
+
+            std::fill(a.begin(), a.end(), 0.0f);
+            std::fill(b.begin(), b.end(), 0.0f);
+            std::fill(c.begin(), c.end(), 0.0f);
+            for (size_t k = top; k < bottom; k++) {
+                size_t offset = (k - halo_begin) * width;
+                for (size_t j = 0; j < width; j++) {
+                    a[j] += sum_xx[offset + j];
+                    b[j] += sum_xy[offset + j];
+                    c[j] += sum_yy[offset + j];
+                }
+            }
+
+            float *output = responses + i * width;
+            response_row(a.data(), b.data(), c.data(), output, width, response, (float) harris_k);
+            for (size_t j = 0; j < width; j++) maximum = output[j] > maximum ? output[j] : maximum;
+        }
+
+        band_max[worker] = maximum;
+    }, MIN_BAND_ROWS);
+
+    float cutoff = (float) quality * *std::max_element(band_max.begin(), band_max.end());
+
+    // 2. non-maximum suppression, ties go to the first pixel in raster order
+    size_t margin = radius + 1;
+    auto distance = (long) (min_distance > 0 ? min_distance : 1);
+    std::vector<std::vector<corner>> band_corners(worker_count());
+
+    parallel_for(0, height, [&](size_t row_begin, size_t row_end, size_t worker) {
+        for (size_t i = row_begin; i < row_end; i++) {
+            if (i < margin || i + margin >= height) continue;
+
+            for (size_t j = margin; j + margin < width; j++) {
+                float value = responses[i * width + j];
+                if (value <= 0 || value < cutoff) continue;
+
+                bool maximum = true;
+                for (long di = -distance; di <= distance && maximum; di++) {
+                    long ni = (long) i + di;
+                    if (ni < 0 || ni >= (long) height) continue;
+                    for (long dj = -distance; dj <= distance; dj++) {
+                        long nj = (long) j + dj;
+                        if ((di == 0 && dj == 0) || nj < 0 || nj >= (long) width) continue;
+
+                        float neighbor = responses[ni * width + nj];
+                        bool before = di < 0 || (di == 0 && dj < 0);
+                        if (neighbor > value || (before && neighbor == value)) {
+                            maximum = false;
+                            break;
+                        }
+                    }
+                }
+
+                if (maximum) band_corners[worker].push_back({j, i, value});
+            }
+        }
+    }, MIN_BAND_ROWS);
+
+    free(responses);
+
+    std::vector<corner> found;
+    for (auto &band: band_corners) found.insert(found.end(), band.begin(), band.end());
+    std::stable_sort(found.begin(), found.end(), [](const corner &p, const corner &q) {
+        if (p.response != q.response) return p.response > q.response;
+        return p.y != q.y ? p.y < q.y : p.x < q.x;
+    });
+    if (found.size() > max_corners) found.resize(max_corners);
+
+    *count = found.size();
+    *corners = (corner *) malloc((found.empty() ? 1 : found.size()) * sizeof(corner));
+    if (*corners == nullptr) {
+        std::cout << "Failed to allocate memory for the corners!\n";
+        free(*edges_detected_image);
+        return 1;
+    }
+    std::copy(found.begin(), found.end(), *corners);
+
+    return 0;
+}
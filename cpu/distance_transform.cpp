@@ -0,0 +1,154 @@
+#include <iostream>
+#include <vector>
+#include <limits>
+#include "../filters/distance_transform.h"
+#include "../filters/parallel.h"
+
+
+// number of columns every thread sweeps at once in the vertical pass
+#define COLUMN_STRIP 64
+
+// minimum number of rows per band, smaller bands are not worth a thread
+#define MIN_BAND_ROWS 16
+
+
+/**
+ * Computes the squared distance transform of a sampled function in one dimension.
+ *
+ * This is the lower envelope of the parabolas (q - p)^2 + f(q) from "Distance Transforms of Sampled
+ * Functions" (Felzenszwalb and Huttenlocher), which runs in linear time whatever the input.
+ *
+ * @param f The sampled function (n elements).
+ * @param d Output buffer for the transform (n elements).
+ * @param v Scratch buffer for the locations of the parabolas (n elements).
+ * @param z Scratch buffer for the boundaries between the parabolas (n + 1 elements).
+ * @param n The number of samples.
+ */
+static void distance_transform_1d(const double *f, double *d, size_t *v, double *z, size_t n) {
+    size_t k = 0;
+    v[0] = 0;
+    z[0] = -std::numeric_limits<double>::infinity();
+    z[1] = std::numeric_limits<double>::infinity();
+
+    for (size_t q = 1; q < n; q++) {
+        auto dq = (double) q;
+        double s;
+        while (true) {
+            auto dv = (double) v[k];
+            s = ((f[q] + dq * dq) - (f[v[k]] + dv * dv)) / (2 * dq - 2 * dv);
+            if (s > z[k]) break;
+            k--;
+        }
+
+        k++;
+        v[k] = q;
+        z[k] = s;
+        z[k + 1] = std::numeric_limits<double>::infinity();
+    }
+
+    k = 0;
+    for (size_t q = 0; q < n; q++) {
+        while (z[k + 1] < (double) q) k++;
+        auto offset = (double) q - (double) v[k];
+        d[q] = offset * offset + f[v[k]];
+    }
+}
+
+
+/**
+ * Computes the exact Euclidean distance from every pixel to the nearest edge pixel.
+ *
+ * The transform is separable:
+ * 1. Columns, in parallel strips: the distance to the nearest edge in the same column, from a
+ *    downward and an upward sweep. Every step of a sweep is a vectorizable operation on a row of
+ *    the strip, so the pass reads the image row by row.
+ * 2. Rows, in parallel bands: the squared column distances are combined along every row with the
+ *    Felzenszwalb-Huttenlocher lower envelope of parabolas.
+ *
+ * Both passes are linear in the number of pixels, whatever the density of the edges.
+ *
+ * @param edges The edge map (e.g. the output of detect_edges).
+ * @param distances A pointer to a buffer that will hold the distances in pixels (infinity if there is no edge at all).
+ * @param width The width of the image in pixels.
+ * @param height The height of the image in pixels.
+ * @param threshold Pixels above this value are edges.
+ * @return 0 if the transform succeeded, or 1 if memory allocation failed or the input is invalid.
+ */
+int distance_transform(const ubyte *edges, float **distances, size_t width, size_t height,
+                       ubyte threshold) {
+    // Check if the input edges are valid
+    if (edges == nullptr) {
+        std::cout << "Invalid input edges\n";
+        return 1;
+    }
+
+    size_t size = width * height;
+    *distances = (float *) malloc(size * sizeof(float));
+    auto *columns = (unsigned int *) malloc(size * sizeof(unsigned int));
+
+    // Check if the memory was allocated
+    if (*distances == nullptr || columns == nullptr) {
+        std::cout << "Failed to allocate memory for the distances!\n";
+        free(*distances);
+        free(columns);
+        return 1;
+    }
+
+    // larger than any distance inside the image
+    auto far = (unsigned int) (width + height);
+
+    // 1. vertical distances
+    size_t strips = (width + COLUMN_STRIP - 1) / COLUMN_STRIP;
+    parallel_for(0, strips, [&](size_t strip_begin, size_t strip_end, size_t) {
+        size_t column_begin = strip_begin * COLUMN_STRIP;
+        size_t column_end = strip_end * COLUMN_STRIP < width ? strip_end * COLUMN_STRIP : width;
+
+        for (size_t i = 0; i < height; i++) {
+            const ubyte *in = edges + i * width;
+            unsigned int *current = columns + i * width;
+            const unsigned int *previous = current - width;
+
+            for (size_t j = column_begin; j < column_end; j++) {
+                unsigned int above = i > 0 ? previous[j] + 1 : far;
+                current[j] = in[j] > threshold ? 0 : (above < far ? above : far);
+            }
+        }
+
+        for (size_t i = height; i-- > 1;) {
+            unsigned int *current = columns + (i - 1) * width;
+            const unsigned int *next = current + width;
+
+            for (size_t j = column_begin; j < column_end; j++) {
+                unsigned int below = next[j] + 1;
+                current[j] = below < current[j] ? below : current[j];
+            }
+        }
+    });
+
+    // 2. horizontal lower envelopes
+    bool empty = true;
+    for (size_t j = 0; j < width && height > 0 && empty; j++) empty = columns[j] >= far;
+
+    parallel_for(0, height, [&](size_t row_begin, size_t row_end, size_t) {
+        std::vector<double> f(width), d(width), z(width + 1);
+        std::vector<size_t> v(width);
+
+        for (size_t i = row_begin; i < row_end; i++) {
+            float *out = *distances + i * width;
+            if (empty) {
+                std::fill(out, out + width, std::numeric_limits<float>::infinity());
+                continue;
+            }
+
+            const unsigned int *in = columns + i * width;
+            for (size_t j = 0; j < width; j++) f[j] = (double) in[j] * (double) in[j];
+
+            distance_transform_1d(f.data(), d.data(), v.data(), z.data(), width);
+            for (size_t j = 0; j < width; j++) out[j] = (float) sqrt(d[j]);
+        }
+    }, MIN_BAND_ROWS);
+
+    free(columns);
+
+    return 0;
+}
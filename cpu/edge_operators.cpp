@@ -0,0 +1,269 @@
+#include <iostream>
+#include <vector>
+#include "../filters/edge_operators.h"
+#include "../filters/sobel_filter.h"
+#include "../filters/parallel.h"
+
+
+/**
+ * The separable kernels of a gradient operator: Gx is derivative (horizontal) x smooth (vertical),
+ * Gy is smooth (horizontal) x derivative (vertical). normalize brings the response to the gain of
+ * the 3x3 Sobel operator (8 times the slope of a ramp), so every operator shares its thresholds.
+ */
+template<edge_operator Op>
+struct operator_kernels;
+
+template<>
+struct operator_kernels<OPERATOR_SCHARR> {
+    static constexpr int radius = 1;
+    static constexpr int smooth[3] = {3, 10, 3};
+    static constexpr int derivative[3] = {-1, 0, 1};
+
+    static int normalize(int value) { return value / 4; }
+};
+
+template<>
+struct operator_kernels<OPERATOR_PREWITT> {
+    static constexpr int radius = 1;
+    static constexpr int smooth[3] = {1, 1, 1};
+    static constexpr int derivative[3] = {-1, 0, 1};
+
+    static int normalize(int value) { return value * 4 / 3; }
+};
+
+template<>
+struct operator_kernels<OPERATOR_SOBEL_5> {
+    static constexpr int radius = 2;
+    static constexpr int smooth[5] = {1, 4, 6, 4, 1};
+    static constexpr int derivative[5] = {-1, -2, 0, 2, 1};
+
+    static int normalize(int value) { return value / 16; }
+};
+
+template<>
+struct operator_kernels<OPERATOR_SOBEL_7> {
+    static constexpr int radius = 3;
+    static constexpr int smooth[7] = {1, 6, 15, 20, 15, 6, 1};
+    static constexpr int derivative[7] = {-1, -4, -5, 0, 5, 4, 1};
+
+    static int normalize(int value) { return value / 256; }
+};
+
+
+/**
+ * Returns a row of the image, or a zero row for the rows outside of it.
+ */
+static const ubyte *row_or_zero(const ubyte *image, size_t width, size_t height, long row) {
+    static thread_local std::vector<ubyte> zero_row;
+    if (row >= 0 && row < (long) height) return image + row * width;
+
+    if (zero_row.size() < width) zero_row.assign(width, 0);
+    return zero_row.data();
+}
+
+/**
+ * Computes the gradients of a row with a separable operator.
+ *
+ * The vertical pass produces the smoothed and the differentiated columns of the row, the horizontal
+ * pass combines them. The kernel sizes are compile time constants, so both passes are fully unrolled
+ * and vectorized over the columns. Pixels outside the image are zero, like for detect_edges.
+ */
+template<edge_operator Op>
+static void separable_gradient_row(const ubyte *image, size_t width, size_t height, size_t row,
+                                   int16 *gx, int16 *gy) {
+    using kernels = operator_kernels<Op>;
+    constexpr int radius = kernels::radius;
+    constexpr int size = 2 * radius + 1;
+
+    const ubyte *rows[size];
+    for (int k = 0; k < size; k++) rows[k] = row_or_zero(image, width, height, (long) row + k - radius);
+
+    // smoothed and differentiated columns, with radius zeros on both sides
+    static thread_local std::vector<int> columns;
+    if (columns.size() < 2 * (width + 2 * radius)) columns.resize(2 * (width + 2 * radius));
+    int *smoothed = columns.data(), *differentiated = columns.data() + width + 2 * radius;
+    for (int k = 0; k < radius; k++) {
+        smoothed[k] = smoothed[width + radius + k] = 0;
+        differentiated[k] = differentiated[width + radius + k] = 0;
+    }
+
+    for (size_t j = 0; j < width; j++) {
+        int smooth = 0, derivative = 0;
+        for (int k = 0; k < size; k++) {
+            smooth += kernels::smooth[k] * rows[k][j];
+            derivative += kernels::derivative[k] * rows[k][j];
+        }
+        smoothed[j + radius] = smooth;
+        differentiated[j + radius] = derivative;
+    }
+
+    for (size_t j = 0; j < width; j++) {
+        int x = 0, y = 0;
+        for (int k = 0; k < size; k++) {
+            x += kernels::derivative[k] * smoothed[j + k];
+            y += kernels::smooth[k] * differentiated[j + k];
+        }
+        gx[j] = (int16) kernels::normalize(x);
+        gy[j] = (int16) kernels::normalize(y);
+    }
+}
+
+/**
+ * Computes the gradients of a row with the Roberts cross.
+ *
+ * The two diagonal differences r1 = p(i, j) - p(i + 1, j + 1) and r2 = p(i, j + 1) - p(i + 1, j)
+ * are rotated back to the x and y directions and scaled to the gain of the Sobel operator.
+ */
+static void roberts_gradient_row(const ubyte *image, size_t width, size_t height, size_t row,
+                                 int16 *gx, int16 *gy) {
+    const ubyte *current = image + row * width;
+    const ubyte *below = row_or_zero(image, width, height, (long) row + 1);
+
+    for (size_t j = 0; j + 1 < width; j++) {
+        int r1 = current[j] - below[j + 1];
+        int r2 = current[j + 1] - below[j];
+        gx[j] = (int16) (4 * (r2 - r1));
+        gy[j] = (int16) (-4 * (r1 + r2));
+    }
+
+    // the column right of the image is zero
+    size_t last = width - 1;
+    int r1 = current[last], r2 = -below[last];
+    gx[last] = (int16) (4 * (r2 - r1));
+    gy[last] = (int16) (-4 * (r1 + r2));
+}
+
+
+/**
+ * Computes the gradients of a single image row with the given operator.
+ *
+ * The gradients of every operator are normalized to the gain of the 3x3 Sobel operator, so their
+ * magnitudes can be thresholded with sobel_magnitude_row and the same thresholds.
+ *
+ * @param op The gradient operator.
+ * @param image The input image (single channel).
+ * @param width The width of the image in pixels.
+ * @param height The height of the image in pixels.
+ * @param row The row to compute.
+ * @param gx Output buffer for the x dir gradient (width elements).
+ * @param gy Output buffer for the y dir gradient (width elements).
+ */
+void operator_gradient_row(edge_operator op, const ubyte *image, size_t width, size_t height, size_t row,
+                           int16 *gx, int16 *gy) {
+    if (width == 0) return;
+
+    switch (op) {
+        case OPERATOR_SCHARR:
+            separable_gradient_row<OPERATOR_SCHARR>(image, width, height, row, gx, gy);
+            break;
+        case OPERATOR_PREWITT:
+            separable_gradient_row<OPERATOR_PREWITT>(image, width, height, row, gx, gy);
+            break;
+        case OPERATOR_ROBERTS:
+            roberts_gradient_row(image, width, height, row, gx, gy);
+            break;
+        case OPERATOR_SOBEL_5:
+            separable_gradient_row<OPERATOR_SOBEL_5>(image, width, height, row, gx, gy);
+            break;
+        case OPERATOR_SOBEL_7:
+            separable_gradient_row<OPERATOR_SOBEL_7>(image, width, height, row, gx, gy);
+            break;
+        case OPERATOR_SOBEL:
+        default:
+            sobel_gradient_row(row > 0 ? image + (row - 1) * width : nullptr,
+                               image + row * width,
+                               row + 1 < height ? image + (row + 1) * width : nullptr,
+                               gx, gy, width);
+            break;
+    }
+}
+
+/**
+ * Computes the signed gradients of a whole image with the given operator.
+ *
+ * @param image input image (single channel)
+ * @param gx output x dir gradient, allocated by this function
+ * @param gy output y dir gradient, allocated by this function
+ * @param width width of input image
+ * @param height height of input image
+ * @param op gradient operator
+ * @return 1 if any error occurs
+ */
+int compute_operator_gradients(const ubyte *image, int16 **gx, int16 **gy, size_t width, size_t height,
+                               edge_operator op) {
+    // Check if the input image is valid
+    if (image == nullptr) {
+        std::cout << "Invalid input image\n";
+        return 1;
+    }
+
+    *gx = (int16 *) malloc(width * height * sizeof(int16));
+    *gy = (int16 *) malloc(width * height * sizeof(int16));
+
+    // check if the memory was allocated
+    if (*gx == nullptr || *gy == nullptr) {
+        std::cout << "Failed to allocate memory for the gradients!\n";
+        free(*gx);
+        free(*gy);
+        return 1;
+    }
+
+    parallel_for(0, height, [&](size_t row_begin, size_t row_end, size_t) {
+        for (size_t i = row_begin; i < row_end; i++)
+            operator_gradient_row(op, image, width, height, i, *gx + i * width, *gy + i * width);
+    });
+
+    return 0;
+}
+
+/**
+ * Detect Edges by using the given gradient operator
+ *
+ * Same as detect_edges, with the Sobel kernels replaced by Scharr, Prewitt, Roberts cross or the
+ * 5x5 / 7x7 Sobel kernels. OPERATOR_SOBEL gives the same result as detect_edges.
+ *
+ * @param image input image
+ * @param edges_detected_image output image
+ * @param width width of input image
+ * @param height height of input image
+ * @param op gradient operator
+ * @param threshold threshold to apply
+ * @param strength_ratio ratio used to strengthen or weaken the edges
+ * @return 1 if any error occurs
+ */
+int detect_edges_operator(const ubyte *image, ubyte **edges_detected_image, size_t width, size_t height,
+                          edge_operator op,
+                          ubyte threshold,
+                          double strength_ratio) {
+    // Check if the input image is valid
+    if (image == nullptr) {
+        std::cout << "Invalid input image\n";
+        return 1;
+    }
+
+    *edges_detected_image = (ubyte *) malloc(width * height * sizeof(ubyte));
+
+    // check if the memory was allocated
+    if (*edges_detected_image == nullptr) {
+        std::cout << "Failed to allocate memory for the edge detected image!\n";
+        return 1;
+    }
+
+    ubyte table[SOBEL_MAGNITUDE_LEVELS];
+    build_edge_strength_table(threshold, strength_ratio, table);
+
+    parallel_for(0, height, [&](size_t row_begin, size_t row_end, size_t) {
+        std::vector<int16> gx(width), gy(width);
+        std::vector<unsigned short> magnitudes(width);
+
+        for (size_t i = row_begin; i < row_end; i++) {
+            operator_gradient_row(op, image, width, height, i, gx.data(), gy.data());
+            sobel_magnitude_row(gx.data(), gy.data(), magnitudes.data(), width);
+
+            ubyte *output = *edges_detected_image + i * width;
+            for (size_t j = 0; j < width; j++) output[j] = table[magnitudes[j]];
+        }
+    });
+
+    return 0;
+}
@@ -0,0 +1,142 @@
+#include <iostream>
+#include <vector>
+#include "../filters/focus_metrics.h"
+#include "../filters/sobel_filter.h"
+#include "../filters/parallel.h"
+
+
+// minimum number of rows per band, smaller bands are not worth a thread
+#define MIN_BAND_ROWS 16
+
+
+/**
+ * The exact integer sums a tile reduces to.
+ */
+struct focus_sums {
+    unsigned long long gradient;            // sum of gx^2 + gy^2
+    long long laplacian;                    // sum of the Laplacian
+    unsigned long long laplacian_squared;   // sum of the squared Laplacian
+    unsigned long long edges;
+    unsigned long long pixels;
+
+    void add(const focus_sums &other) {
+        gradient += other.gradient;
+        laplacian += other.laplacian;
+        laplacian_squared += other.laplacian_squared;
+        edges += other.edges;
+        pixels += other.pixels;
+    }
+
+    focus_metrics metrics() const {
+        if (pixels == 0) return {0, 0, 0};
+        auto n = (double) pixels;
+        double mean = (double) laplacian / n;
+        return {(double) gradient / n, (double) laplacian_squared / n - mean * mean, (double) edges / n};
+    }
+};
+
+
+/**
+ * Computes the focus metrics of an image, and of its tiles, without producing any output image.
+ *
+ * Every row is reduced as soon as its Sobel gradients and its Laplacian are computed, so the pass
+ * streams over the image and only keeps a row of gradients per thread. The rows are split into bands
+ * that are processed in parallel, every band sums into its own tiles, and the bands are added at the
+ * end. The sums are exact integers, so the result does not depend on the number of threads.
+ *
+ * Only the pixels with all 8 neighbors inside the image are measured: the zero padding of the Sobel
+ * operator would otherwise make the border of every image look sharp.
+ *
+ * @param image A pointer to the input image data (single channel).
+ * @param width The width of the image in pixels.
+ * @param height The height of the image in pixels.
+ * @param threshold Pixels whose Sobel magnitude is above this value count as edges.
+ * @param tile_size The size of the square tiles, 0 for no tiles.
+ * @param metrics Receives the metrics of the whole image.
+ * @param tile_metrics A pointer to a buffer that will hold the metrics of the tiles, row by row (nullptr if tile_size is 0).
+ * @param tiles_x Receives the number of tiles per row.
+ * @param tiles_y Receives the number of tile rows.
+ * @return 0 if the metrics were computed, or 1 if memory allocation failed or the input image is invalid.
+ */
+int compute_focus_metrics(const ubyte *image, size_t width, size_t height,
+                          ubyte threshold,
+                          size_t tile_size,
+                          focus_metrics *metrics,
+                          focus_metrics **tile_metrics, size_t *tiles_x, size_t *tiles_y) {
+    // Check if the input image is valid
+    if (image == nullptr) {
+        std::cout << "Invalid input image\n";
+        return 1;
+    }
+
+    // a single tile covers the whole image when no tiles are requested
+    size_t size = tile_size > 0 ? tile_size : (width > height ? width : height);
+    size_t columns = size > 0 ? (width + size - 1) / size : 0, rows = size > 0 ? (height + size - 1) / size : 0;
+    size_t tiles = columns * rows;
+
+    // no pixel has all of its neighbors in images thinner than 3 pixels
+    *metrics = {0, 0, 0};
+    *tile_metrics = nullptr;
+    *tiles_x = *tiles_y = 0;
+    if (width < 3 || height < 3) return 0;
+
+    std::vector<std::vector<focus_sums>> partial(worker_count(), std::vector<focus_sums>(tiles, focus_sums{}));
+
+    parallel_for(1, height - 1, [&](size_t row_begin, size_t row_end, size_t worker) {
+        std::vector<int16> gx(width), gy(width);
+        std::vector<unsigned short> magnitudes(width);
+        std::vector<focus_sums> &sums = partial[worker];
+
+        for (size_t i = row_begin; i < row_end; i++) {
+            const ubyte *above = image + (i - 1) * width, *row = above + width, *below = row + width;
+            sobel_gradient_row(above, row, below, gx.data(), gy.data(), width);
+            sobel_magnitude_row(gx.data(), gy.data(), magnitudes.data(), width);
+
+            focus_sums *tile_row = sums.data() + (i / size) * columns;
+            for (size_t tile_begin = 0; tile_begin < width; tile_begin += size) {
+                size_t begin = tile_begin > 0 ? tile_begin : 1;
+                size_t end = tile_begin + size < width - 1 ? tile_begin + size : width - 1;
+                if (begin >= end) continue;
+
+                unsigned long long gradient = 0, laplacian_squared = 0, edges = 0;
+                long long laplacian = 0;
+                for (size_t j = begin; j < end; j++) {
+                    int x = gx[j], y = gy[j];
+                    int value = above[j] + below[j] + row[j - 1] + row[j + 1] - 4 * row[j];
+                    gradient += (unsigned int) (x * x + y * y);
+                    laplacian += value;
+                    laplacian_squared += (unsigned int) (value * value);
+                    edges += magnitudes[j] > threshold;
+                }
+
+                focus_sums &tile = tile_row[tile_begin / size];
+                tile.add({gradient, laplacian, laplacian_squared, edges, end - begin});
+            }
+        }
+    }, MIN_BAND_ROWS);
+
+    // add the bands, then the tiles
+    std::vector<focus_sums> &total = partial[0];
+    for (size_t w = 1; w < partial.size(); w++)
+        for (size_t t = 0; t < tiles; t++) total[t].add(partial[w][t]);
+
+    focus_sums image_sums{};
+    for (size_t t = 0; t < tiles; t++) image_sums.add(total[t]);
+    *metrics = image_sums.metrics();
+
+    if (tile_size > 0) {
+        *tile_metrics = (focus_metrics *) malloc(tiles * sizeof(focus_metrics));
+
+        // Check if the memory was allocated
+        if (*tile_metrics == nullptr) {
+            std::cout << "Failed to allocate memory for the tile metrics!\n";
+            return 1;
+        }
+
+        for (size_t t = 0; t < tiles; t++) (*tile_metrics)[t] = total[t].metrics();
+        *tiles_x = columns;
+        *tiles_y = rows;
+    }
+
+    return 0;
+}
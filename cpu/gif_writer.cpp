@@ -0,0 +1,190 @@
+#include <iostream>
+#include <vector>
+#include <cstdio>
+#include "../filters/gif_writer.h"
+
+
+// the codes of a gray scale GIF: 256 literals, then the clear and end of information codes
+#define LITERAL_BITS 8
+#define CLEAR_CODE (1 << LITERAL_BITS)
+#define END_CODE (CLEAR_CODE + 1)
+#define MAX_CODE 4095
+
+// size of the open addressing table of the LZW dictionary (a power of two above MAX_CODE)
+#define DICTIONARY_SIZE 8192
+
+
+/**
+ * Packs the variable width LZW codes LSB first into the data sub-blocks of a GIF image.
+ */
+struct code_packer {
+    FILE *file;
+    unsigned int bits;
+    int bit_count;
+    ubyte block[255];
+    size_t block_size;
+
+    void flush_block() {
+        if (block_size == 0) return;
+        fputc((int) block_size, file);
+        fwrite(block, 1, block_size, file);
+        block_size = 0;
+    }
+
+    void write(unsigned int code, int code_size) {
+        bits |= code << bit_count;
+        bit_count += code_size;
+        while (bit_count >= 8) {
+            block[block_size++] = (ubyte) (bits & 0xFF);
+            bits >>= 8;
+            bit_count -= 8;
+            if (block_size == sizeof(block)) flush_block();
+        }
+    }
+
+    void finish() {
+        if (bit_count > 0) block[block_size++] = (ubyte) (bits & 0xFF);
+        bits = 0, bit_count = 0;
+        flush_block();
+        fputc(0, file);
+    }
+};
+
+static void write_short(FILE *file, size_t value) {
+    fputc((int) (value & 0xFF), file);
+    fputc((int) ((value >> 8) & 0xFF), file);
+}
+
+/**
+ * Compresses the pixels of a frame with GIF LZW.
+ *
+ * The dictionary maps (prefix code, next pixel) to a code with an open addressing hash table, so
+ * every pixel costs a lookup or an insertion. The dictionary is cleared when it reaches 4096 codes.
+ */
+static void write_lzw(FILE *file, const ubyte *pixels, size_t size) {
+    std::vector<unsigned int> keys(DICTIONARY_SIZE);
+    std::vector<short> codes(DICTIONARY_SIZE, -1);
+
+    code_packer packer{file, 0, 0, {}, 0};
+    fputc(LITERAL_BITS, file);
+
+    int code_size = LITERAL_BITS + 1, next_code = END_CODE + 1;
+    packer.write(CLEAR_CODE, code_size);
+
+    unsigned int prefix = pixels[0];
+    for (size_t i = 1; i < size; i++) {
+        unsigned int key = prefix << 8 | pixels[i];
+        size_t slot = (key * 2654435761u) & (DICTIONARY_SIZE - 1);
+        while (codes[slot] >= 0 && keys[slot] != key) slot = (slot + 1) & (DICTIONARY_SIZE - 1);
+
+        if (codes[slot] >= 0) {
+            prefix = (unsigned int) codes[slot];
+            continue;
+        }
+
+        packer.write(prefix, code_size);
+        if (next_code > MAX_CODE) {
+            packer.write(CLEAR_CODE, code_size);
+            std::fill(codes.begin(), codes.end(), -1);
+            code_size = LITERAL_BITS + 1, next_code = END_CODE + 1;
+        } else {
+            keys[slot] = key;
+            codes[slot] = (short) next_code;
+            if (next_code >= 1 << code_size) code_size++;
+            next_code++;
+        }
+        prefix = pixels[i];
+    }
+
+    // the decoder adds the last code it expects after the final prefix, which may widen the codes
+    packer.write(prefix, code_size);
+    if (next_code == 1 << code_size && code_size < 12) code_size++;
+    packer.write(END_CODE, code_size);
+    packer.finish();
+}
+
+
+/**
+ * Writes gray scale frames as a looping animated GIF.
+ *
+ * The frames share a global palette of the 256 gray levels, so they are stored losslessly without
+ * quantization. Every frame replaces the whole previous one.
+ *
+ * @param path The path of the GIF file.
+ * @param frames The frames (single channel, width x height pixels each).
+ * @param count The number of frames.
+ * @param width The width of the frames in pixels.
+ * @param height The height of the frames in pixels.
+ * @param delays The display time of every frame in milliseconds, or nullptr for 100ms.
+ * @return 0 if the file was written, or 1 if the input is invalid or the file could not be written.
+ */
+int write_gray_gif(const char *path, const ubyte *const *frames, size_t count, size_t width, size_t height,
+                   const int *delays) {
+    // Check if the frames are valid
+    if (frames == nullptr || count == 0 || width == 0 || height == 0 || width > 0xFFFF || height > 0xFFFF) {
+        std::cout << "Invalid frames or size\n";
+        return 1;
+    }
+
+    FILE *file = fopen(path, "wb");
+    if (file == nullptr) {
+        std::cout << "Failed to open " << path << " for writing!\n";
+        return 1;
+    }
+
+    // header, logical screen with a 256 entry global palette, and the gray palette
+    fwrite("GIF89a", 1, 6, file);
+    write_short(file, width);
+    write_short(file, height);
+    fputc(0xF7, file);
+    fputc(0, file);
+    fputc(0, file);
+    for (int level = 0; level < 256; level++) {
+        fputc(level, file);
+        fputc(level, file);
+        fputc(level, file);
+    }
+
+    // loop forever
+    fputc(0x21, file);
+    fputc(0xFF, file);
+    fputc(11, file);
+    fwrite("NETSCAPE2.0", 1, 11, file);
+    fputc(3, file);
+    fputc(1, file);
+    write_short(file, 0);
+    fputc(0, file);
+
+    for (size_t f = 0; f < count; f++) {
+        // graphic control extension: no disposal, delay in hundredths of a second
+        int delay = delays != nullptr ? delays[f] : 100;
+        fputc(0x21, file);
+        fputc(0xF9, file);
+        fputc(4, file);
+        fputc(0x04, file);
+        write_short(file, (size_t) (delay > 0 ? (delay + 5) / 10 : 0));
+        fputc(0, file);
+        fputc(0, file);
+
+        // image descriptor covering the whole screen, without a local palette
+        fputc(0x2C, file);
+        write_short(file, 0);
+        write_short(file, 0);
+        write_short(file, width);
+        write_short(file, height);
+        fputc(0, file);
+
+        write_lzw(file, frames[f], width * height);
+    }
+
+    fputc(0x3B, file);
+
+    // the write errors are sticky, so they are checked once at the end
+    bool written = ferror(file) == 0;
+    if (fclose(file) != 0 || !written) {
+        std::cout << "Failed to write " << path << "!\n";
+        return 1;
+    }
+
+    return 0;
+}
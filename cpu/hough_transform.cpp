@@ -0,0 +1,199 @@
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include "../filters/hough_transform.h"
+#include "../filters/parallel.h"
+
+
+// minimum number of rows per band, smaller bands are not worth a thread
+#define MIN_BAND_ROWS 16
+
+// minimum number of edge points per voting band
+#define MIN_BAND_POINTS 4096
+
+
+/**
+ * An edge pixel and the range of theta bins it votes for.
+ */
+struct edge_point {
+    int x, y;
+    int first_bin;   // first theta bin (may be negative, wraps around)
+    int bins;        // number of theta bins
+};
+
+
+/**
+ * Detects straight lines in an edge map with the Hough transform.
+ *
+ * 1. The edge pixels above the threshold are collected into a sparse list, band by band in parallel.
+ *    The outermost rows and columns are skipped: the zero padding of the Sobel filter turns them into
+ *    edges in almost every image, and they would outvote every real line.
+ * 2. Every thread votes for its share of the list into its own accumulator, using precomputed
+ *    sin/cos tables. If the gradients are given, a pixel only votes for the thetas within
+ *    angle_window of its gradient orientation (the normal of the line it lies on), which cuts
+ *    the voting cost by roughly pi / (2 * angle_window).
+ * 3. The accumulators are summed in parallel, one theta row per task.
+ * 4. The local maxima with at least min_votes votes are extracted and sorted by their votes.
+ *
+ * @param edges The edge map (e.g. the output of detect_edges).
+ * @param width The width of the image in pixels.
+ * @param height The height of the image in pixels.
+ * @param threshold Pixels above this value are edges.
+ * @param gx The x dir gradient (e.g. from compute_gradients), or nullptr to vote for every theta.
+ * @param gy The y dir gradient, or nullptr to vote for every theta.
+ * @param angle_window Half width of the voting window around the gradient orientation, in radians.
+ * @param theta_bins The number of theta bins over [0, pi).
+ * @param min_votes The minimum number of votes of a line.
+ * @param max_lines The maximum number of lines to return.
+ * @param lines A pointer to a buffer that will hold the detected lines, strongest first.
+ * @param count Receives the number of detected lines.
+ * @return 0 if the detection succeeded, or 1 if memory allocation failed or the input is invalid.
+ */
+int detect_lines(const ubyte *edges, size_t width, size_t height,
+                 ubyte threshold,
+                 const int16 *gx, const int16 *gy,
+                 double angle_window,
+                 size_t theta_bins,
+                 unsigned int min_votes,
+                 size_t max_lines,
+                 hough_line **lines, size_t *count) {
+    // Check if the input edges are valid
+    if (edges == nullptr || theta_bins == 0) {
+        std::cout << "Invalid input edges or number of theta bins\n";
+        return 1;
+    }
+
+    bool oriented = gx != nullptr && gy != nullptr && angle_window > 0 && angle_window < M_PI / 2;
+    int window_bins = oriented ? (int) ceil(angle_window / (M_PI / (double) theta_bins)) : 0;
+
+    auto max_rho = (long) ceil(hypot((double) width, (double) height));
+    size_t rho_bins = 2 * max_rho + 1;
+    size_t accumulator_size = theta_bins * rho_bins;
+
+    // sin/cos tables
+    std::vector<float> cos_table(theta_bins), sin_table(theta_bins);
+    for (size_t t = 0; t < theta_bins; t++) {
+        double theta = M_PI * (double) t / (double) theta_bins;
+        cos_table[t] = (float) cos(theta);
+        sin_table[t] = (float) sin(theta);
+    }
+
+    // 1. sparse edge list
+    std::vector<std::vector<edge_point>> band_points(worker_count());
+    parallel_for(0, height, [&](size_t row_begin, size_t row_end, size_t worker) {
+        std::vector<edge_point> &points = band_points[worker];
+        for (size_t i = row_begin; i < row_end; i++) {
+            if (i == 0 || i + 1 >= height) continue;
+            for (size_t j = 1; j + 1 < width; j++) {
+                size_t index = i * width + j;
+                if (edges[index] <= threshold) continue;
+
+                edge_point point{(int) j, (int) i, 0, (int) theta_bins};
+                if (oriented && (gx[index] != 0 || gy[index] != 0)) {
+                    double theta = atan2((double) gy[index], (double) gx[index]);
+                    if (theta < 0) theta += M_PI;
+                    auto center = (int) lround(theta / M_PI * (double) theta_bins);
+                    point.first_bin = center - window_bins;
+                    point.bins = 2 * window_bins + 1 < (int) theta_bins ? 2 * window_bins + 1 : (int) theta_bins;
+                }
+                points.push_back(point);
+            }
+        }
+    }, MIN_BAND_ROWS);
+
+    std::vector<edge_point> points;
+    for (auto &band: band_points) points.insert(points.end(), band.begin(), band.end());
+    band_points.clear();
+
+    // 2. voting into per-thread accumulators
+    std::vector<unsigned int *> accumulators(worker_count(), nullptr);
+    for (auto &accumulator: accumulators) {
+        accumulator = (unsigned int *) calloc(accumulator_size, sizeof(unsigned int));
+        if (accumulator == nullptr) {
+            std::cout << "Failed to allocate memory for the Hough accumulator!\n";
+            for (auto allocated: accumulators) free(allocated);
+            return 1;
+        }
+    }
+
+    parallel_for(0, points.size(), [&](size_t begin, size_t end, size_t worker) {
+        unsigned int *accumulator = accumulators[worker];
+        for (size_t p = begin; p < end; p++) {
+            const edge_point &point = points[p];
+            auto x = (float) point.x, y = (float) point.y;
+
+            for (int k = 0; k < point.bins; k++) {
+                int t = point.first_bin + k;
+                t = t < 0 ? t + (int) theta_bins : (t >= (int) theta_bins ? t - (int) theta_bins : t);
+
+                auto rho = (long) floorf(x * cos_table[t] + y * sin_table[t] + 0.5f);
+                accumulator[t * rho_bins + rho + max_rho]++;
+            }
+        }
+    }, MIN_BAND_POINTS);
+
+    // 3. reduction into the first accumulator
+    unsigned int *votes = accumulators[0];
+    parallel_for(0, theta_bins, [&](size_t theta_begin, size_t theta_end, size_t) {
+        for (size_t w = 1; w < accumulators.size(); w++) {
+            const unsigned int *other = accumulators[w];
+            for (size_t index = theta_begin * rho_bins; index < theta_end * rho_bins; index++)
+                votes[index] += other[index];
+        }
+    });
+    for (size_t w = 1; w < accumulators.size(); w++) free(accumulators[w]);
+
+    // 4. peaks, local maxima of the 3x3 neighborhood (ties go to the first cell)
+    std::vector<std::vector<hough_line>> band_peaks(worker_count());
+    parallel_for(0, theta_bins, [&](size_t theta_begin, size_t theta_end, size_t worker) {
+        for (size_t t = theta_begin; t < theta_end; t++) {
+            for (size_t r = 0; r < rho_bins; r++) {
+                unsigned int v = votes[t * rho_bins + r];
+                if (v < min_votes || v == 0) continue;
+
+                bool peak = true;
+                for (long dt = -1; dt <= 1 && peak; dt++) {
+                    long nt = (long) t + dt;
+                    if (nt < 0 || nt >= (long) theta_bins) continue;
+                    for (long dr = -1; dr <= 1; dr++) {
+                        long nr = (long) r + dr;
+                        if ((dt == 0 && dr == 0) || nr < 0 || nr >= (long) rho_bins) continue;
+
+                        unsigned int neighbor = votes[nt * rho_bins + nr];
+                        bool before = dt < 0 || (dt == 0 && dr < 0);
+                        if (neighbor > v || (before && neighbor == v)) {
+                            peak = false;
+                            break;
+                        }
+                    }
+                }
+
+                if (peak) {
+                    band_peaks[worker].push_back({(double) ((long) r - max_rho),
+                                                  M_PI * (double) t / (double) theta_bins,
+                                                  v});
+                }
+            }
+        }
+    });
+    free(votes);
+
+    std::vector<hough_line> peaks;
+    for (auto &band: band_peaks) peaks.insert(peaks.end(), band.begin(), band.end());
+    std::stable_sort(peaks.begin(), peaks.end(), [](const hough_line &a, const hough_line &b) {
+        if (a.votes != b.votes) return a.votes > b.votes;
+        if (a.theta != b.theta) return a.theta < b.theta;
+        return a.rho < b.rho;
+    });
+    if (peaks.size() > max_lines) peaks.resize(max_lines);
+
+    *count = peaks.size();
+    *lines = (hough_line *) malloc((peaks.empty() ? 1 : peaks.size()) * sizeof(hough_line));
+    if (*lines == nullptr) {
+        std::cout << "Failed to allocate memory for the lines!\n";
+        return 1;
+    }
+    std::copy(peaks.begin(), peaks.end(), *lines);
+
+    return 0;
+}
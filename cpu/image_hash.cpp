@@ -0,0 +1,280 @@
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include "../filters/image_hash.h"
+#include "../filters/parallel.h"
+
+
+// the hashes are computed on an 8 x 8 grid (9 x 8 for the difference hash)
+#define HASH_GRID_SIZE 8
+
+
+/**
+ * The coefficients of an area averaging resize in one dimension: input pixel i adds
+ * weights[k] * value to the output pixel bins[k] for k in [offsets[i], offsets[i + 1]).
+ */
+struct area_spans {
+    std::vector<size_t> offsets;
+    std::vector<size_t> bins;
+    std::vector<float> weights;   // the weights of every output pixel sum to 1
+};
+
+/**
+ * Computes the area averaging coefficients that resize a line of size pixels to resized_size pixels.
+ * Output pixel u covers the input range [u * size / resized_size, (u + 1) * size / resized_size).
+ */
+static area_spans make_spans(size_t size, size_t resized_size) {
+    area_spans spans{};
+    spans.offsets.reserve(size + 1);
+    spans.offsets.push_back(0);
+
+    double scale = (double) size / (double) resized_size;
+    for (size_t i = 0; i < size; i++) {
+        auto first = (size_t) ((double) i / scale);
+        for (size_t u = first; u < resized_size && (double) u * scale < (double) (i + 1); u++) {
+            double begin = std::max((double) i, (double) u * scale);
+            double end = std::min((double) (i + 1), (double) (u + 1) * scale);
+            if (end <= begin) continue;
+            spans.bins.push_back(u);
+            spans.weights.push_back((float) ((end - begin) / scale));
+        }
+        spans.offsets.push_back(spans.bins.size());
+    }
+
+    return spans;
+}
+
+/**
+ * The cosines of the 8 lowest frequencies of a HASH_THUMBNAIL_SIZE point DCT-II.
+ */
+struct dct_table {
+    float values[HASH_GRID_SIZE][HASH_THUMBNAIL_SIZE];
+};
+
+static dct_table make_dct_table() {
+    dct_table table{};
+    for (size_t k = 0; k < HASH_GRID_SIZE; k++)
+        for (size_t n = 0; n < HASH_THUMBNAIL_SIZE; n++)
+            table.values[k][n] = (float) cos(M_PI * (double) ((2 * n + 1) * k) / (double) (2 * HASH_THUMBNAIL_SIZE));
+    return table;
+}
+
+/**
+ * Resizes a single channel float image with the given spans.
+ */
+static void resize_spans(const float *input, size_t width, size_t height,
+                         const area_spans &horizontal, const area_spans &vertical,
+                         float *output, size_t resized_width, size_t resized_height) {
+    std::fill(output, output + resized_width * resized_height, 0.0f);
+    std::vector<float> row(resized_width);
+
+    for (size_t i = 0; i < height; i++) {
+        std::fill(row.begin(), row.end(), 0.0f);
+        for (size_t j = 0; j < width; j++)
+            for (size_t k = horizontal.offsets[j]; k < horizontal.offsets[j + 1]; k++)
+                row[horizontal.bins[k]] += horizontal.weights[k] * input[i * width + j];
+
+        for (size_t k = vertical.offsets[i]; k < vertical.offsets[i + 1]; k++) {
+            float *out = output + vertical.bins[k] * resized_width;
+            for (size_t u = 0; u < resized_width; u++) out[u] += vertical.weights[k] * row[u];
+        }
+    }
+}
+
+
+/**
+ * Converts an image to gray scale and shrinks it to a HASH_THUMBNAIL_SIZE x HASH_THUMBNAIL_SIZE
+ * thumbnail with area averaging, in a single pass.
+ *
+ * Every row is converted with the weights of convert_to_gray_scale and immediately accumulated into
+ * the thumbnail, so the full size gray scale image is never stored. The thumbnail rows are split into
+ * bands that are processed in parallel, and every thumbnail row adds its input rows in order, so the
+ * result does not depend on the number of threads (the input rows shared by two thumbnail rows are
+ * converted twice). Hashes computed on different machines can therefore be compared bit for bit.
+ *
+ * @param image A pointer to the input image data.
+ * @param width The width of the image in pixels.
+ * @param height The height of the image in pixels.
+ * @param channels The number of color channels per pixel (1 for gray scale, 3 for RGB).
+ * @param thumbnail Output buffer for the thumbnail (HASH_THUMBNAIL_SIZE * HASH_THUMBNAIL_SIZE elements).
+ * @return 0 if the thumbnail was computed, or 1 if the input image is invalid.
+ */
+int gray_scale_thumbnail(const ubyte *image, size_t width, size_t height, size_t channels,
+                         float *thumbnail) {
+    // Check if the input image and channels are valid
+    if (image == nullptr || width == 0 || height == 0 || (channels != 1 && channels != 3)) {
+        std::cout << "Invalid input image or number of channels. Expected a 1 or 3-channel image.\n";
+        return 1;
+    }
+
+    const size_t size = HASH_THUMBNAIL_SIZE;
+    area_spans horizontal = make_spans(width, size);
+    area_spans vertical = make_spans(height, size);
+
+    // the input rows [first_row[v], end_row[v]) of every thumbnail row
+    std::vector<size_t> first_row(size, height), end_row(size, 0);
+    for (size_t i = 0; i < height; i++) {
+        for (size_t k = vertical.offsets[i]; k < vertical.offsets[i + 1]; k++) {
+            size_t bin = vertical.bins[k];
+            first_row[bin] = i < first_row[bin] ? i : first_row[bin];
+            end_row[bin] = i + 1;
+        }
+    }
+
+    std::fill(thumbnail, thumbnail + size * size, 0.0f);
+
+    parallel_for(0, size, [&](size_t bin_begin, size_t bin_end, size_t) {
+        std::vector<float> gray(width), row(size);
+
+        for (size_t v = bin_begin; v < bin_end; v++) {
+            float *out = thumbnail + v * size;
+
+            for (size_t i = first_row[v]; i < end_row[v]; i++) {
+                const ubyte *in = image + i * width * channels;
+                if (channels == 3) {
+                    for (size_t j = 0; j < width; j++)
+                        gray[j] = 0.21f * (float) in[3 * j] + 0.72f * (float) in[3 * j + 1] + 0.07f * (float) in[3 * j + 2];
+                } else {
+                    for (size_t j = 0; j < width; j++) gray[j] = (float) in[j];
+                }
+
+                std::fill(row.begin(), row.end(), 0.0f);
+                for (size_t j = 0; j < width; j++)
+                    for (size_t k = horizontal.offsets[j]; k < horizontal.offsets[j + 1]; k++)
+                        row[horizontal.bins[k]] += horizontal.weights[k] * gray[j];
+
+                for (size_t k = vertical.offsets[i]; k < vertical.offsets[i + 1]; k++) {
+                    if (vertical.bins[k] != v) continue;
+                    for (size_t u = 0; u < size; u++) out[u] += vertical.weights[k] * row[u];
+                }
+            }
+        }
+    });
+
+    return 0;
+}
+
+/**
+ * Computes a 64 bit hash of a thumbnail made by gray_scale_thumbnail.
+ *
+ * - HASH_AVERAGE: the thumbnail is shrunk to 8 x 8, a bit is set for every pixel above the mean.
+ * - HASH_DIFFERENCE: the thumbnail is shrunk to 9 x 8, a bit is set for every pixel brighter than
+ *   its left neighbor.
+ * - HASH_PERCEPTUAL: the 8 x 8 lowest frequencies of the 32 x 32 DCT-II of the thumbnail, a bit is
+ *   set for every coefficient above their median. Only the 8 needed frequencies of every pass are
+ *   computed, from a table of cosines.
+ *
+ * The bits are ordered row by row, the first one is the most significant.
+ *
+ * @param thumbnail The thumbnail (HASH_THUMBNAIL_SIZE * HASH_THUMBNAIL_SIZE elements).
+ * @param method The hash to compute.
+ * @return The hash.
+ */
+hash64 thumbnail_hash(const float *thumbnail, hash_method method) {
+    const size_t size = HASH_THUMBNAIL_SIZE, grid = HASH_GRID_SIZE;
+    float values[(HASH_GRID_SIZE + 1) * HASH_GRID_SIZE];
+    hash64 hash = 0;
+
+    if (method == HASH_DIFFERENCE) {
+        resize_spans(thumbnail, size, size, make_spans(size, grid + 1), make_spans(size, grid),
+                     values, grid + 1, grid);
+        for (size_t i = 0; i < grid; i++)
+            for (size_t j = 0; j < grid; j++)
+                hash = (hash << 1) | (values[i * (grid + 1) + j + 1] > values[i * (grid + 1) + j]);
+        return hash;
+    }
+
+    if (method == HASH_AVERAGE) {
+        resize_spans(thumbnail, size, size, make_spans(size, grid), make_spans(size, grid), values, grid, grid);
+    } else {
+        static const dct_table cosines = make_dct_table();
+
+        // DCT of the columns, then of the rows, keeping the 8 lowest frequencies
+        float columns[HASH_GRID_SIZE][HASH_THUMBNAIL_SIZE] = {};
+        for (size_t k = 0; k < grid; k++)
+            for (size_t n = 0; n < size; n++)
+                for (size_t j = 0; j < size; j++) columns[k][j] += cosines.values[k][n] * thumbnail[n * size + j];
+
+        for (size_t k = 0; k < grid; k++)
+            for (size_t l = 0; l < grid; l++) {
+                float sum = 0;
+                for (size_t j = 0; j < size; j++) sum += cosines.values[l][j] * columns[k][j];
+                values[k * grid + l] = sum;
+            }
+    }
+
+    float cutoff;
+    if (method == HASH_AVERAGE) {
+        cutoff = 0;
+        for (size_t p = 0; p < grid * grid; p++) cutoff += values[p];
+        cutoff /= (float) (grid * grid);
+    } else {
+        float sorted[HASH_GRID_SIZE * HASH_GRID_SIZE];
+        std::copy(values, values + grid * grid, sorted);
+        std::sort(sorted, sorted + grid * grid);
+        cutoff = (sorted[grid * grid / 2 - 1] + sorted[grid * grid / 2]) / 2;
+    }
+
+    for (size_t p = 0; p < grid * grid; p++) hash = (hash << 1) | (values[p] > cutoff);
+    return hash;
+}
+
+/**
+ * Computes a 64 bit perceptual hash of an image.
+ *
+ * @param image A pointer to the input image data.
+ * @param width The width of the image in pixels.
+ * @param height The height of the image in pixels.
+ * @param channels The number of color channels per pixel (1 for gray scale, 3 for RGB).
+ * @param method HASH_AVERAGE, HASH_DIFFERENCE or HASH_PERCEPTUAL.
+ * @param hash Receives the hash.
+ * @return 0 if the hash was computed, or 1 if the input image is invalid.
+ */
+int compute_image_hash(const ubyte *image, size_t width, size_t height, size_t channels,
+                       hash_method method,
+                       hash64 *hash) {
+    float thumbnail[HASH_THUMBNAIL_SIZE * HASH_THUMBNAIL_SIZE];
+    if (gray_scale_thumbnail(image, width, height, channels, thumbnail) != 0) return 1;
+
+    *hash = thumbnail_hash(thumbnail, method);
+    return 0;
+}
+
+/**
+ * Finds the hashes within a Hamming distance of a query hash.
+ *
+ * Every comparison is an xor and a popcount, so a linear scan goes through millions of hashes per
+ * millisecond and needs no index.
+ *
+ * @param hashes The hashes to search.
+ * @param count The number of hashes.
+ * @param query The hash to look for.
+ * @param max_distance The largest number of differing bits of a match.
+ * @param matches A pointer to a buffer that will hold the indices of the matches, in order.
+ * @param match_count Receives the number of matches.
+ * @return 0 if the search succeeded, or 1 if memory allocation failed or the input is invalid.
+ */
+int find_similar_hashes(const hash64 *hashes, size_t count, hash64 query,
+                        unsigned int max_distance,
+                        size_t **matches, size_t *match_count) {
+    // Check if the input hashes are valid
+    if (hashes == nullptr && count > 0) {
+        std::cout << "Invalid input hashes\n";
+        return 1;
+    }
+
+    *matches = (size_t *) malloc((count > 0 ? count : 1) * sizeof(size_t));
+
+    // Check if the memory was allocated
+    if (*matches == nullptr) {
+        std::cout << "Failed to allocate memory for the matches!\n";
+        return 1;
+    }
+
+    *match_count = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (hash_distance(hashes[i], query) <= max_distance) (*matches)[(*match_count)++] = i;
+    }
+
+    return 0;
+}
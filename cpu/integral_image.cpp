@@ -0,0 +1,212 @@
+#include <iostream>
+#include <vector>
+#include "../filters/integral_image.h"
+#include "../filters/sobel_filter.h"
+#include "../filters/parallel.h"
+
+
+// dynamic range of the standard deviation in Sauvola's formula (for 8-bit images)
+#define SAUVOLA_RANGE 128.0
+
+// number of columns every thread accumulates at once in the vertical prefix sum
+#define COLUMN_STRIP 256
+
+// minimum number of rows per band, smaller bands are not worth a thread
+#define MIN_BAND_ROWS 16
+
+
+/**
+ * Builds the integral image (summed-area table) of an image and, optionally, of its squares.
+ *
+ * The tables have (width + 1) * (height + 1) elements, with a zero first row and column, so that
+ * element (i, j) is the sum of the pixels in the rectangle [0, i) x [0, j). The sums are 64-bit,
+ * so they cannot overflow for any image that fits in memory.
+ *
+ * The prefix sums are computed in two parallel passes: the rows are summed independently in bands,
+ * then the columns are accumulated downwards in strips, where every row step is a vectorizable
+ * addition of two rows.
+ *
+ * @param image A pointer to the input image data (single channel).
+ * @param sums A pointer to a buffer that will hold the integral image.
+ * @param squared_sums If not nullptr, a pointer to a buffer that will hold the integral image of the squares.
+ * @param width The width of the image in pixels.
+ * @param height The height of the image in pixels.
+ * @return 0 if the integral image was built, or 1 if memory allocation failed or the input image is invalid.
+ */
+int build_integral_image(const ubyte *image, unsigned long long **sums, unsigned long long **squared_sums,
+                         size_t width, size_t height) {
+    // Check if the input image is valid
+    if (image == nullptr) {
+        std::cout << "Invalid input image\n";
+        return 1;
+    }
+
+    size_t stride = width + 1;
+    size_t size = stride * (height + 1);
+
+    *sums = (unsigned long long *) malloc(size * sizeof(unsigned long long));
+    if (squared_sums != nullptr) *squared_sums = (unsigned long long *) malloc(size * sizeof(unsigned long long));
+
+    // Check if the memory was allocated
+    if (*sums == nullptr || (squared_sums != nullptr && *squared_sums == nullptr)) {
+        std::cout << "Failed to allocate memory for the integral image!\n";
+        free(*sums);
+        if (squared_sums != nullptr) free(*squared_sums);
+        return 1;
+    }
+
+    unsigned long long *sum = *sums;
+    unsigned long long *squared = squared_sums != nullptr ? *squared_sums : nullptr;
+
+    // first row is zero
+    for (size_t j = 0; j < stride; j++) {
+        sum[j] = 0;
+        if (squared != nullptr) squared[j] = 0;
+    }
+
+    // horizontal prefix sums
+    parallel_for(0, height, [&](size_t row_begin, size_t row_end, size_t) {
+        for (size_t i = row_begin; i < row_end; i++) {
+            const ubyte *in = image + i * width;
+            unsigned long long *out = sum + (i + 1) * stride;
+            unsigned long long running = 0;
+
+            out[0] = 0;
+            for (size_t j = 0; j < width; j++) {
+                running += in[j];
+                out[j + 1] = running;
+            }
+
+            if (squared != nullptr) {
+                unsigned long long *out_squared = squared + (i + 1) * stride;
+                unsigned long long running_squared = 0;
+
+                out_squared[0] = 0;
+                for (size_t j = 0; j < width; j++) {
+                    running_squared += (unsigned long long) in[j] * in[j];
+                    out_squared[j + 1] = running_squared;
+                }
+            }
+        }
+    }, MIN_BAND_ROWS);
+
+    // vertical prefix sums
+    size_t strips = (stride + COLUMN_STRIP - 1) / COLUMN_STRIP;
+    parallel_for(0, strips, [&](size_t strip_begin, size_t strip_end, size_t) {
+        size_t column_begin = strip_begin * COLUMN_STRIP;
+        size_t column_end = strip_end * COLUMN_STRIP < stride ? strip_end * COLUMN_STRIP : stride;
+
+        for (size_t i = 1; i <= height; i++) {
+            unsigned long long *previous = sum + (i - 1) * stride, *current = sum + i * stride;
+            for (size_t j = column_begin; j < column_end; j++) current[j] += previous[j];
+
+            if (squared != nullptr) {
+                previous = squared + (i - 1) * stride, current = squared + i * stride;
+                for (size_t j = column_begin; j < column_end; j++) current[j] += previous[j];
+            }
+        }
+    });
+
+    return 0;
+}
+
+/**
+ * Thresholds an edge map against a threshold computed from the neighborhood of every pixel.
+ *
+ * The local mean and standard deviation over a window x window neighborhood are read in O(1)
+ * from the integral images, so the cost does not depend on the window size. The neighborhood is
+ * cut at the image border. The local threshold is:
+ * - ADAPTIVE_MEAN: mean * (1 + k)
+ * - ADAPTIVE_SAUVOLA: mean * (1 + k * (deviation / 128 - 1))
+ *
+ * Every pixel is then strengthened or weakened like strength_edge does with a global threshold.
+ *
+ * @param edges The edge map (e.g. the output of detect_edges).
+ * @param thresholded_image A pointer to a buffer that will hold the resulting image data.
+ * @param width The width of the image in pixels.
+ * @param height The height of the image in pixels.
+ * @param window The size of the (square) neighborhood in pixels.
+ * @param mode ADAPTIVE_MEAN or ADAPTIVE_SAUVOLA.
+ * @param k The sensitivity of the local threshold.
+ * @param strength_ratio The ratio used to strengthen or weaken the edges.
+ * @return 0 if the thresholding succeeded, or 1 if memory allocation failed or the input is invalid.
+ */
+int adaptive_threshold(const ubyte *edges, ubyte **thresholded_image, size_t width, size_t height,
+                       size_t window,
+                       adaptive_mode mode,
+                       double k,
+                       double strength_ratio) {
+    // Check if the input edges and window are valid
+    if (edges == nullptr || window == 0) {
+        std::cout << "Invalid input edges or window size\n";
+        return 1;
+    }
+
+    unsigned long long *sums, *squared_sums;
+    if (build_integral_image(edges, &sums, mode == ADAPTIVE_SAUVOLA ? &squared_sums : nullptr,
+                             width, height) != 0)
+        return 1;
+
+    *thresholded_image = (ubyte *) malloc(width * height * sizeof(ubyte));
+
+    // Check if the memory was allocated
+    if (*thresholded_image == nullptr) {
+        std::cout << "Failed to allocate memory for the thresholded image!\n";
+        free(sums);
+        if (mode == ADAPTIVE_SAUVOLA) free(squared_sums);
+        return 1;
+    }
+
+    // strength_edge for every (threshold, value) pair, indexed by threshold * 256 + value
+    std::vector<ubyte> tables((UCHAR_MAX + 1) * (UCHAR_MAX + 1));
+    ubyte table[SOBEL_MAGNITUDE_LEVELS];
+    for (size_t threshold = 0; threshold <= UCHAR_MAX; threshold++) {
+        build_edge_strength_table((ubyte) threshold, strength_ratio, table);
+        std::copy(table, table + UCHAR_MAX + 1, tables.begin() + (long) (threshold * (UCHAR_MAX + 1)));
+    }
+
+    size_t stride = width + 1;
+    size_t before = window / 2, after = window - before;
+
+    parallel_for(0, height, [&](size_t row_begin, size_t row_end, size_t) {
+        for (size_t i = row_begin; i < row_end; i++) {
+            size_t top = i > before ? i - before : 0;
+            size_t bottom = i + after < height ? i + after : height;
+
+            for (size_t j = 0; j < width; j++) {
+                size_t left = j > before ? j - before : 0;
+                size_t right = j + after < width ? j + after : width;
+
+                double count = (double) ((bottom - top) * (right - left));
+                double sum = (double) (sums[bottom * stride + right] - sums[top * stride + right] -
+                                       sums[bottom * stride + left] + sums[top * stride + left]);
+                double mean = sum / count;
+
+                double threshold;
+                if (mode == ADAPTIVE_SAUVOLA) {
+                    double squared = (double) (squared_sums[bottom * stride + right] -
+                                               squared_sums[top * stride + right] -
+                                               squared_sums[bottom * stride + left] +
+                                               squared_sums[top * stride + left]);
+                    double variance = squared / count - mean * mean;
+                    double deviation = variance > 0 ? sqrt(variance) : 0;
+                    threshold = mean * (1 + k * (deviation / SAUVOLA_RANGE - 1));
+                } else {
+                    threshold = mean * (1 + k);
+                }
+
+                // the magnitudes are integers, so value > threshold is value > floor(threshold)
+                double floored = floor(threshold);
+                long level = floored < 0 ? 0 : (floored > UCHAR_MAX ? UCHAR_MAX : (long) floored);
+
+                size_t index = i * width + j;
+                (*thresholded_image)[index] = tables[level * (UCHAR_MAX + 1) + edges[index]];
+            }
+        }
+    }, MIN_BAND_ROWS);
+
+    free(sums);
+    if (mode == ADAPTIVE_SAUVOLA) free(squared_sums);
+
+    return 0;
+}
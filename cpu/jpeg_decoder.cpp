@@ -0,0 +1,194 @@
+#include <iostream>
+#include <cmath>
+#include <cstring>
+#include "../filters/jpeg_decoder.h"
+#include "../filters/resize_filter.h"
+
+// a private copy of the JPEG decoder of stb_image, whose IDCT can be replaced
+#define STB_IMAGE_STATIC
+#define STBI_ONLY_JPEG
+#define STB_IMAGE_IMPLEMENTATION
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+#include "../stb/stb_image.h"
+#pragma GCC diagnostic pop
+
+
+/**
+ * The basis of a reduced N point IDCT: basis[u][k] = C(k) / 2 * cos((2u + 1) k pi / 2N), with C(0) = 1 / sqrt(2).
+ *
+ * These are the cosines of the 8 point IDCT sampled at the centers of N pixel wide cells, so the low N x N
+ * coefficients of a block give the block as seen at 1 / (8 / N) of its size, without computing the 8 x 8 pixels.
+ */
+template<int N>
+struct reduced_idct_basis {
+    float basis[N][N];
+};
+
+template<int N>
+static reduced_idct_basis<N> make_basis() {
+    reduced_idct_basis<N> table{};
+    for (int u = 0; u < N; u++) {
+        for (int k = 0; k < N; k++) {
+            double scale = k == 0 ? 1 / sqrt(2.0) : 1;
+            table.basis[u][k] = (float) (scale / 2 * cos((2 * u + 1) * k * M_PI / (2 * N)));
+        }
+    }
+    return table;
+}
+
+static inline stbi_uc clamp_level(float value) {
+    return (stbi_uc) (value <= 0 ? 0 : (value >= 255 ? 255 : value + 0.5f));
+}
+
+/**
+ * Writes the N x N reduced block of the dequantized coefficients at the top left corner of the 8 x 8 block.
+ */
+template<int N>
+static void reduced_idct_block(stbi_uc *out, int out_stride, short data[64]) {
+    static const reduced_idct_basis<N> table = make_basis<N>();
+
+    // horizontal pass over the N low frequency rows
+    float rows[N][N];
+    for (int l = 0; l < N; l++) {
+        for (int u = 0; u < N; u++) {
+            float sum = 0;
+            for (int k = 0; k < N; k++) sum += table.basis[u][k] * (float) data[l * 8 + k];
+            rows[l][u] = sum;
+        }
+    }
+
+    // vertical pass
+    for (int v = 0; v < N; v++) {
+        for (int u = 0; u < N; u++) {
+            float sum = 128;
+            for (int l = 0; l < N; l++) sum += table.basis[v][l] * rows[l][u];
+            out[v * out_stride + u] = clamp_level(sum);
+        }
+    }
+}
+
+/**
+ * Writes the average of the block, which is its DC coefficient / 8.
+ */
+static void dc_only_block(stbi_uc *out, int, short data[64]) {
+    int value = ((data[0] + 4) >> 3) + 128;
+    out[0] = (stbi_uc) (value < 0 ? 0 : (value > 255 ? 255 : value));
+}
+
+/**
+ * Decodes a JPEG to gray scale with stb_image and reduces it with area averaging, for the images whose
+ * luma plane can not be used directly (RGB, CMYK or subsampled luma).
+ */
+static int decode_full_and_resize(const ubyte *data, size_t size, size_t reduction,
+                                  ubyte **image, size_t *width, size_t *height) {
+    int full_width, full_height, bpp;
+    ubyte *full = stbi_load_from_memory(data, (int) size, &full_width, &full_height, &bpp, 1);
+    if (full == nullptr) {
+        std::cout << "Failed to decode the JPEG image: " << stbi_failure_reason() << "\n";
+        return 1;
+    }
+
+    *width = ((size_t) full_width + reduction - 1) / reduction;
+    *height = ((size_t) full_height + reduction - 1) / reduction;
+
+    if (reduction == 1) {
+        *image = full;
+        return 0;
+    }
+
+    int result = resize_image(full, image, full_width, full_height, 1, *width, *height, RESIZE_AREA);
+    stbi_image_free(full);
+    return result;
+}
+
+
+/**
+ * Decodes a JPEG image to gray scale at 1, 1 / 2, 1 / 4 or 1 / 8 of its size.
+ *
+ * The gray scale image is the luma plane of the JPEG, so there is no upsampling of the chroma and no color
+ * conversion. At a reduced size, every 8 x 8 block is not transformed back to pixels: only its low frequency
+ * coefficients go through a 4 x 4 or 2 x 2 IDCT, and at 1 / 8 its DC coefficient is the pixel. The entropy
+ * decoding still reads every coefficient, but the IDCT, the chroma and the resize of a full decode are saved.
+ * Baseline and progressive JPEGs are supported. JPEGs without a usable luma plane (RGB, CMYK) are decoded
+ * at full size and reduced with area averaging instead.
+ *
+ * @param data The JPEG file in memory.
+ * @param size The size of the file in bytes.
+ * @param reduction 1, 2, 4 or 8.
+ * @param image A pointer to a buffer that will hold the decoded image (release it with free).
+ * @param width Receives the width of the decoded image, the width of the JPEG divided by reduction, rounded up.
+ * @param height Receives the height of the decoded image, the height of the JPEG divided by reduction, rounded up.
+ * @return 0 if the image was decoded, or 1 if the JPEG is invalid or memory allocation failed.
+ */
+int decode_jpeg_gray_scaled(const ubyte *data, size_t size, size_t reduction,
+                            ubyte **image, size_t *width, size_t *height) {
+    // Check if the input and the reduction are valid
+    if (data == nullptr || size == 0 || size > INT_MAX ||
+        (reduction != 1 && reduction != 2 && reduction != 4 && reduction != 8)) {
+        std::cout << "Invalid JPEG data or reduction\n";
+        return 1;
+    }
+
+    stbi__context context;
+    stbi__start_mem(&context, data, (int) size);
+
+    // zeroed as stb_image does, so tables a broken file never defines stay empty
+    auto *jpeg = (stbi__jpeg *) calloc(1, sizeof(stbi__jpeg));
+    if (jpeg == nullptr) {
+        std::cout << "Failed to allocate memory for the JPEG decoder!\n";
+        return 1;
+    }
+    jpeg->s = &context;
+    stbi__setup_jpeg(jpeg);
+    context.img_n = 0;
+
+    if (reduction == 8) jpeg->idct_block_kernel = dc_only_block;
+    else if (reduction == 4) jpeg->idct_block_kernel = reduced_idct_block<2>;
+    else if (reduction == 2) jpeg->idct_block_kernel = reduced_idct_block<4>;
+
+    if (!stbi__decode_jpeg_image(jpeg)) {
+        std::cout << "Failed to decode the JPEG image: " << stbi_failure_reason() << "\n";
+        stbi__cleanup_jpeg(jpeg);
+        free(jpeg);
+        return 1;
+    }
+
+    // the first component is the luma of gray scale and YCbCr JPEGs
+    bool is_rgb = context.img_n == 3 && (jpeg->rgb == 3 || (jpeg->app14_color_transform == 0 && !jpeg->jfif));
+    const auto &luma = jpeg->img_comp[0];
+    if (context.img_n == 4 || is_rgb || luma.h != jpeg->img_h_max || luma.v != jpeg->img_v_max) {
+        stbi__cleanup_jpeg(jpeg);
+        free(jpeg);
+        return decode_full_and_resize(data, size, reduction, image, width, height);
+    }
+
+    *width = (context.img_x + reduction - 1) / reduction;
+    *height = (context.img_y + reduction - 1) / reduction;
+    *image = (ubyte *) malloc(*width * *height * sizeof(ubyte));
+
+    // Check if the memory was allocated
+    if (*image == nullptr) {
+        std::cout << "Failed to allocate memory for the decoded image!\n";
+        stbi__cleanup_jpeg(jpeg);
+        free(jpeg);
+        return 1;
+    }
+
+    // the reduced blocks are at the top left corner of the 8 x 8 blocks of the plane
+    size_t block_size = 8 / reduction;
+    for (size_t i = 0; i < *height; i++) {
+        const stbi_uc *row = luma.data + ((i / block_size) * 8 + i % block_size) * (size_t) luma.w2;
+        ubyte *out = *image + i * *width;
+        if (block_size == 8) {
+            memcpy(out, row, *width);
+        } else {
+            for (size_t j = 0; j < *width; j++) out[j] = row[(j / block_size) * 8 + j % block_size];
+        }
+    }
+
+    stbi__cleanup_jpeg(jpeg);
+    free(jpeg);
+    return 0;
+}
@@ -0,0 +1,365 @@
+#include <iostream>
+#include <vector>
+#include <cstring>
+#include "../filters/morphology_filter.h"
+#include "../filters/sobel_filter.h"
+#include "../filters/parallel.h"
+
+
+// number of columns every thread processes at once in the vertical pass
+#define COLUMN_STRIP 64
+
+// number of rows every thread processes at once in the horizontal pass
+#define ROW_STRIP 16
+
+
+/**
+ * Combines two pixels: maximum for a dilation, minimum for an erosion.
+ */
+template<bool Dilate>
+static inline ubyte combine(ubyte a, ubyte b) {
+    if (Dilate) return a > b ? a : b;
+    return a < b ? a : b;
+}
+
+/**
+ * Value of the pixels outside the image, it never wins against a pixel of the image.
+ */
+template<bool Dilate>
+static inline ubyte neutral() {
+    return Dilate ? 0 : UCHAR_MAX;
+}
+
+/**
+ * Number of padded elements used by the van Herk/Gil-Werman algorithm for a line of n pixels
+ * and a window of k pixels: the line plus the window overhang, rounded up to whole blocks of k.
+ */
+static inline size_t padded_length(size_t n, size_t k) {
+    return (n + k - 1 + k - 1) / k * k;
+}
+
+
+/**
+ * Dilates or erodes a strip of up to ROW_STRIP rows with a window of k pixels (van Herk/Gil-Werman).
+ *
+ * The padded rows are split into blocks of k pixels, and a running prefix and suffix are computed
+ * inside every block. Every window spans at most two blocks, so its result is the suffix of the
+ * first block combined with the prefix of the second one: three comparisons per pixel, whatever
+ * the size of the window. The rows of the strip are transposed first, so that every step is an
+ * element-wise maximum (or minimum) over the ROW_STRIP rows that the compiler vectorizes, like the
+ * column strips of column_pass.
+ *
+ * @param input The first input row.
+ * @param output The first output row.
+ * @param width The number of pixels in a row (also the distance between the rows).
+ * @param rows The number of rows in the strip (at most ROW_STRIP).
+ * @param k The size of the window (centered on the pixel).
+ * @param lines Scratch buffer of padded_length(width, k) * ROW_STRIP elements.
+ * @param prefix Scratch buffer of padded_length(width, k) * ROW_STRIP elements.
+ * @param suffix Scratch buffer of padded_length(width, k) * ROW_STRIP elements.
+ */
+template<bool Dilate>
+static void row_strip_pass(const ubyte *input, ubyte *output, size_t width, size_t rows, size_t k,
+                           ubyte *lines, ubyte *prefix, ubyte *suffix) {
+    if (k <= 1) {
+        memcpy(output, input, width * rows);
+        return;
+    }
+
+    size_t anchor = k / 2, length = padded_length(width, k);
+
+    // transposed padded rows, the pixels outside the image and the missing rows are neutral
+    memset(lines, neutral<Dilate>(), length * ROW_STRIP);
+    for (size_t r = 0; r < rows; r++)
+        for (size_t j = 0; j < width; j++) lines[(j + anchor) * ROW_STRIP + r] = input[r * width + j];
+
+    for (size_t p = 0; p < length; p++) {
+        const ubyte *in = lines + p * ROW_STRIP;
+        ubyte *current = prefix + p * ROW_STRIP;
+        if (p % k == 0) {
+            memcpy(current, in, ROW_STRIP);
+        } else {
+            const ubyte *previous = current - ROW_STRIP;
+            for (size_t r = 0; r < ROW_STRIP; r++) current[r] = combine<Dilate>(previous[r], in[r]);
+        }
+    }
+
+    for (size_t p = length; p-- > 0;) {
+        const ubyte *in = lines + p * ROW_STRIP;
+        ubyte *current = suffix + p * ROW_STRIP;
+        if (p % k == k - 1) {
+            memcpy(current, in, ROW_STRIP);
+        } else {
+            const ubyte *next = current + ROW_STRIP;
+            for (size_t r = 0; r < ROW_STRIP; r++) current[r] = combine<Dilate>(next[r], in[r]);
+        }
+    }
+
+    // the results go to the (no longer needed) transposed rows, then back to the output rows
+    for (size_t j = 0; j < width; j++) {
+        const ubyte *first = suffix + j * ROW_STRIP;
+        const ubyte *second = prefix + (j + k - 1) * ROW_STRIP;
+        ubyte *result = lines + j * ROW_STRIP;
+        for (size_t r = 0; r < ROW_STRIP; r++) result[r] = combine<Dilate>(first[r], second[r]);
+    }
+    for (size_t r = 0; r < rows; r++)
+        for (size_t j = 0; j < width; j++) output[r * width + j] = lines[j * ROW_STRIP + r];
+}
+
+/**
+ * Scratch buffers of row_strip_pass for one thread.
+ */
+struct row_strip_buffers {
+    std::vector<ubyte> lines, prefix, suffix;
+
+    row_strip_buffers(size_t width, size_t k)
+            : lines(padded_length(width, k) * ROW_STRIP),
+              prefix(padded_length(width, k) * ROW_STRIP),
+              suffix(padded_length(width, k) * ROW_STRIP) {}
+};
+
+/**
+ * Dilates or erodes the columns of an image with a window of k pixels (van Herk/Gil-Werman).
+ *
+ * Same algorithm as row_strip_pass, but the running prefixes and suffixes are computed a whole strip of
+ * columns at a time, so every step is an element-wise maximum (or minimum) of two rows that the
+ * compiler vectorizes. The strips are processed in parallel.
+ *
+ * @param input The input image.
+ * @param output The output image.
+ * @param width The width of the image in pixels.
+ * @param height The height of the image in pixels.
+ * @param k The size of the window (centered on the pixel).
+ */
+template<bool Dilate>
+static void column_pass(const ubyte *input, ubyte *output, size_t width, size_t height, size_t k) {
+    if (k <= 1) {
+        memcpy(output, input, width * height);
+        return;
+    }
+
+    size_t anchor = k / 2, length = padded_length(height, k);
+    size_t strips = (width + COLUMN_STRIP - 1) / COLUMN_STRIP;
+
+    parallel_for(0, strips, [&](size_t strip_begin, size_t strip_end, size_t) {
+        std::vector<ubyte> prefix(length * COLUMN_STRIP), suffix(length * COLUMN_STRIP);
+        std::vector<ubyte> outside(COLUMN_STRIP, neutral<Dilate>());
+
+        for (size_t strip = strip_begin; strip < strip_end; strip++) {
+            size_t column = strip * COLUMN_STRIP;
+            size_t columns = column + COLUMN_STRIP < width ? COLUMN_STRIP : width - column;
+
+            auto padded = [&](size_t p) {
+                return p >= anchor && p - anchor < height ? input + (p - anchor) * width + column : outside.data();
+            };
+
+            for (size_t p = 0; p < length; p++) {
+                const ubyte *in = padded(p);
+                ubyte *current = prefix.data() + p * COLUMN_STRIP;
+                if (p % k == 0) {
+                    memcpy(current, in, columns);
+                } else {
+                    const ubyte *previous = current - COLUMN_STRIP;
+                    for (size_t c = 0; c < columns; c++) current[c] = combine<Dilate>(previous[c], in[c]);
+                }
+            }
+
+            for (size_t p = length; p-- > 0;) {
+                const ubyte *in = padded(p);
+                ubyte *current = suffix.data() + p * COLUMN_STRIP;
+                if (p % k == k - 1) {
+                    memcpy(current, in, columns);
+                } else {
+                    const ubyte *next = current + COLUMN_STRIP;
+                    for (size_t c = 0; c < columns; c++) current[c] = combine<Dilate>(next[c], in[c]);
+                }
+            }
+
+            for (size_t i = 0; i < height; i++) {
+                const ubyte *first = suffix.data() + i * COLUMN_STRIP;
+                const ubyte *second = prefix.data() + (i + k - 1) * COLUMN_STRIP;
+                ubyte *out = output + i * width + column;
+                for (size_t c = 0; c < columns; c++) out[c] = combine<Dilate>(first[c], second[c]);
+            }
+        }
+    });
+}
+
+/**
+ * Dilates or erodes the rows of an image, strip by strip, the strips are processed in parallel.
+ */
+template<bool Dilate>
+static void rows_pass(const ubyte *input, ubyte *output, size_t width, size_t height, size_t k) {
+    size_t strips = (height + ROW_STRIP - 1) / ROW_STRIP;
+
+    parallel_for(0, strips, [&](size_t strip_begin, size_t strip_end, size_t) {
+        row_strip_buffers buffers(width, k);
+        for (size_t strip = strip_begin; strip < strip_end; strip++) {
+            size_t row = strip * ROW_STRIP;
+            size_t rows = row + ROW_STRIP < height ? ROW_STRIP : height - row;
+            row_strip_pass<Dilate>(input + row * width, output + row * width, width, rows, k,
+                                   buffers.lines.data(), buffers.prefix.data(), buffers.suffix.data());
+        }
+    });
+}
+
+/**
+ * Dilates (or erodes) an image with a rectangular structuring element as a row pass followed by a
+ * column pass.
+ *
+ * The row pass has read the whole input before the column pass writes the output, so the input
+ * and the output may be the same buffer.
+ *
+ * @param input The input image.
+ * @param output The output image (may be input).
+ * @param scratch A buffer of width * height pixels for the row pass.
+ */
+static void morph(const ubyte *input, ubyte *output, ubyte *scratch,
+                  size_t width, size_t height,
+                  size_t element_width, size_t element_height,
+                  bool dilate) {
+    if (dilate) {
+        rows_pass<true>(input, scratch, width, height, element_width);
+        column_pass<true>(scratch, output, width, height, element_height);
+    } else {
+        rows_pass<false>(input, scratch, width, height, element_width);
+        column_pass<false>(scratch, output, width, height, element_height);
+    }
+}
+
+
+/**
+ * Applies a morphological operation with a rectangular structuring element to an image.
+ *
+ * Works on binary and gray edge maps alike (dilation is a local maximum, erosion a local minimum).
+ * The van Herk/Gil-Werman algorithm keeps the cost per pixel constant for any element size.
+ * Pixels outside the image never take part in the result.
+ *
+ * @param image A pointer to the input image data (single channel).
+ * @param result_image A pointer to a buffer that will hold the resulting image data.
+ * @param width The width of the image in pixels.
+ * @param height The height of the image in pixels.
+ * @param element_width The width of the structuring element.
+ * @param element_height The height of the structuring element.
+ * @param operation MORPHOLOGY_DILATE, MORPHOLOGY_ERODE, MORPHOLOGY_CLOSE or MORPHOLOGY_OPEN.
+ * @return 0 if the operation succeeded, or 1 if memory allocation failed or the input is invalid.
+ */
+int apply_morphology(const ubyte *image, ubyte **result_image, size_t width, size_t height,
+                     size_t element_width, size_t element_height,
+                     morphology_operation operation) {
+    // Check if the input image and structuring element are valid
+    if (image == nullptr || element_width == 0 || element_height == 0) {
+        std::cout << "Invalid input image or structuring element\n";
+        return 1;
+    }
+
+    *result_image = (ubyte *) malloc(width * height * sizeof(ubyte));
+    auto *scratch = (ubyte *) malloc(width * height * sizeof(ubyte));
+
+    // Check if the memory was allocated
+    if (*result_image == nullptr || scratch == nullptr) {
+        std::cout << "Failed to allocate memory for the morphology result!\n";
+        free(*result_image);
+        free(scratch);
+        return 1;
+    }
+
+    bool dilate_first = operation == MORPHOLOGY_DILATE || operation == MORPHOLOGY_CLOSE;
+    morph(image, *result_image, scratch, width, height, element_width, element_height, dilate_first);
+
+    // second operation, in place: from the result to the scratch buffer and back
+    if (operation == MORPHOLOGY_CLOSE || operation == MORPHOLOGY_OPEN)
+        morph(*result_image, *result_image, scratch, width, height, element_width, element_height, !dilate_first);
+
+    free(scratch);
+    return 0;
+}
+
+/**
+ * Detect Edges by using Sobel Operation followed by a morphological operation
+ *
+ * The morphology is fused after the Sobel pass: every strip computes its Sobel rows and runs the
+ * row pass of the first operation on them right away, so the edge map itself is never stored.
+ * The result is the same as apply_morphology on the output of detect_edges.
+ *
+ * @param image input image
+ * @param edges_detected_image output image
+ * @param width width of input image
+ * @param height height of input image
+ * @param threshold threshold to apply
+ * @param strength_ratio ratio used to strengthen or weaken the edges
+ * @param element_width width of the structuring element
+ * @param element_height height of the structuring element
+ * @param operation morphological operation applied to the edges
+ * @return 1 if any error occurs
+ */
+int detect_edges_morphology(const ubyte *image, ubyte **edges_detected_image, size_t width, size_t height,
+                            ubyte threshold,
+                            double strength_ratio,
+                            size_t element_width, size_t element_height,
+                            morphology_operation operation) {
+    // Check if the input image and structuring element are valid
+    if (image == nullptr || element_width == 0 || element_height == 0) {
+        std::cout << "Invalid input image or structuring element\n";
+        return 1;
+    }
+
+    *edges_detected_image = (ubyte *) malloc(width * height * sizeof(ubyte));
+    auto *rows_image = (ubyte *) malloc(width * height * sizeof(ubyte));
+
+    // check if the memory was allocated
+    if (*edges_detected_image == nullptr || rows_image == nullptr) {
+        std::cout << "Failed to allocate memory for the edge detected image!\n";
+        free(*edges_detected_image);
+        free(rows_image);
+        return 1;
+    }
+
+    ubyte table[SOBEL_MAGNITUDE_LEVELS];
+    build_edge_strength_table(threshold, strength_ratio, table);
+
+    bool dilate_first = operation == MORPHOLOGY_DILATE || operation == MORPHOLOGY_CLOSE;
+
+    // Sobel rows and the row pass of the first operation, strip by strip
+    size_t strips = (height + ROW_STRIP - 1) / ROW_STRIP;
+    parallel_for(0, strips, [&](size_t strip_begin, size_t strip_end, size_t) {
+        std::vector<int16> gx(width), gy(width);
+        std::vector<unsigned short> magnitudes(width);
+        std::vector<ubyte> edges(width * ROW_STRIP);
+        row_strip_buffers buffers(width, element_width);
+
+        for (size_t strip = strip_begin; strip < strip_end; strip++) {
+            size_t row = strip * ROW_STRIP;
+            size_t rows = row + ROW_STRIP < height ? ROW_STRIP : height - row;
+
+            for (size_t i = row; i < row + rows; i++) {
+                const ubyte *above = i > 0 ? image + (i - 1) * width : nullptr;
+                const ubyte *below = i + 1 < height ? image + (i + 1) * width : nullptr;
+
+                sobel_gradient_row(above, image + i * width, below, gx.data(), gy.data(), width);
+                sobel_magnitude_row(gx.data(), gy.data(), magnitudes.data(), width);
+                ubyte *out = edges.data() + (i - row) * width;
+                for (size_t j = 0; j < width; j++) out[j] = table[magnitudes[j]];
+            }
+
+            if (dilate_first)
+                row_strip_pass<true>(edges.data(), rows_image + row * width, width, rows, element_width,
+                                     buffers.lines.data(), buffers.prefix.data(), buffers.suffix.data());
+            else
+                row_strip_pass<false>(edges.data(), rows_image + row * width, width, rows, element_width,
+                                      buffers.lines.data(), buffers.prefix.data(), buffers.suffix.data());
+        }
+    });
+
+    // column pass of the first operation
+    if (dilate_first) column_pass<true>(rows_image, *edges_detected_image, width, height, element_height);
+    else column_pass<false>(rows_image, *edges_detected_image, width, height, element_height);
+
+    // second operation of a closing or an opening, in place through the row buffer
+    if (operation == MORPHOLOGY_CLOSE || operation == MORPHOLOGY_OPEN)
+        morph(*edges_detected_image, *edges_detected_image, rows_image, width, height, element_width, element_height,
+              !dilate_first);
+
+    free(rows_image);
+    return 0;
+}
@@ -0,0 +1,262 @@
+#include <iostream>
+#include <vector>
+#include <cstring>
+#include "../filters/pyramid.h"
+#include "../filters/edge_operators.h"
+#include "../filters/parallel.h"
+
+
+// levels are not reduced below this size in either direction
+#define MIN_LEVEL_SIZE 8
+
+// minimum number of rows per band, smaller bands are not worth a thread
+#define MIN_BAND_ROWS 16
+
+
+static inline long clamp_index(long index, long size) {
+    return index < 0 ? 0 : (index >= size ? size - 1 : index);
+}
+
+
+/**
+ * Smooths an image with the 5-tap binomial kernel [1, 4, 6, 4, 1] / 16 and halves its size.
+ *
+ * Only the kept pixels are computed: every output row is the vertical pass over five input rows,
+ * followed by the horizontal pass at the even columns. The output rows are split into bands that
+ * are processed in parallel. Pixels outside the image are replaced by the nearest border pixel.
+ *
+ * @param image A pointer to the input image data (single channel).
+ * @param reduced_image A pointer to a buffer that will hold the (width + 1) / 2 x (height + 1) / 2 result.
+ * @param width The width of the image in pixels.
+ * @param height The height of the image in pixels.
+ * @return 0 if the reduction succeeded, or 1 if memory allocation failed or the input image is invalid.
+ */
+int pyramid_down(const ubyte *image, ubyte **reduced_image, size_t width, size_t height) {
+    // Check if the input image is valid
+    if (image == nullptr || width == 0 || height == 0) {
+        std::cout << "Invalid input image\n";
+        return 1;
+    }
+
+    size_t reduced_width = (width + 1) / 2, reduced_height = (height + 1) / 2;
+    *reduced_image = (ubyte *) malloc(reduced_width * reduced_height * sizeof(ubyte));
+
+    // Check if the memory was allocated
+    if (*reduced_image == nullptr) {
+        std::cout << "Failed to allocate memory for the reduced image!\n";
+        return 1;
+    }
+
+    parallel_for(0, reduced_height, [&](size_t row_begin, size_t row_end, size_t) {
+        // vertical sums with two replicated columns on both sides
+        std::vector<unsigned short> padded(width + 4);
+        unsigned short *vertical = padded.data() + 2;
+
+        for (size_t i = row_begin; i < row_end; i++) {
+            const ubyte *rows[5];
+            for (long k = 0; k < 5; k++)
+                rows[k] = image + clamp_index(2 * (long) i + k - 2, (long) height) * width;
+
+            for (size_t j = 0; j < width; j++)
+                vertical[j] = (unsigned short) (rows[0][j] + 4 * rows[1][j] + 6 * rows[2][j] + 4 * rows[3][j] + rows[4][j]);
+            vertical[-2] = vertical[-1] = vertical[0];
+            vertical[width] = vertical[width + 1] = vertical[width - 1];
+
+            ubyte *out = *reduced_image + i * reduced_width;
+            for (size_t j = 0; j < reduced_width; j++) {
+                const unsigned short *center = vertical + 2 * j;
+                unsigned int sum = center[-2] + 4 * center[-1] + 6 * center[0] + 4 * center[1] + center[2];
+                out[j] = (ubyte) ((sum + 128) >> 8);
+            }
+        }
+    }, MIN_BAND_ROWS);
+
+    return 0;
+}
+
+/**
+ * Builds a Gaussian pyramid: level 0 is a copy of the image, every next level is pyramid_down of the
+ * previous one. Since every level has a quarter of the pixels of the previous one, the whole pyramid
+ * costs about 4 / 3 of the first level.
+ *
+ * @param image A pointer to the input image data (single channel).
+ * @param width The width of the image in pixels.
+ * @param height The height of the image in pixels.
+ * @param levels The number of levels to build, fewer are built if the levels would get smaller than 8 pixels.
+ * @param pyramid A pointer to a buffer that will hold the levels (release it with free_pyramid).
+ * @param count Receives the number of levels built.
+ * @return 0 if the pyramid was built, or 1 if memory allocation failed or the input image is invalid.
+ */
+int build_pyramid(const ubyte *image, size_t width, size_t height, size_t levels,
+                  pyramid_level **pyramid, size_t *count) {
+    // Check if the input image is valid
+    if (image == nullptr || levels == 0) {
+        std::cout << "Invalid input image or number of levels\n";
+        return 1;
+    }
+
+    *pyramid = (pyramid_level *) calloc(levels, sizeof(pyramid_level));
+    if (*pyramid == nullptr) {
+        std::cout << "Failed to allocate memory for the pyramid!\n";
+        return 1;
+    }
+
+    pyramid_level *level = *pyramid;
+    level[0] = {(ubyte *) malloc(width * height * sizeof(ubyte)), width, height};
+    if (level[0].image == nullptr) {
+        std::cout << "Failed to allocate memory for the pyramid!\n";
+        free(*pyramid);
+        return 1;
+    }
+    memcpy(level[0].image, image, width * height * sizeof(ubyte));
+
+    *count = 1;
+    for (size_t l = 1; l < levels; l++) {
+        const pyramid_level &previous = level[l - 1];
+        if ((previous.width + 1) / 2 < MIN_LEVEL_SIZE || (previous.height + 1) / 2 < MIN_LEVEL_SIZE) break;
+
+        if (pyramid_down(previous.image, &level[l].image, previous.width, previous.height) != 0) {
+            free_pyramid(*pyramid, *count);
+            return 1;
+        }
+        level[l].width = (previous.width + 1) / 2;
+        level[l].height = (previous.height + 1) / 2;
+        (*count)++;
+    }
+
+    return 0;
+}
+
+/**
+ * Releases a pyramid built by build_pyramid or detect_edges_multiscale.
+ *
+ * @param pyramid The levels.
+ * @param count The number of levels.
+ */
+void free_pyramid(pyramid_level *pyramid, size_t count) {
+    if (pyramid == nullptr) return;
+    for (size_t l = 0; l < count; l++) free(pyramid[l].image);
+    free(pyramid);
+}
+
+/**
+ * Detect Edges by using Sobel Operation on every level of a Gaussian pyramid
+ *
+ * Coarse levels only keep the structural edges, since the fine texture is smoothed away, and cost
+ * a quarter of the previous level each.
+ *
+ * @param image input image
+ * @param width width of input image
+ * @param height height of input image
+ * @param levels number of levels, fewer are used if the levels would get smaller than 8 pixels
+ * @param threshold threshold to apply
+ * @param strength_ratio ratio used to strengthen or weaken the edges
+ * @param edges output edges of every level (release them with free_pyramid)
+ * @param count receives the number of levels
+ * @return 1 if any error occurs
+ */
+int detect_edges_multiscale(const ubyte *image, size_t width, size_t height, size_t levels,
+                            ubyte threshold,
+                            double strength_ratio,
+                            pyramid_level **edges, size_t *count) {
+    pyramid_level *pyramid;
+    if (build_pyramid(image, width, height, levels, &pyramid, count) != 0) return 1;
+
+    *edges = (pyramid_level *) calloc(*count, sizeof(pyramid_level));
+    if (*edges == nullptr) {
+        std::cout << "Failed to allocate memory for the edges!\n";
+        free_pyramid(pyramid, *count);
+        return 1;
+    }
+
+    for (size_t l = 0; l < *count; l++) {
+        (*edges)[l].width = pyramid[l].width;
+        (*edges)[l].height = pyramid[l].height;
+        if (detect_edges_operator(pyramid[l].image, &(*edges)[l].image, pyramid[l].width, pyramid[l].height,
+                                  OPERATOR_SOBEL, threshold, strength_ratio) != 0) {
+            free_pyramid(*edges, l);
+            free_pyramid(pyramid, *count);
+            return 1;
+        }
+    }
+
+    free_pyramid(pyramid, *count);
+    return 0;
+}
+
+/**
+ * Detect Edges by using Sobel Operation at several scales, combined by their maximum
+ *
+ * The edges of every pyramid level are upsampled to the size of the image with bilinear
+ * interpolation and the strongest response of every pixel is kept.
+ *
+ * @param image input image
+ * @param edges_detected_image output image
+ * @param width width of input image
+ * @param height height of input image
+ * @param levels number of levels, fewer are used if the levels would get smaller than 8 pixels
+ * @param threshold threshold to apply
+ * @param strength_ratio ratio used to strengthen or weaken the edges
+ * @return 1 if any error occurs
+ */
+int detect_edges_multiscale_max(const ubyte *image, ubyte **edges_detected_image, size_t width, size_t height,
+                                size_t levels,
+                                ubyte threshold,
+                                double strength_ratio) {
+    pyramid_level *edges;
+    size_t count;
+    if (detect_edges_multiscale(image, width, height, levels, threshold, strength_ratio, &edges, &count) != 0)
+        return 1;
+
+    *edges_detected_image = (ubyte *) malloc(width * height * sizeof(ubyte));
+
+    // check if the memory was allocated
+    if (*edges_detected_image == nullptr) {
+        std::cout << "Failed to allocate memory for the edge detected image!\n";
+        free_pyramid(edges, count);
+        return 1;
+    }
+
+    memcpy(*edges_detected_image, edges[0].image, width * height * sizeof(ubyte));
+
+    parallel_for(0, height, [&](size_t row_begin, size_t row_end, size_t) {
+        std::vector<long> left(width), right(width);
+        std::vector<float> weight(width);
+
+        for (size_t l = 1; l < count; l++) {
+            const pyramid_level &level = edges[l];
+            auto scale = (float) (1 << l);
+
+            // horizontal sample positions, shared by all rows of the level
+            for (size_t j = 0; j < width; j++) {
+                float x = ((float) j + 0.5f) / scale - 0.5f;
+                x = x < 0 ? 0 : x;
+                left[j] = clamp_index((long) x, (long) level.width);
+                right[j] = clamp_index(left[j] + 1, (long) level.width);
+                weight[j] = x - (float) left[j];
+            }
+
+            for (size_t i = row_begin; i < row_end; i++) {
+                float y = ((float) i + 0.5f) / scale - 0.5f;
+                y = y < 0 ? 0 : y;
+                long top = clamp_index((long) y, (long) level.height);
+                long bottom = clamp_index(top + 1, (long) level.height);
+                float vertical = y - (float) top;
+
+                const ubyte *upper = level.image + top * level.width;
+                const ubyte *lower = level.image + bottom * level.width;
+                ubyte *out = *edges_detected_image + i * width;
+
+                for (size_t j = 0; j < width; j++) {
+                    float a = upper[left[j]] + weight[j] * (float) (upper[right[j]] - upper[left[j]]);
+                    float b = lower[left[j]] + weight[j] * (float) (lower[right[j]] - lower[left[j]]);
+                    auto value = (ubyte) (a + vertical * (b - a) + 0.5f);
+                    out[j] = value > out[j] ? value : out[j];
+                }
+            }
+        }
+    }, MIN_BAND_ROWS);
+
+    free_pyramid(edges, count);
+    return 0;
+}
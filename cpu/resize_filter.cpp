@@ -0,0 +1,177 @@
+#include <iostream>
+#include <vector>
+#include <climits>
+#include "../filters/resize_filter.h"
+#include "../filters/parallel.h"
+
+
+// fixed point precision of the coefficients
+#define WEIGHT_BITS 14
+
+// fixed point precision of the vertically resized rows (8.7, so that the horizontal sums fit in 32 bits)
+#define FRACTION_BITS 7
+
+// shifts from the Q14 sums back to 8.7 fixed point and from the Q21 sums back to a byte
+#define VERTICAL_SHIFT (WEIGHT_BITS - FRACTION_BITS)
+#define HORIZONTAL_SHIFT (WEIGHT_BITS + FRACTION_BITS)
+
+// minimum number of rows per band, smaller bands are not worth a thread
+#define MIN_BAND_ROWS 8
+
+
+/**
+ * The coefficients of a one dimensional resize: output pixel x is the sum of
+ * weights[x * taps + k] * input[first[x] + k] for k in [0, taps).
+ */
+struct resize_table {
+    size_t taps;
+    std::vector<size_t> first;
+    std::vector<int> weights;   // Q14, the weights of every output pixel sum to 1 << WEIGHT_BITS
+};
+
+/**
+ * Computes the coefficients that resize a line of size pixels to resized_size pixels.
+ *
+ * Area averaging weights every input pixel by the fraction of it the output pixel covers, for any
+ * (integer or fractional) factor. Enlarging with area averaging is the same as bilinear interpolation,
+ * which is used instead. The output pixel centers are aligned with the input pixel centers.
+ */
+static resize_table make_table(size_t size, size_t resized_size, resize_method method) {
+    double scale = (double) size / (double) resized_size;
+    bool area = method == RESIZE_AREA && scale > 1;
+
+    resize_table table{};
+    table.taps = area ? (size_t) ceil(scale) + 1 : 2;
+    if (table.taps > size) table.taps = size;
+    table.first.resize(resized_size);
+    table.weights.resize(resized_size * table.taps);
+
+    std::vector<double> weights(table.taps);
+    for (size_t x = 0; x < resized_size; x++) {
+        double begin, end;
+        long first;
+        if (area) {
+            begin = (double) x * scale, end = (double) (x + 1) * scale;
+            first = (long) begin;
+        } else {
+            begin = ((double) x + 0.5) * scale - 0.5;
+            begin = begin < 0 ? 0 : (begin > (double) (size - 1) ? (double) (size - 1) : begin);
+            end = begin;
+            first = (long) begin;
+        }
+        if (first + (long) table.taps > (long) size) first = (long) (size - table.taps);
+        table.first[x] = (size_t) first;
+
+        for (size_t k = 0; k < table.taps; k++) {
+            auto position = (double) (first + (long) k);
+            if (area) {
+                double overlap = (end < position + 1 ? end : position + 1) - (begin > position ? begin : position);
+                weights[k] = overlap > 0 ? overlap / scale : 0;
+            } else {
+                double distance = fabs(begin - position);
+                weights[k] = distance < 1 ? 1 - distance : 0;
+            }
+        }
+
+        // quantize the weights and give the rounding error to the largest one so that they sum to one
+        int total = 0;
+        size_t largest = 0;
+        int *quantized = table.weights.data() + x * table.taps;
+        for (size_t k = 0; k < table.taps; k++) {
+            quantized[k] = (int) lround(weights[k] * (1 << WEIGHT_BITS));
+            total += quantized[k];
+            if (weights[k] > weights[largest]) largest = k;
+        }
+        quantized[largest] += (1 << WEIGHT_BITS) - total;
+    }
+
+    return table;
+}
+
+/**
+ * Resizes a vertically resized row horizontally, for a compile time number of channels.
+ */
+template<size_t Channels>
+static void horizontal_pass(const unsigned short *input, ubyte *output, const resize_table &table,
+                            size_t resized_width, size_t channels) {
+    size_t stride = Channels != 0 ? Channels : channels;
+    for (size_t x = 0; x < resized_width; x++) {
+        const int *weights = table.weights.data() + x * table.taps;
+        const unsigned short *source = input + table.first[x] * stride;
+
+        for (size_t c = 0; c < stride; c++) {
+            int sum = 0;
+            for (size_t k = 0; k < table.taps; k++) sum += weights[k] * source[k * stride + c];
+            int value = (sum + (1 << (HORIZONTAL_SHIFT - 1))) >> HORIZONTAL_SHIFT;
+            output[x * stride + c] = (ubyte) (value > UCHAR_MAX ? UCHAR_MAX : value);
+        }
+    }
+}
+
+
+/**
+ * Resizes an image with area averaging or bilinear interpolation.
+ *
+ * The coefficients of both directions are computed once into tables. Every output row is resized
+ * vertically first, which is a vectorizable weighted sum of a few whole input rows (all channels at
+ * once), then horizontally from the table. The output rows are split into bands that are processed
+ * in parallel. The channels are interleaved, and 1 and 3 channels have their own specialized loop.
+ *
+ * @param image A pointer to the input image data.
+ * @param resized_image A pointer to a buffer that will hold the resized image data.
+ * @param width The width of the image in pixels.
+ * @param height The height of the image in pixels.
+ * @param channels The number of interleaved channels per pixel.
+ * @param resized_width The width of the resized image in pixels.
+ * @param resized_height The height of the resized image in pixels.
+ * @param method RESIZE_AREA (for downscaling) or RESIZE_BILINEAR.
+ * @return 0 if the resize succeeded, or 1 if memory allocation failed or the input is invalid.
+ */
+int resize_image(const ubyte *image, ubyte **resized_image, size_t width, size_t height, size_t channels,
+                 size_t resized_width, size_t resized_height,
+                 resize_method method) {
+    // Check if the input image and sizes are valid
+    if (image == nullptr || channels == 0 || width == 0 || height == 0 || resized_width == 0 || resized_height == 0) {
+        std::cout << "Invalid input image or size\n";
+        return 1;
+    }
+
+    *resized_image = (ubyte *) malloc(resized_width * resized_height * channels * sizeof(ubyte));
+
+    // Check if the memory was allocated
+    if (*resized_image == nullptr) {
+        std::cout << "Failed to allocate memory for the resized image!\n";
+        return 1;
+    }
+
+    resize_table horizontal = make_table(width, resized_width, method);
+    resize_table vertical = make_table(height, resized_height, method);
+    size_t row_size = width * channels;
+
+    parallel_for(0, resized_height, [&](size_t row_begin, size_t row_end, size_t) {
+        std::vector<int> sum(row_size);
+        std::vector<unsigned short> row(row_size);
+
+        for (size_t y = row_begin; y < row_end; y++) {
+            // vertical pass over whole rows
+            std::fill(sum.begin(), sum.end(), 0);
+            const int *weights = vertical.weights.data() + y * vertical.taps;
+            for (size_t k = 0; k < vertical.taps; k++) {
+                const ubyte *in = image + (vertical.first[y] + k) * row_size;
+                int weight = weights[k];
+                if (weight == 0) continue;
+                for (size_t j = 0; j < row_size; j++) sum[j] += weight * in[j];
+            }
+            for (size_t j = 0; j < row_size; j++)
+                row[j] = (unsigned short) ((sum[j] + (1 << (VERTICAL_SHIFT - 1))) >> VERTICAL_SHIFT);
+
+            // horizontal pass from the table
+            ubyte *out = *resized_image + y * resized_width * channels;
+            if (channels == 1) horizontal_pass<1>(row.data(), out, horizontal, resized_width, channels);
+            else if (channels == 3) horizontal_pass<3>(row.data(), out, horizontal, resized_width, channels);
+            else horizontal_pass<0>(row.data(), out, horizontal, resized_width, channels);
+        }
+    }, MIN_BAND_ROWS);
+
+    return 0;
+}
@@ -0,0 +1,263 @@
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include "../filters/roi_filter.h"
+#include "../filters/sobel_filter.h"
+#include "../filters/parallel.h"
+
+
+// minimum number of runs per band, smaller bands are not worth a thread
+#define MIN_BAND_RUNS 64
+
+
+/**
+ * Converts rectangles to the runs of their rows.
+ *
+ * The rectangles are clipped to the image, and the runs of overlapping rectangles are merged, so every
+ * pixel is in at most one run. The runs are sorted by row, then by column. The cost is proportional to
+ * the total height of the rectangles, not to the size of the image.
+ *
+ * @param rois The rectangles.
+ * @param roi_count The number of rectangles.
+ * @param width The width of the image in pixels.
+ * @param height The height of the image in pixels.
+ * @param runs A pointer to a buffer that will hold the runs.
+ * @param count Receives the number of runs.
+ * @return 0 if the conversion succeeded, or 1 if memory allocation failed or the input is invalid.
+ */
+int rois_to_runs(const roi *rois, size_t roi_count, size_t width, size_t height,
+                 pixel_run **runs, size_t *count) {
+    // Check if the input rectangles are valid
+    if (rois == nullptr && roi_count > 0) {
+        std::cout << "Invalid regions of interest\n";
+        return 1;
+    }
+
+    std::vector<pixel_run> all;
+    for (size_t r = 0; r < roi_count; r++) {
+        const roi &region = rois[r];
+        if (region.x >= width || region.y >= height) continue;
+
+        size_t end_x = region.width < width - region.x ? region.x + region.width : width;
+        size_t end_y = region.height < height - region.y ? region.y + region.height : height;
+        if (end_x == region.x) continue;
+
+        for (size_t i = region.y; i < end_y; i++) all.push_back({i, region.x, end_x});
+    }
+
+    std::sort(all.begin(), all.end(), [](const pixel_run &a, const pixel_run &b) {
+        return a.row != b.row ? a.row < b.row : a.begin < b.begin;
+    });
+
+    // merge the overlapping and touching runs of every row
+    size_t merged = 0;
+    for (const pixel_run &run: all) {
+        if (merged > 0 && all[merged - 1].row == run.row && run.begin <= all[merged - 1].end) {
+            all[merged - 1].end = std::max(all[merged - 1].end, run.end);
+        } else {
+            all[merged++] = run;
+        }
+    }
+
+    *runs = (pixel_run *) malloc((merged > 0 ? merged : 1) * sizeof(pixel_run));
+
+    // Check if the memory was allocated
+    if (*runs == nullptr) {
+        std::cout << "Failed to allocate memory for the runs!\n";
+        return 1;
+    }
+
+    std::copy(all.begin(), all.begin() + (long) merged, *runs);
+    *count = merged;
+    return 0;
+}
+
+/**
+ * Compacts a mask into the runs of its non zero pixels.
+ *
+ * Build the runs once and reuse them with detect_edges_runs for every frame that shares the mask.
+ *
+ * @param mask The mask (single channel, non zero pixels are selected).
+ * @param width The width of the mask in pixels.
+ * @param height The height of the mask in pixels.
+ * @param runs A pointer to a buffer that will hold the runs, sorted by row, then by column.
+ * @param count Receives the number of runs.
+ * @return 0 if the conversion succeeded, or 1 if memory allocation failed or the input is invalid.
+ */
+int mask_to_runs(const ubyte *mask, size_t width, size_t height,
+                 pixel_run **runs, size_t *count) {
+    // Check if the input mask is valid
+    if (mask == nullptr) {
+        std::cout << "Invalid input mask\n";
+        return 1;
+    }
+
+    std::vector<pixel_run> all;
+    for (size_t i = 0; i < height; i++) {
+        const ubyte *row = mask + i * width;
+        for (size_t j = 0; j < width;) {
+            while (j < width && row[j] == 0) j++;
+            size_t begin = j;
+            while (j < width && row[j] != 0) j++;
+            if (j > begin) all.push_back({i, begin, j});
+        }
+    }
+
+    *runs = (pixel_run *) malloc((all.empty() ? 1 : all.size()) * sizeof(pixel_run));
+
+    // Check if the memory was allocated
+    if (*runs == nullptr) {
+        std::cout << "Failed to allocate memory for the runs!\n";
+        return 1;
+    }
+
+    std::copy(all.begin(), all.end(), *runs);
+    *count = all.size();
+    return 0;
+}
+
+/**
+ * Recomputes the Sobel edges of the given runs of pixels in an existing edge image
+ *
+ * The gradients of a run read their neighbors from the full image, so the result inside the runs is
+ * identical to detect_edges, and the pixels outside of the runs are left untouched. The runs are split
+ * into bands that are processed in parallel, so they must not overlap.
+ *
+ * @param image input image
+ * @param edges_detected_image edge image to update (width * height pixels)
+ * @param width width of input image
+ * @param height height of input image
+ * @param runs runs of pixels to compute (from rois_to_runs or mask_to_runs)
+ * @param count number of runs
+ * @param threshold threshold to apply
+ * @param strength_ratio ratio used to strengthen or weaken the edges
+ * @return 1 if any error occurs
+ */
+int update_edges_runs(const ubyte *image, ubyte *edges_detected_image, size_t width, size_t height,
+                      const pixel_run *runs, size_t count,
+                      ubyte threshold,
+                      double strength_ratio) {
+    // Check if the input image and runs are valid
+    if (image == nullptr || edges_detected_image == nullptr || (runs == nullptr && count > 0)) {
+        std::cout << "Invalid input image or runs\n";
+        return 1;
+    }
+
+    ubyte table[SOBEL_MAGNITUDE_LEVELS];
+    build_edge_strength_table(threshold, strength_ratio, table);
+
+    parallel_for(0, count, [&](size_t run_begin, size_t run_end, size_t) {
+        std::vector<int16> gx(width), gy(width);
+        std::vector<unsigned short> magnitudes(width);
+
+        for (size_t r = run_begin; r < run_end; r++) {
+            size_t i = runs[r].row;
+            size_t begin = runs[r].begin, end = runs[r].end < width ? runs[r].end : width;
+            if (i >= height || begin >= end) continue;
+
+            // the gradients of the run with its neighbor columns, which are only used as input
+            size_t span_begin = begin > 0 ? begin - 1 : 0;
+            size_t span_end = end < width ? end + 1 : width;
+            const ubyte *above = i > 0 ? image + (i - 1) * width + span_begin : nullptr;
+            const ubyte *below = i + 1 < height ? image + (i + 1) * width + span_begin : nullptr;
+            sobel_gradient_row(above, image + i * width + span_begin, below,
+                               gx.data(), gy.data(), span_end - span_begin);
+
+            size_t offset = begin - span_begin;
+            sobel_magnitude_row(gx.data() + offset, gy.data() + offset, magnitudes.data(), end - begin);
+
+            ubyte *output = edges_detected_image + i * width;
+            for (size_t j = begin; j < end; j++) output[j] = table[magnitudes[j - begin]];
+        }
+    }, MIN_BAND_RUNS);
+
+    return 0;
+}
+
+/**
+ * Detect Edges by using Sobel Operation only on the given runs of pixels
+ *
+ * The output has the size of the image and is zero outside of the runs. It is allocated with calloc,
+ * so the pages that no run touches are never written, and the cost is proportional to the number of
+ * pixels in the runs. Inside the runs the result is identical to detect_edges.
+ *
+ * @param image input image
+ * @param edges_detected_image output image
+ * @param width width of input image
+ * @param height height of input image
+ * @param runs runs of pixels to compute (from rois_to_runs or mask_to_runs), they must not overlap
+ * @param count number of runs
+ * @param threshold threshold to apply
+ * @param strength_ratio ratio used to strengthen or weaken the edges
+ * @return 1 if any error occurs
+ */
+int detect_edges_runs(const ubyte *image, ubyte **edges_detected_image, size_t width, size_t height,
+                      const pixel_run *runs, size_t count,
+                      ubyte threshold,
+                      double strength_ratio) {
+    *edges_detected_image = (ubyte *) calloc(width * height, sizeof(ubyte));
+
+    // check if the memory was allocated
+    if (*edges_detected_image == nullptr) {
+        std::cout << "Failed to allocate memory for the edge detected image!\n";
+        return 1;
+    }
+
+    if (update_edges_runs(image, *edges_detected_image, width, height, runs, count, threshold, strength_ratio) != 0) {
+        free(*edges_detected_image);
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * Detect Edges by using Sobel Operation only inside rectangular regions of interest
+ *
+ * @param image input image
+ * @param edges_detected_image output image, zero outside of the regions
+ * @param width width of input image
+ * @param height height of input image
+ * @param rois regions of interest, clipped to the image (they may overlap)
+ * @param roi_count number of regions
+ * @param threshold threshold to apply
+ * @param strength_ratio ratio used to strengthen or weaken the edges
+ * @return 1 if any error occurs
+ */
+int detect_edges_roi(const ubyte *image, ubyte **edges_detected_image, size_t width, size_t height,
+                     const roi *rois, size_t roi_count,
+                     ubyte threshold,
+                     double strength_ratio) {
+    pixel_run *runs;
+    size_t count;
+    if (rois_to_runs(rois, roi_count, width, height, &runs, &count) != 0) return 1;
+
+    int state = detect_edges_runs(image, edges_detected_image, width, height, runs, count, threshold, strength_ratio);
+    free(runs);
+    return state;
+}
+
+/**
+ * Detect Edges by using Sobel Operation only on the non zero pixels of a mask
+ *
+ * @param image input image
+ * @param edges_detected_image output image, zero outside of the mask
+ * @param width width of input image and mask
+ * @param height height of input image and mask
+ * @param mask mask (single channel, non zero pixels are computed)
+ * @param threshold threshold to apply
+ * @param strength_ratio ratio used to strengthen or weaken the edges
+ * @return 1 if any error occurs
+ */
+int detect_edges_masked(const ubyte *image, ubyte **edges_detected_image, size_t width, size_t height,
+                        const ubyte *mask,
+                        ubyte threshold,
+                        double strength_ratio) {
+    pixel_run *runs;
+    size_t count;
+    if (mask_to_runs(mask, width, height, &runs, &count) != 0) return 1;
+
+    int state = detect_edges_runs(image, edges_detected_image, width, height, runs, count, threshold, strength_ratio);
+    free(runs);
+    return state;
+}
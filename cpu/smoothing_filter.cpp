@@ -0,0 +1,417 @@
+#include <iostream>
+#include <vector>
+#include <cstring>
+#include "../filters/smoothing_filter.h"
+#include "../filters/sobel_filter.h"
+#include "../filters/parallel.h"
+
+
+// up to this sigma a sampled Gaussian is used, above it a cascade of box filters
+#define GAUSSIAN_MAX_SIGMA 2.0
+
+// number of box filters in the cascade approximating a large Gaussian
+#define BOX_PASSES 3
+
+// fixed point precision of the Gaussian weights
+#define WEIGHT_BITS 14
+
+// fixed point precision of the intermediate rows (8.8)
+#define FRACTION_BITS 8
+
+// shifts from the Q14 sums back to 8.8 fixed point and from 8.8 fixed point back to a byte
+#define VERTICAL_SHIFT (WEIGHT_BITS - FRACTION_BITS)
+#define VERTICAL_ROUNDING (1 << (VERTICAL_SHIFT - 1))
+#define HORIZONTAL_SHIFT (WEIGHT_BITS + FRACTION_BITS)
+#define HORIZONTAL_ROUNDING (1 << (HORIZONTAL_SHIFT - 1))
+
+// minimum number of rows per band, smaller bands are not worth a thread
+#define MIN_BAND_ROWS 16
+
+// minimum number of columns per strip of the vertical box passes (one cache line of 8.8 values)
+#define MIN_STRIP_COLUMNS 32
+
+
+/**
+ * Describes how a sigma is smoothed: either by a sampled Gaussian kernel or by a cascade of box filters.
+ */
+struct smoothing_plan {
+    bool gaussian;
+    long radius;                    // radius of the Gaussian kernel
+    std::vector<int> weights;       // Gaussian weights (2 * radius + 1), summing to 1 << WEIGHT_BITS
+    long box_radius[BOX_PASSES];    // radius of every box filter of the cascade
+};
+
+static smoothing_plan make_plan(double sigma);
+
+static void smooth_rows(const ubyte *image, size_t width, size_t height,
+                        const smoothing_plan &plan,
+                        size_t row_begin, size_t row_end,
+                        ubyte *output);
+
+static void box_blur(const ubyte *image, size_t width, size_t height,
+                     const smoothing_plan &plan,
+                     ubyte *output);
+
+static inline long clamp_index(long index, long size) {
+    return index < 0 ? 0 : (index >= size ? size - 1 : index);
+}
+
+
+/**
+ * Smooths an image with a Gaussian.
+ *
+ * Small sigmas use a separable sampled Gaussian, computed in parallel row bands. Larger sigmas use a
+ * cascade of three box filters computed with running sums: the horizontal passes run over row bands
+ * and the vertical passes over column strips, so no band recomputes a halo and the cost does not
+ * depend on sigma. Pixels outside the image are replaced by the nearest border pixel.
+ *
+ * @param image A pointer to the input image data (single channel).
+ * @param blurred_image A pointer to a buffer that will hold the resulting image data.
+ * @param width The width of the image in pixels.
+ * @param height The height of the image in pixels.
+ * @param sigma The standard deviation of the Gaussian, the image is copied if it is not positive.
+ * @return 0 if the smoothing succeeded, or 1 if memory allocation failed or the input image is invalid.
+ */
+int gaussian_blur(const ubyte *image, ubyte **blurred_image, size_t width, size_t height,
+                  double sigma) {
+    // Check if the input image is valid
+    if (image == nullptr) {
+        std::cout << "Invalid input image\n";
+        return 1;
+    }
+
+    // Allocate memory for the blurred image
+    *blurred_image = (ubyte *) malloc(width * height * sizeof(ubyte));
+
+    // Check if the memory was allocated
+    if (*blurred_image == nullptr) {
+        std::cout << "Failed to allocate memory for the blurred image!\n";
+        return 1;
+    }
+
+    if (sigma <= 0) {
+        memcpy(*blurred_image, image, width * height * sizeof(ubyte));
+        return 0;
+    }
+
+    smoothing_plan plan = make_plan(sigma);
+    if (!plan.gaussian) {
+        box_blur(image, width, height, plan, *blurred_image);
+        return 0;
+    }
+
+    parallel_for(0, height, [&](size_t row_begin, size_t row_end, size_t) {
+        smooth_rows(image, width, height, plan, row_begin, row_end, *blurred_image + row_begin * width);
+    }, MIN_BAND_ROWS);
+
+    return 0;
+}
+
+/**
+ * Detect Edges by using Sobel Operation on a Gaussian smoothed image
+ *
+ * For small sigmas the smoothing is fused in front of the Sobel pass: every band smooths only its own
+ * rows plus one row above and below into a band buffer, and the Sobel rows are computed from that
+ * buffer, so the smoothed frame is never stored. The box cascade of larger sigmas would need a halo of
+ * about 3 sigma rows per band, so it smooths the whole frame first instead. The result is the same as
+ * detect_edges on the output of gaussian_blur.
+ *
+ * @param image input image
+ * @param edges_detected_image output image
+ * @param width width of input image
+ * @param height height of input image
+ * @param sigma standard deviation of the Gaussian, no smoothing if it is not positive
+ * @param threshold threshold to apply
+ * @param strength_ratio ratio used to strengthen or weaken the edges
+ * @return 1 if any error occurs
+ */
+int detect_edges_smoothed(const ubyte *image, ubyte **edges_detected_image, size_t width, size_t height,
+                          double sigma,
+                          ubyte threshold,
+                          double strength_ratio) {
+    // Check if the input image is valid
+    if (image == nullptr) {
+        std::cout << "Invalid input image\n";
+        return 1;
+    }
+
+    *edges_detected_image = (ubyte *) malloc(width * height * sizeof(ubyte));
+
+    // check if the memory was allocated
+    if (*edges_detected_image == nullptr) {
+        std::cout << "Failed to allocate memory for the edge detected image!\n";
+        return 1;
+    }
+
+    ubyte table[SOBEL_MAGNITUDE_LEVELS];
+    build_edge_strength_table(threshold, strength_ratio, table);
+
+    smoothing_plan plan = sigma > 0 ? make_plan(sigma) : smoothing_plan{};
+
+    // the rows the Sobel pass reads when they are not smoothed per band
+    std::vector<ubyte> box_smoothed;
+    const ubyte *frame = nullptr;
+    if (sigma <= 0) {
+        frame = image;
+    } else if (!plan.gaussian) {
+        box_smoothed.resize(width * height);
+        box_blur(image, width, height, plan, box_smoothed.data());
+        frame = box_smoothed.data();
+    }
+
+    parallel_for(0, height, [&](size_t row_begin, size_t row_end, size_t) {
+        std::vector<ubyte> smoothed;
+        const ubyte *rows = frame;
+        size_t rows_begin = 0;
+
+        if (rows == nullptr) {
+            // smoothed rows of the band with a one row halo
+            size_t halo_begin = row_begin > 0 ? row_begin - 1 : 0;
+            size_t halo_end = row_end < height ? row_end + 1 : height;
+
+            smoothed.resize((halo_end - halo_begin) * width);
+            smooth_rows(image, width, height, plan, halo_begin, halo_end, smoothed.data());
+            rows = smoothed.data();
+            rows_begin = halo_begin;
+        }
+
+        std::vector<int16> gx(width), gy(width);
+        std::vector<unsigned short> magnitudes(width);
+
+        for (size_t i = row_begin; i < row_end; i++) {
+            const ubyte *row = rows + (i - rows_begin) * width;
+            const ubyte *above = i > 0 ? row - width : nullptr;
+            const ubyte *below = i + 1 < height ? row + width : nullptr;
+
+            sobel_gradient_row(above, row, below, gx.data(), gy.data(), width);
+            sobel_magnitude_row(gx.data(), gy.data(), magnitudes.data(), width);
+
+            ubyte *output = *edges_detected_image + i * width;
+            for (size_t j = 0; j < width; j++) output[j] = table[magnitudes[j]];
+        }
+    }, MIN_BAND_ROWS);
+
+    return 0;
+}
+
+/**
+ * Chooses the smoothing method for a sigma.
+ *
+ * For the box cascade, the widths follow "Fast Almost-Gaussian Filtering" (Kovesi): the passes use
+ * the two odd widths around the ideal width, mixed so that the variance of the cascade matches sigma.
+ *
+ * @param sigma The standard deviation of the Gaussian.
+ * @return The smoothing plan.
+ */
+static smoothing_plan make_plan(double sigma) {
+    smoothing_plan plan{};
+
+    if (sigma <= GAUSSIAN_MAX_SIGMA) {
+        plan.gaussian = true;
+        plan.radius = (long) ceil(3 * sigma);
+
+        std::vector<double> kernel(2 * plan.radius + 1);
+        double sum = 0;
+        for (long k = -plan.radius; k <= plan.radius; k++) {
+            kernel[k + plan.radius] = exp(-(double) (k * k) / (2 * sigma * sigma));
+            sum += kernel[k + plan.radius];
+        }
+
+        // quantize the weights and give the rounding error to the center so that they sum to one
+        int total = 0;
+        plan.weights.resize(kernel.size());
+        for (size_t k = 0; k < kernel.size(); k++) {
+            plan.weights[k] = (int) lround(kernel[k] / sum * (1 << WEIGHT_BITS));
+            total += plan.weights[k];
+        }
+        plan.weights[plan.radius] += (1 << WEIGHT_BITS) - total;
+    } else {
+        plan.gaussian = false;
+
+        double ideal = sqrt(12 * sigma * sigma / BOX_PASSES + 1);
+        long lower = (long) floor(ideal);
+        if (lower % 2 == 0) lower--;
+        long upper = lower + 2;
+
+        double lower_passes = (12 * sigma * sigma - BOX_PASSES * lower * lower - 4.0 * BOX_PASSES * lower -
+                               3.0 * BOX_PASSES) / (-4.0 * lower - 4);
+        long m = lround(lower_passes);
+
+        for (long pass = 0; pass < BOX_PASSES; pass++)
+            plan.box_radius[pass] = ((pass < m ? lower : upper) - 1) / 2;
+    }
+
+    return plan;
+}
+
+/**
+ * Box filters a row of 8.8 fixed point values with a running sum.
+ *
+ * @param input The input row.
+ * @param output The output row.
+ * @param padded A scratch buffer of at least width + 2 * radius elements.
+ * @param width The number of pixels in the row.
+ * @param radius The radius of the box.
+ */
+static void box_row(const unsigned short *input, unsigned short *output, unsigned short *padded,
+                    size_t width, long radius) {
+    // replicate the border so that the running sum does not need to clamp
+    for (long j = -radius; j < (long) width + radius; j++)
+        padded[j + radius] = input[clamp_index(j, (long) width)];
+
+    float scale = 1.0f / (float) (2 * radius + 1);
+    unsigned int sum = 0;
+    for (long k = 0; k < 2 * radius; k++) sum += padded[k];
+
+    for (size_t j = 0; j < width; j++) {
+        sum += padded[j + 2 * radius];
+        output[j] = (unsigned short) ((float) sum * scale + 0.5f);
+        sum -= padded[j];
+    }
+}
+
+/**
+ * Box filters the columns [column_begin, column_end) of an image of 8.8 fixed point values with
+ * running sums down the columns.
+ *
+ * @param input The input image.
+ * @param output The output image, only the given columns are written.
+ * @param column_begin The first column to filter.
+ * @param column_end One past the last column to filter.
+ * @param width The number of pixels in a row.
+ * @param height The number of rows in the image.
+ * @param radius The radius of the box.
+ */
+static void box_columns(const unsigned short *input, unsigned short *output,
+                        size_t column_begin, size_t column_end,
+                        size_t width, size_t height, long radius) {
+    size_t columns = column_end - column_begin;
+    std::vector<unsigned int> sum(columns, 0);
+    float scale = 1.0f / (float) (2 * radius + 1);
+
+    auto input_row = [&](long row) {
+        return input + clamp_index(row, (long) height) * width + column_begin;
+    };
+
+    for (long k = -radius; k <= radius; k++) {
+        const unsigned short *row = input_row(k);
+        for (size_t j = 0; j < columns; j++) sum[j] += row[j];
+    }
+
+    for (size_t i = 0; i < height; i++) {
+        unsigned short *out = output + i * width + column_begin;
+        for (size_t j = 0; j < columns; j++) out[j] = (unsigned short) ((float) sum[j] * scale + 0.5f);
+
+        // slide the window down by one row
+        const unsigned short *entering = input_row((long) i + radius + 1);
+        const unsigned short *leaving = input_row((long) i - radius);
+        for (size_t j = 0; j < columns; j++) sum[j] += entering[j] - leaving[j];
+    }
+}
+
+/**
+ * Smooths a whole image with the box cascade of a plan.
+ *
+ * The horizontal passes run over row bands and the vertical passes over column strips. Neither needs
+ * rows or columns of another band, so the work does not grow with the radii or the number of bands.
+ *
+ * @param image The input image.
+ * @param width The width of the image in pixels.
+ * @param height The height of the image in pixels.
+ * @param plan The smoothing plan, a box cascade.
+ * @param output The smoothed image (width * height elements).
+ */
+static void box_blur(const ubyte *image, size_t width, size_t height,
+                     const smoothing_plan &plan,
+                     ubyte *output) {
+    long max_radius = 0;
+    for (long radius: plan.box_radius) max_radius = radius > max_radius ? radius : max_radius;
+
+    std::vector<unsigned short> rows(width * height), other(width * height);
+
+    // horizontal passes
+    parallel_for(0, height, [&](size_t row_begin, size_t row_end, size_t) {
+        std::vector<unsigned short> line(width), padded(width + 2 * max_radius);
+
+        for (size_t i = row_begin; i < row_end; i++) {
+            const ubyte *in = image + i * width;
+            unsigned short *row = rows.data() + i * width;
+            for (size_t j = 0; j < width; j++) row[j] = (unsigned short) (in[j] << FRACTION_BITS);
+
+            for (long radius: plan.box_radius) {
+                box_row(row, line.data(), padded.data(), width, radius);
+                std::copy(line.begin(), line.end(), row);
+            }
+        }
+    }, MIN_BAND_ROWS);
+
+    // vertical passes, ping-ponging between the two frames, then rounded back to bytes
+    parallel_for(0, width, [&](size_t column_begin, size_t column_end, size_t) {
+        unsigned short *source = rows.data(), *target = other.data();
+        for (long radius: plan.box_radius) {
+            box_columns(source, target, column_begin, column_end, width, height, radius);
+            std::swap(source, target);
+        }
+
+        for (size_t i = 0; i < height; i++) {
+            const unsigned short *row = source + i * width;
+            ubyte *out = output + i * width;
+            for (size_t j = column_begin; j < column_end; j++)
+                out[j] = (ubyte) ((row[j] + (1 << (FRACTION_BITS - 1))) >> FRACTION_BITS);
+        }
+    }, MIN_STRIP_COLUMNS);
+}
+
+/**
+ * Smooths the rows [row_begin, row_end) of an image with the sampled Gaussian of a plan.
+ *
+ * Only the input rows the requested rows depend on are read, so the result of a row does not
+ * depend on how the image is split into bands.
+ *
+ * @param image The input image.
+ * @param width The width of the image in pixels.
+ * @param height The height of the image in pixels.
+ * @param plan The smoothing plan, a sampled Gaussian.
+ * @param row_begin The first row to smooth.
+ * @param row_end One past the last row to smooth.
+ * @param output The smoothed rows ((row_end - row_begin) * width elements).
+ */
+static void smooth_rows(const ubyte *image, size_t width, size_t height,
+                        const smoothing_plan &plan,
+                        size_t row_begin, size_t row_end,
+                        ubyte *output) {
+    long radius = plan.radius;
+    const int *weights = plan.weights.data();
+
+    std::vector<int> sum(width);
+    std::vector<unsigned short> vertical(width + 2 * radius);
+
+    for (size_t i = row_begin; i < row_end; i++) {
+        // vertical pass, weights in Q14, the result is kept in 8.8 fixed point
+        std::fill(sum.begin(), sum.end(), 0);
+        for (long k = -radius; k <= radius; k++) {
+            const ubyte *row = image + clamp_index((long) i + k, (long) height) * width;
+            int weight = weights[k + radius];
+            for (size_t j = 0; j < width; j++) sum[j] += weight * row[j];
+        }
+
+        unsigned short *center = vertical.data() + radius;
+        for (size_t j = 0; j < width; j++)
+            center[j] = (unsigned short) ((sum[j] + VERTICAL_ROUNDING) >> VERTICAL_SHIFT);
+        for (long k = 1; k <= radius; k++) {
+            center[-k] = center[0];
+            center[width - 1 + k] = center[width - 1];
+        }
+
+        // horizontal pass, rounded back to a byte
+        std::fill(sum.begin(), sum.end(), 0);
+        for (long k = -radius; k <= radius; k++) {
+            const unsigned short *shifted = center + k;
+            int weight = weights[k + radius];
+            for (size_t j = 0; j < width; j++) sum[j] += weight * shifted[j];
+        }
+
+        ubyte *out = output + (i - row_begin) * width;
+        for (size_t j = 0; j < width; j++) out[j] = (ubyte) ((sum[j] + HORIZONTAL_ROUNDING) >> HORIZONTAL_SHIFT);
+    }
+}
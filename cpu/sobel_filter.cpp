@@ -1,9 +1,15 @@
 #include <iostream>
+#include <vector>
+#include <algorithm>
 #include "../filters/sobel_filter.h"
+#include "../filters/parallel.h"
 
 
-#define KERNEL_WIDTH 3
-#define KERNEL_HEIGHT 3
+// size of the square tiles detect_edges_skip_flat checks for flat regions
+#define FLAT_TILE_SIZE 32
+
+// minimum number of rows per band, smaller bands are not worth a thread
+#define MIN_BAND_ROWS 16
 
 static ubyte strength_edge(long long value,
                            ubyte threshold,
@@ -12,77 +18,275 @@ static ubyte strength_edge(long long value,
 static ubyte clip_to_ubyte(long long val);
 
 
-static void extract_kernel(const ubyte *input,
-                           ubyte *output,
-                           size_t height, size_t width,
-                           size_t kernel_height, size_t kernel_width,
-                           size_t i_index, size_t j_index);
+/**
+ * Computes the signed Sobel gradients of a row of any pixel type, the same way sobel_gradient_row
+ * does for 8 bit pixels, in the arithmetic type of the pixels.
+ *
+ * The rows may have interleaved channels, whose gradients are computed independently in the same loop
+ * over the whole row: the horizontal neighbors of a value are Channels values away, and gx and gy have
+ * width * Channels interleaved elements.
+ */
+template<typename Pixel, size_t Channels = 1>
+static void gradient_row(const Pixel *above, const Pixel *row, const Pixel *below,
+                         typename pixel_traits<Pixel>::arithmetic *gx, typename pixel_traits<Pixel>::arithmetic *gy,
+                         size_t width) {
+    typedef typename pixel_traits<Pixel>::arithmetic arithmetic;
+    size_t size = width * Channels;
+
+    static thread_local std::vector<Pixel> zero_row;
+    if (above == nullptr || below == nullptr) {
+        if (zero_row.size() < size) zero_row.assign(size, (Pixel) 0);
+        if (above == nullptr) above = zero_row.data();
+        if (below == nullptr) below = zero_row.data();
+    }
+
+    auto column = [&](size_t j) {
+        return (arithmetic) above[j] + 2 * (arithmetic) row[j] + (arithmetic) below[j];
+    };
+    auto difference = [&](size_t j) {
+        return (arithmetic) below[j] - (arithmetic) above[j];
+    };
+
+    if (width == 1) {
+        for (size_t c = 0; c < Channels; c++) {
+            gx[c] = 0;
+            gy[c] = 2 * difference(c);
+        }
+        return;
+    }
+
+    // left border (column -1 is zero)
+    for (size_t c = 0; c < Channels; c++) {
+        gx[c] = column(c + Channels);
+        gy[c] = 2 * difference(c) + difference(c + Channels);
+    }
+
+    // interior, without branches so that the compiler vectorizes it for every pixel type
+    for (size_t j = Channels; j + Channels < size; j++) {
+        gx[j] = column(j + Channels) - column(j - Channels);
+        gy[j] = difference(j - Channels) + 2 * difference(j) + difference(j + Channels);
+    }
+
+    // right border (column width is zero)
+    for (size_t c = 0; c < Channels; c++) {
+        size_t last = size - Channels + c;
+        gx[last] = -column(last - Channels);
+        gy[last] = difference(last - Channels) + 2 * difference(last);
+    }
+}
 
+/**
+ * Returns the absolute value of a gradient, clipped to the range of the pixel type.
+ */
+template<typename Pixel, typename Arithmetic>
+static inline Pixel clip_gradient(Arithmetic gradient) {
+    return to_pixel<Pixel>(gradient < 0 ? -gradient : gradient);
+}
 
 /**
- * Applies a 2D convolution to an input image using
+ * Returns a gradient with its absolute value clipped to the range of the pixel type.
+ */
+template<typename Pixel, typename Arithmetic>
+static inline typename pixel_traits<Pixel>::real clip_signed_gradient(Arithmetic gradient) {
+    typedef typename pixel_traits<Pixel>::real real;
+
+    real clipped = clip_gradient<Pixel>(gradient);
+    return gradient < 0 ? -clipped : clipped;
+}
+
+/**
+ * Computes the edge strength of a pixel from its squared gradient magnitude: the magnitude is
+ * truncated for integer pixels, then strengthened above the threshold and weakened below it.
+ */
+template<typename Pixel>
+static inline Pixel squared_edge_strength(typename pixel_traits<Pixel>::real squared, double threshold,
+                                          double strength_ratio) {
+    typedef typename pixel_traits<Pixel>::real real;
+
+    real magnitude = std::sqrt(squared);
+    if (pixel_traits<Pixel>::integer) magnitude = (real) (long long) magnitude;
+
+    real ratio = (real) (magnitude > (real) threshold ? 1 + strength_ratio : 1 - strength_ratio);
+    return to_pixel<Pixel>(magnitude * ratio);
+}
+
+/**
+ * Computes the edge strength of a pixel from its gradients: both gradients are clipped to the range of
+ * the pixel type and combined with hypot, truncated for integer pixels, then strengthened above the
+ * threshold and weakened below it.
+ */
+template<typename Pixel, typename Arithmetic>
+static inline Pixel edge_strength(Arithmetic gx, Arithmetic gy, double threshold, double strength_ratio) {
+    typedef typename pixel_traits<Pixel>::real real;
+
+    real x = clip_gradient<Pixel>(gx), y = clip_gradient<Pixel>(gy);
+    return squared_edge_strength<Pixel>(x * x + y * y, threshold, strength_ratio);
+}
+
+/**
+ * Computes the edge strengths of a row from the interleaved gradients of its channels. The alpha
+ * channel of 2 and 4 channel images is ignored, so gray images are combined from 1 channel and color
+ * images from 3. Every gradient is clipped like for detect_edges.
  *
- * @param n_row number of kernel rows
- * @param n_col number of kernel cols
- * @param input input array
- * @param kernel kernel array
- * @param output result of convolution
+ * COLOR_EDGES_MAX_CHANNEL keeps the channel with the largest magnitude. COLOR_EDGES_DI_ZENZO sums
+ * the structure tensors [gx^2, gx gy; gx gy, gy^2] of the channels and takes its largest eigenvalue,
+ * the squared rate of change of the color in its steepest direction, averaged over the channels.
+ * Both give the result of detect_edges for an image whose channels are the same.
  */
-static void convolve_2d(size_t n_row, size_t n_col,
-                        const ubyte *input,
-                        const byte *kernel,
-                        ubyte *output) {
-    long long temp = 0;
+template<size_t Channels, color_edge_mode Mode, typename Arithmetic>
+static void color_edge_strength_row(const Arithmetic *gx, const Arithmetic *gy, ubyte *output, size_t width,
+                                    double threshold,
+                                    double strength_ratio) {
+    constexpr size_t colors = Channels >= 3 ? 3 : 1;
+
+    for (size_t j = 0; j < width; j++) {
+        const Arithmetic *x = gx + j * Channels, *y = gy + j * Channels;
+        double squared;
+
+        if (Mode == COLOR_EDGES_MAX_CHANNEL) {
+            squared = 0;
+            for (size_t c = 0; c < colors; c++) {
+                double cx = clip_signed_gradient<ubyte>(x[c]), cy = clip_signed_gradient<ubyte>(y[c]);
+                double channel = cx * cx + cy * cy;
+                squared = channel > squared ? channel : squared;
+            }
+        } else {
+            double xx = 0, yy = 0, xy = 0;
+            for (size_t c = 0; c < colors; c++) {
+                double cx = clip_signed_gradient<ubyte>(x[c]), cy = clip_signed_gradient<ubyte>(y[c]);
+                xx += cx * cx;
+                yy += cy * cy;
+                xy += cx * cy;
+            }
+            double eigenvalue = (xx + yy + std::sqrt((xx - yy) * (xx - yy) + 4 * xy * xy)) / 2;
+            squared = eigenvalue / colors;
+        }
 
-    // error checks
-    assert(n_row * n_col < ULONG_LONG_MAX && "The kernel size is not supported !");
+        output[j] = squared_edge_strength<ubyte>(squared, threshold, strength_ratio);
+    }
+}
 
-    for (size_t i = 0; i < n_row * n_col; i++) {
-        temp += kernel[i] * input[i];
+/**
+ * Detects the color edges of a band of rows, for a compile time number of channels and mode.
+ */
+template<size_t Channels, color_edge_mode Mode>
+static void color_edges_band(const ubyte *image, ubyte *edges_detected_image, size_t width, size_t height,
+                             size_t row_begin, size_t row_end,
+                             double threshold,
+                             double strength_ratio) {
+    typedef typename pixel_traits<ubyte>::arithmetic arithmetic;
+    size_t row_size = width * Channels;
+    std::vector<arithmetic> gx(row_size), gy(row_size);
+
+    for (size_t i = row_begin; i < row_end; i++) {
+        gradient_row<ubyte, Channels>(i > 0 ? image + (i - 1) * row_size : nullptr,
+                                      image + i * row_size,
+                                      i + 1 < height ? image + (i + 1) * row_size : nullptr,
+                                      gx.data(), gy.data(), width);
+        color_edge_strength_row<Channels, Mode>(gx.data(), gy.data(), edges_detected_image + i * width, width,
+                                                threshold, strength_ratio);
     }
+}
 
-    *output = clip_to_ubyte(temp);
+template<size_t Channels>
+static void color_edges_band(const ubyte *image, ubyte *edges_detected_image, size_t width, size_t height,
+                             size_t row_begin, size_t row_end,
+                             color_edge_mode mode,
+                             double threshold,
+                             double strength_ratio) {
+    if (mode == COLOR_EDGES_MAX_CHANNEL)
+        color_edges_band<Channels, COLOR_EDGES_MAX_CHANNEL>(image, edges_detected_image, width, height,
+                                                            row_begin, row_end, threshold, strength_ratio);
+    else
+        color_edges_band<Channels, COLOR_EDGES_DI_ZENZO>(image, edges_detected_image, width, height,
+                                                         row_begin, row_end, threshold, strength_ratio);
 }
 
+
 /**
- * Applies Sobel Operation for detecting the edges
+ * Detect Edge by using Sobel Operation 
+ *
+ * The image is processed row by row from the separable form of the kernels, in bands of rows that run
+ * in parallel. Pixels outside the image are zero. The gradients are computed in the arithmetic type of
+ * the pixels, so 16 bit and float images keep their precision, and the result has the pixel type of
+ * the image: integer results are truncated and clipped to the range of the pixel type.
  *
- * @param n_row number of kernel rows
- * @param n_col number of kernel cols
- * @param img_sec image section
- * @param output color of pixel
- * @param Gx x dir Filter
- * @param Gy y dir Filter
- * @param apply_threshold if ture, use threshold to weaken or strengthen the edge
- * @param threshold threshold value
+ * @param image input image
+ * @param edges_detected_image output image
+ * @param width width of input image
+ * @param height width of output image
+ * @param threshold threshold to apply, in the units of the pixel type
+ * @param dir direction of edge detection 
+ * ( 0 : only vertical edges , 1 : only horizontal edges, 2: horizontal and vertical edges)
+ * @return 1 if any error occurs
  */
-static void sobel(size_t n_row, size_t n_col,
-                  ubyte *img_sec, ubyte *output,
-                  byte *Gx, byte *Gy,
-                  bool apply_threshold,
-                  unsigned char threshold,
-                  double strength_ratio) {
+template<typename Pixel>
+int detect_edges(const Pixel *image,
+                 Pixel **edges_detected_image,
+                 size_t width, size_t height,
+                 double threshold,
+                 double strength_ratio,
+                 short dir) {
+    typedef typename pixel_traits<Pixel>::arithmetic arithmetic;
 
-    ubyte x, y;
-    long long temp;
-    convolve_2d(n_row, n_col, img_sec, Gx, &x);
-    convolve_2d(n_row, n_col, img_sec, Gy, &y);
+    // Check if the input image and channels are valid
+    if (image == nullptr) {
+        std::cout << "Invalid input image\n";
+        return 1;
+    }
+
+    *edges_detected_image = (Pixel *) malloc(width * height * sizeof(Pixel));
+
+    // check if the memory was allocated
+    if (*edges_detected_image == nullptr) {
+        std::cout << "Failed to allocate memory for the edge detected image!\n";
+        return 1;
+    }
 
+    parallel_for(0, height, [&](size_t row_begin, size_t row_end, size_t) {
+        std::vector<arithmetic> gx(width), gy(width);
 
-    temp = (long long) hypot(x, y);
+        for (size_t i = row_begin; i < row_end; i++) {
+            gradient_row(i > 0 ? image + (i - 1) * width : nullptr,
+                         image + i * width,
+                         i + 1 < height ? image + (i + 1) * width : nullptr,
+                         gx.data(), gy.data(), width);
 
-    if (apply_threshold) *output = strength_edge(temp, threshold, strength_ratio);
-    else *output = clip_to_ubyte(temp);
+            Pixel *output = *edges_detected_image + i * width;
+            switch (dir) {
+                case 0:
+                    for (size_t j = 0; j < width; j++) output[j] = clip_gradient<Pixel>(gx[j]);
+                    break;
+                case 1:
+                    for (size_t j = 0; j < width; j++) output[j] = clip_gradient<Pixel>(gy[j]);
+                    break;
+
+                case 2:
+                default:
+                    for (size_t j = 0; j < width; j++)
+                        output[j] = edge_strength<Pixel>(gx[j], gy[j], threshold, strength_ratio);
+            }
+        }
+    }, MIN_BAND_ROWS);
+
+    return 0;
 }
 
+template int detect_edges<ubyte>(const ubyte *, ubyte **, size_t, size_t, double, double, short);
+
+template int detect_edges<uint16>(const uint16 *, uint16 **, size_t, size_t, double, double, short);
+
+template int detect_edges<float>(const float *, float **, size_t, size_t, double, double, short);
+
 /**
- * Detect Edge by using Sobel Operation 
+ * Detect Edge by using Sobel Operation on an 8 bit image (see the template above)
+ *
  * @param image input image
  * @param edges_detected_image output image
  * @param width width of input image
  * @param height width of output image
  * @param threshold threshold to apply
- * @param dir direction of edge detection 
+ * @param dir direction of edge detection
  * ( 0 : only vertical edges , 1 : only horizontal edges, 2: horizontal and vertical edges)
  * @return 1 if any error occurs
  */
@@ -92,21 +296,341 @@ int detect_edges(const ubyte *image,
                  ubyte threshold,
                  double strength_ratio,
                  short dir) {
+    return detect_edges<ubyte>(image, edges_detected_image, width, height, threshold, strength_ratio, dir);
+}
 
+/**
+ * Detect Edges by using Sobel Operation on the channels of a color image
+ *
+ * Converting to gray scale first loses the edges between colors of the same brightness. The Sobel
+ * gradients of all channels are instead computed in a single pass over the interleaved rows, in
+ * parallel bands like detect_edges, and combined per pixel by the channel with the largest magnitude
+ * or by the Di Zenzo structure tensor. The edge strength is then thresholded like for detect_edges.
+ *
+ * @param image input image (interleaved channels)
+ * @param edges_detected_image output image (single channel)
+ * @param width width of input image
+ * @param height height of input image
+ * @param channels number of channels of input image (1 to 4, the alpha channel of 2 and 4 channels is ignored)
+ * @param mode COLOR_EDGES_MAX_CHANNEL or COLOR_EDGES_DI_ZENZO
+ * @param threshold threshold to apply
+ * @param strength_ratio ratio used to strengthen or weaken the edges
+ * @return 1 if any error occurs
+ */
+int detect_edges_color(const ubyte *image, ubyte **edges_detected_image, size_t width, size_t height,
+                       size_t channels,
+                       color_edge_mode mode,
+                       ubyte threshold,
+                       double strength_ratio) {
     // Check if the input image and channels are valid
+    if (image == nullptr || channels == 0 || channels > 4) {
+        std::cout << "Invalid input image or number of channels\n";
+        return 1;
+    }
+
+    *edges_detected_image = (ubyte *) malloc(width * height * sizeof(ubyte));
+
+    // check if the memory was allocated
+    if (*edges_detected_image == nullptr) {
+        std::cout << "Failed to allocate memory for the edge detected image!\n";
+        return 1;
+    }
+
+    parallel_for(0, height, [&](size_t row_begin, size_t row_end, size_t) {
+        switch (channels) {
+            case 1:
+                color_edges_band<1>(image, *edges_detected_image, width, height, row_begin, row_end,
+                                    mode, threshold, strength_ratio);
+                break;
+            case 2:
+                color_edges_band<2>(image, *edges_detected_image, width, height, row_begin, row_end,
+                                    mode, threshold, strength_ratio);
+                break;
+            case 3:
+                color_edges_band<3>(image, *edges_detected_image, width, height, row_begin, row_end,
+                                    mode, threshold, strength_ratio);
+                break;
+            default:
+                color_edges_band<4>(image, *edges_detected_image, width, height, row_begin, row_end,
+                                    mode, threshold, strength_ratio);
+        }
+    }, MIN_BAND_ROWS);
+
+    return 0;
+}
+
+/**
+ * Computes the signed Sobel gradients of a single image row.
+ *
+ * The 3x3 Sobel kernels are separable, so the row is computed from the vertical [1, 2, 1] smoothing and
+ * the vertical difference of the three input rows, without extracting a kernel section per pixel.
+ * Pixels outside the image are treated as zero, the same way detect_edges pads the border.
+ *
+ * @param above The row above the current row, or nullptr if the current row is the first one.
+ * @param row The current row.
+ * @param below The row below the current row, or nullptr if the current row is the last one.
+ * @param gx Output buffer for the x dir gradient (width elements).
+ * @param gy Output buffer for the y dir gradient (width elements).
+ * @param width The number of pixels in a row.
+ */
+void sobel_gradient_row(const ubyte *above, const ubyte *row, const ubyte *below,
+                        int16 *gx, int16 *gy,
+                        size_t width) {
+    static thread_local std::vector<ubyte> zero_row;
+    if (above == nullptr || below == nullptr) {
+        if (zero_row.size() < width) zero_row.assign(width, 0);
+        if (above == nullptr) above = zero_row.data();
+        if (below == nullptr) below = zero_row.data();
+    }
+
+    if (width == 1) {
+        gx[0] = 0;
+        gy[0] = (int16) (2 * (below[0] - above[0]));
+        return;
+    }
+
+    // left border (column -1 is zero)
+    gx[0] = (int16) (above[1] + 2 * row[1] + below[1]);
+    gy[0] = (int16) (2 * (below[0] - above[0]) + (below[1] - above[1]));
+
+    // interior, written without branches so that the compiler can vectorize it
+    for (size_t j = 1; j + 1 < width; j++) {
+        int left = above[j - 1] + 2 * row[j - 1] + below[j - 1];
+        int right = above[j + 1] + 2 * row[j + 1] + below[j + 1];
+        gx[j] = (int16) (right - left);
+        gy[j] = (int16) ((below[j - 1] - above[j - 1]) + 2 * (below[j] - above[j]) + (below[j + 1] - above[j + 1]));
+    }
+
+    // right border (column width is zero)
+    size_t last = width - 1;
+    gx[last] = (int16) (-(above[last - 1] + 2 * row[last - 1] + below[last - 1]));
+    gy[last] = (int16) ((below[last - 1] - above[last - 1]) + 2 * (below[last] - above[last]));
+}
+
+/**
+ * Computes the signed Sobel gradients of a whole image.
+ *
+ * The rows are split into bands that are processed in parallel. The results are the exact
+ * (unclipped) responses of the Gx and Gy kernels used by detect_edges.
+ *
+ * @param image input image (single channel)
+ * @param gx output x dir gradient, allocated by this function
+ * @param gy output y dir gradient, allocated by this function
+ * @param width width of input image
+ * @param height height of input image
+ * @return 1 if any error occurs
+ */
+int compute_gradients(const ubyte *image, int16 **gx, int16 **gy, size_t width, size_t height) {
+    // Check if the input image is valid
+    if (image == nullptr) {
+        std::cout << "Invalid input image\n";
+        return 1;
+    }
+
+    *gx = (int16 *) malloc(width * height * sizeof(int16));
+    *gy = (int16 *) malloc(width * height * sizeof(int16));
+
+    // check if the memory was allocated
+    if (*gx == nullptr || *gy == nullptr) {
+        std::cout << "Failed to allocate memory for the gradients!\n";
+        free(*gx);
+        free(*gy);
+        return 1;
+    }
+
+    parallel_for(0, height, [&](size_t row_begin, size_t row_end, size_t) {
+        for (size_t i = row_begin; i < row_end; i++) {
+            const ubyte *above = i > 0 ? image + (i - 1) * width : nullptr;
+            const ubyte *below = i + 1 < height ? image + (i + 1) * width : nullptr;
+            sobel_gradient_row(above, image + i * width, below,
+                               *gx + i * width, *gy + i * width,
+                               width);
+        }
+    });
+
+    return 0;
+}
+
+/**
+ * Computes the Sobel magnitudes of a single row from its gradients.
+ *
+ * The magnitude is the one detect_edges thresholds: both gradients are clipped to a byte and
+ * combined with hypot, so it is in the range [0, SOBEL_MAGNITUDE_LEVELS).
+ *
+ * @param gx The x dir gradient of the row.
+ * @param gy The y dir gradient of the row.
+ * @param magnitudes Output buffer for the magnitudes (width elements).
+ * @param width The number of pixels in a row.
+ */
+void sobel_magnitude_row(const int16 *gx, const int16 *gy, unsigned short *magnitudes, size_t width) {
+    for (size_t j = 0; j < width; j++) {
+        int x = abs(gx[j]), y = abs(gy[j]);
+        x = x > UCHAR_MAX ? UCHAR_MAX : x;
+        y = y > UCHAR_MAX ? UCHAR_MAX : y;
+
+        // the sum of squares is exact in a float, so the truncated sqrt matches (long long) hypot
+        magnitudes[j] = (unsigned short) sqrtf((float) (x * x + y * y));
+    }
+}
+
+/**
+ * Computes the Sobel magnitudes of an image and, optionally, their histogram.
+ *
+ * The rows are split into bands that are processed in parallel. Every band builds its own
+ * histogram while the magnitudes are still in cache, and the histograms are summed at the end,
+ * so no second pass over the image is needed.
+ *
+ * @param image input image (single channel)
+ * @param magnitudes output magnitudes, allocated by this function
+ * @param width width of input image
+ * @param height height of input image
+ * @param histogram if not nullptr, receives the magnitude histogram (SOBEL_MAGNITUDE_LEVELS bins)
+ * @return 1 if any error occurs
+ */
+int compute_magnitudes(const ubyte *image, unsigned short **magnitudes, size_t width, size_t height,
+                       unsigned long long *histogram) {
+    // Check if the input image is valid
     if (image == nullptr) {
         std::cout << "Invalid input image\n";
         return 1;
     }
 
-    byte Gx[KERNEL_HEIGHT * KERNEL_WIDTH] = {-1, 0, 1, -2, 0, 2, -1, 0, 1};
+    *magnitudes = (unsigned short *) malloc(width * height * sizeof(unsigned short));
+
+    // check if the memory was allocated
+    if (*magnitudes == nullptr) {
+        std::cout << "Failed to allocate memory for the magnitudes!\n";
+        return 1;
+    }
+
+    std::vector<unsigned long long> local_histograms(histogram != nullptr ? worker_count() * SOBEL_MAGNITUDE_LEVELS : 0);
+
+    parallel_for(0, height, [&](size_t row_begin, size_t row_end, size_t worker) {
+        std::vector<int16> gx(width), gy(width);
+        unsigned long long *local = histogram != nullptr ?
+                                    local_histograms.data() + worker * SOBEL_MAGNITUDE_LEVELS : nullptr;
+
+        for (size_t i = row_begin; i < row_end; i++) {
+            const ubyte *above = i > 0 ? image + (i - 1) * width : nullptr;
+            const ubyte *below = i + 1 < height ? image + (i + 1) * width : nullptr;
+            unsigned short *row = *magnitudes + i * width;
+
+            sobel_gradient_row(above, image + i * width, below, gx.data(), gy.data(), width);
+            sobel_magnitude_row(gx.data(), gy.data(), row, width);
 
-    byte Gy[KERNEL_HEIGHT * KERNEL_WIDTH] = {-1, -2, -1, 0, 0, 0, 1, 2, 1};
+            if (local != nullptr) {
+                for (size_t j = 0; j < width; j++) local[row[j]]++;
+            }
+        }
+    });
+
+    if (histogram != nullptr) {
+        for (size_t level = 0; level < SOBEL_MAGNITUDE_LEVELS; level++) {
+            unsigned long long count = 0;
+            for (size_t worker = 0; worker < worker_count(); worker++)
+                count += local_histograms[worker * SOBEL_MAGNITUDE_LEVELS + level];
+            histogram[level] = count;
+        }
+    }
+
+    return 0;
+}
 
+/**
+ * Computes the Otsu threshold of a magnitude histogram.
+ *
+ * The threshold maximizes the between-class variance of the magnitudes at or below it and the
+ * magnitudes above it. Since strength_edge takes a byte threshold, the result is clipped to 255.
+ *
+ * @param histogram The magnitude histogram (SOBEL_MAGNITUDE_LEVELS bins).
+ * @return The threshold.
+ */
+ubyte otsu_threshold(const unsigned long long *histogram) {
+    double total = 0, total_sum = 0;
+    for (size_t level = 0; level < SOBEL_MAGNITUDE_LEVELS; level++) {
+        total += (double) histogram[level];
+        total_sum += (double) level * (double) histogram[level];
+    }
+
+    double background = 0, background_sum = 0, best_variance = -1;
+    size_t best_level = 0;
+    for (size_t level = 0; level < SOBEL_MAGNITUDE_LEVELS; level++) {
+        background += (double) histogram[level];
+        background_sum += (double) level * (double) histogram[level];
+
+        double foreground = total - background;
+        if (background == 0) continue;
+        if (foreground == 0) break;
+
+        double mean_difference = background_sum / background - (total_sum - background_sum) / foreground;
+        double variance = background * foreground * mean_difference * mean_difference;
+        if (variance > best_variance) {
+            best_variance = variance;
+            best_level = level;
+        }
+    }
+
+    return best_level > UCHAR_MAX ? UCHAR_MAX : (ubyte) best_level;
+}
+
+/**
+ * Computes the threshold below which the given percentage of the magnitudes fall.
+ *
+ * @param histogram The magnitude histogram (SOBEL_MAGNITUDE_LEVELS bins).
+ * @param percentile The percentage of magnitudes to keep at or below the threshold, in the range [0, 100].
+ * @return The threshold, clipped to 255.
+ */
+ubyte percentile_threshold(const unsigned long long *histogram, double percentile) {
+    unsigned long long total = 0;
+    for (size_t level = 0; level < SOBEL_MAGNITUDE_LEVELS; level++) total += histogram[level];
+
+    auto target = (unsigned long long) ceil((double) total * percentile / 100.0);
+    unsigned long long count = 0;
+    size_t level = 0;
+    for (; level < SOBEL_MAGNITUDE_LEVELS; level++) {
+        count += histogram[level];
+        if (count >= target) break;
+    }
+
+    return level > UCHAR_MAX ? UCHAR_MAX : (ubyte) level;
+}
+
+/**
+ * Evaluates strength_edge for every possible Sobel magnitude.
+ *
+ * @param threshold threshold to apply
+ * @param strength_ratio ratio used to strengthen or weaken the edges
+ * @param table output lookup table (SOBEL_MAGNITUDE_LEVELS elements)
+ */
+void build_edge_strength_table(ubyte threshold, double strength_ratio, ubyte *table) {
+    for (size_t level = 0; level < SOBEL_MAGNITUDE_LEVELS; level++)
+        table[level] = strength_edge((long long) level, threshold, strength_ratio);
+}
 
-    ubyte img_sec[KERNEL_HEIGHT * KERNEL_WIDTH]; // section of image (separate by channel)
+/**
+ * Applies strength_edge to precomputed Sobel magnitudes.
+ *
+ * Since there are only SOBEL_MAGNITUDE_LEVELS possible magnitudes, strength_edge is evaluated once
+ * per level into a lookup table, and the image pass is a parallel table lookup. The result is
+ * identical to detect_edges with the same threshold and strength ratio.
+ *
+ * @param magnitudes The magnitudes computed by compute_magnitudes.
+ * @param edges_detected_image output image, allocated by this function
+ * @param width width of the image
+ * @param height height of the image
+ * @param threshold threshold to apply
+ * @param strength_ratio ratio used to strengthen or weaken the edges
+ * @return 1 if any error occurs
+ */
+int apply_edge_strength(const unsigned short *magnitudes, ubyte **edges_detected_image, size_t width, size_t height,
+                        ubyte threshold,
+                        double strength_ratio) {
+    // Check if the input magnitudes are valid
+    if (magnitudes == nullptr) {
+        std::cout << "Invalid input magnitudes\n";
+        return 1;
+    }
 
-    ubyte out_pixel;
     *edges_detected_image = (ubyte *) malloc(width * height * sizeof(ubyte));
 
     // check if the memory was allocated
@@ -115,38 +639,305 @@ int detect_edges(const ubyte *image,
         return 1;
     }
 
-    for (int i = 0; i < height; i++) {
-        for (int j = 0; j < width; j++) {
-            extract_kernel(image, img_sec,
-                           height, width,
-                           KERNEL_HEIGHT, KERNEL_WIDTH,
-                           i, j);
+    ubyte table[SOBEL_MAGNITUDE_LEVELS];
+    build_edge_strength_table(threshold, strength_ratio, table);
 
-            switch (dir) {
-                case 0:
-                    convolve_2d(KERNEL_HEIGHT, KERNEL_WIDTH,
-                                img_sec, Gx,
-                                &out_pixel);
-                    break;
-                case 1:
-                    convolve_2d(KERNEL_HEIGHT, KERNEL_WIDTH,
-                                img_sec, Gy,
-                                &out_pixel);
-                    break;
+    ubyte *output = *edges_detected_image;
+    parallel_for(0, width * height, [&](size_t begin, size_t end, size_t) {
+        for (size_t i = begin; i < end; i++) output[i] = table[magnitudes[i]];
+    }, width);
 
-                case 2:
-                default:
-                    sobel(KERNEL_HEIGHT, KERNEL_WIDTH,
-                          img_sec, &out_pixel,
-                          Gx, Gy,
-                          true, threshold, strength_ratio);
+    return 0;
+}
 
-            }
+/**
+ * Applies strength_edge to the magnitudes of precomputed Sobel gradients.
+ *
+ * For filters that need the gradients themselves, this derives the edge map from them instead of
+ * running the Sobel convolution a second time. The result is identical to detect_edges with the
+ * same threshold and strength ratio.
+ *
+ * @param gx The x dir gradient computed by compute_gradients.
+ * @param gy The y dir gradient computed by compute_gradients.
+ * @param edges_detected_image output image, allocated by this function
+ * @param width width of the image
+ * @param height height of the image
+ * @param threshold threshold to apply
+ * @param strength_ratio ratio used to strengthen or weaken the edges
+ * @return 1 if any error occurs
+ */
+int apply_edge_strength_gradients(const int16 *gx, const int16 *gy, ubyte **edges_detected_image,
+                                  size_t width, size_t height,
+                                  ubyte threshold,
+                                  double strength_ratio) {
+    // Check if the input gradients are valid
+    if (gx == nullptr || gy == nullptr) {
+        std::cout << "Invalid input gradients\n";
+        return 1;
+    }
 
-            size_t index = (i * width + j);
-            (*edges_detected_image)[index] = out_pixel;
+    *edges_detected_image = (ubyte *) malloc(width * height * sizeof(ubyte));
+
+    // check if the memory was allocated
+    if (*edges_detected_image == nullptr) {
+        std::cout << "Failed to allocate memory for the edge detected image!\n";
+        return 1;
+    }
+
+    ubyte table[SOBEL_MAGNITUDE_LEVELS];
+    build_edge_strength_table(threshold, strength_ratio, table);
+
+    parallel_for(0, height, [&](size_t row_begin, size_t row_end, size_t) {
+        std::vector<unsigned short> magnitudes(width);
+        for (size_t i = row_begin; i < row_end; i++) {
+            sobel_magnitude_row(gx + i * width, gy + i * width, magnitudes.data(), width);
+            ubyte *output = *edges_detected_image + i * width;
+            for (size_t j = 0; j < width; j++) output[j] = table[magnitudes[j]];
         }
+    }, MIN_BAND_ROWS);
+
+    return 0;
+}
+
+/**
+ * Applies strength_edge to precomputed Sobel magnitudes for several (threshold, strength ratio) pairs.
+ *
+ * Every pair gets its own lookup table. The pixels are split into bands that are processed in
+ * parallel, and every band produces all outputs while its magnitudes are in cache, so the
+ * magnitudes are read from memory only once for the whole sweep.
+ *
+ * @param magnitudes The magnitudes computed by compute_magnitudes.
+ * @param edges_detected_images output images (count elements), allocated by this function
+ * @param count number of (threshold, strength ratio) pairs
+ * @param width width of the image
+ * @param height height of the image
+ * @param thresholds thresholds to apply (count elements)
+ * @param strength_ratios strength ratios to apply (count elements)
+ * @return 1 if any error occurs
+ */
+int apply_edge_strength_sweep(const unsigned short *magnitudes, ubyte **edges_detected_images, size_t count,
+                              size_t width, size_t height,
+                              const ubyte *thresholds,
+                              const double *strength_ratios) {
+    // Check if the input magnitudes are valid
+    if (magnitudes == nullptr) {
+        std::cout << "Invalid input magnitudes\n";
+        return 1;
+    }
+
+    std::vector<ubyte> tables(count * SOBEL_MAGNITUDE_LEVELS);
+    for (size_t k = 0; k < count; k++) {
+        edges_detected_images[k] = (ubyte *) malloc(width * height * sizeof(ubyte));
+
+        // check if the memory was allocated
+        if (edges_detected_images[k] == nullptr) {
+            std::cout << "Failed to allocate memory for the edge detected image!\n";
+            for (size_t l = 0; l < k; l++) free(edges_detected_images[l]);
+            return 1;
+        }
+
+        build_edge_strength_table(thresholds[k], strength_ratios[k], tables.data() + k * SOBEL_MAGNITUDE_LEVELS);
     }
+
+    parallel_for(0, width * height, [&](size_t begin, size_t end, size_t) {
+        // small blocks keep the magnitudes in L1 while every table is applied
+        const size_t block = 4096;
+        for (size_t block_begin = begin; block_begin < end; block_begin += block) {
+            size_t block_end = block_begin + block < end ? block_begin + block : end;
+            for (size_t k = 0; k < count; k++) {
+                const ubyte *table = tables.data() + k * SOBEL_MAGNITUDE_LEVELS;
+                ubyte *output = edges_detected_images[k];
+                for (size_t i = block_begin; i < block_end; i++) output[i] = table[magnitudes[i]];
+            }
+        }
+    }, width);
+
+    return 0;
+}
+
+/**
+ * Detect Edges by using Sobel Operation with an automatically chosen threshold
+ *
+ * The magnitudes and their histogram are computed in a single pass, the threshold is derived from
+ * the histogram, and strength_edge is applied over the cached magnitudes. The convolutions are
+ * computed only once.
+ *
+ * @param image input image
+ * @param edges_detected_image output image
+ * @param width width of input image
+ * @param height height of input image
+ * @param mode THRESHOLD_OTSU or THRESHOLD_PERCENTILE
+ * @param percentile percentage of the magnitudes below the threshold (only used by THRESHOLD_PERCENTILE)
+ * @param strength_ratio ratio used to strengthen or weaken the edges
+ * @param threshold if not nullptr, receives the chosen threshold
+ * @return 1 if any error occurs
+ */
+int detect_edges_auto(const ubyte *image, ubyte **edges_detected_image, size_t width, size_t height,
+                      threshold_mode mode,
+                      double percentile,
+                      double strength_ratio,
+                      ubyte *threshold) {
+
+    unsigned short *magnitudes;
+    unsigned long long histogram[SOBEL_MAGNITUDE_LEVELS];
+
+    if (compute_magnitudes(image, &magnitudes, width, height, histogram) != 0) return 1;
+
+    ubyte chosen = mode == THRESHOLD_PERCENTILE ?
+                   percentile_threshold(histogram, percentile) :
+                   otsu_threshold(histogram);
+    if (threshold != nullptr) *threshold = chosen;
+
+    int state = apply_edge_strength(magnitudes, edges_detected_image, width, height, chosen, strength_ratio);
+    free(magnitudes);
+    return state;
+}
+
+/**
+ * Detect Edges by using Sobel Operation, skipping the flat regions of the image
+ *
+ * A pre-pass computes the minimum and the maximum of every FLAT_TILE_SIZE x FLAT_TILE_SIZE tile and
+ * of its one pixel halo (the pixels outside the image count as zero, like for detect_edges). The
+ * output of the tiles whose range is at most the tolerance is filled with zero without computing
+ * any gradient, the others are computed row by row over runs of consecutive non flat tiles.
+ *
+ * With a tolerance of 0 the skipped tiles are constant, their Sobel response is exactly zero and the
+ * result is identical to detect_edges. A larger tolerance also skips the nearly flat tiles (noise,
+ * paper texture), whose gradients are at most 4 times the tolerance.
+ *
+ * @param image input image
+ * @param edges_detected_image output image
+ * @param width width of input image
+ * @param height height of input image
+ * @param threshold threshold to apply
+ * @param strength_ratio ratio used to strengthen or weaken the edges
+ * @param dir direction of edge detection
+ * ( 0 : only vertical edges , 1 : only horizontal edges, 2: horizontal and vertical edges)
+ * @param tolerance largest range of the pixel values of a skipped tile
+ * @param skipped_ratio if not nullptr, receives the fraction of the tiles that were skipped
+ * @return 1 if any error occurs
+ */
+int detect_edges_skip_flat(const ubyte *image, ubyte **edges_detected_image, size_t width, size_t height,
+                           ubyte threshold,
+                           double strength_ratio,
+                           short dir,
+                           ubyte tolerance,
+                           double *skipped_ratio) {
+    // Check if the input image is valid
+    if (image == nullptr) {
+        std::cout << "Invalid input image\n";
+        return 1;
+    }
+
+    *edges_detected_image = (ubyte *) malloc(width * height * sizeof(ubyte));
+
+    // check if the memory was allocated
+    if (*edges_detected_image == nullptr) {
+        std::cout << "Failed to allocate memory for the edge detected image!\n";
+        return 1;
+    }
+
+    size_t tiles_x = (width + FLAT_TILE_SIZE - 1) / FLAT_TILE_SIZE;
+    size_t tiles_y = (height + FLAT_TILE_SIZE - 1) / FLAT_TILE_SIZE;
+    std::vector<ubyte> flat(tiles_x * tiles_y);
+
+    // 1. range of every tile and of its halo
+    parallel_for(0, tiles_y, [&](size_t tile_begin, size_t tile_end, size_t) {
+        std::vector<ubyte> minimum(tiles_x), maximum(tiles_x);
+
+        for (size_t ty = tile_begin; ty < tile_end; ty++) {
+            size_t row_begin = ty * FLAT_TILE_SIZE, row_end = row_begin + FLAT_TILE_SIZE;
+            bool outside = row_begin == 0 || row_end >= height;
+            row_begin = row_begin > 0 ? row_begin - 1 : 0;
+            row_end = row_end + 1 < height ? row_end + 1 : height;
+
+            std::fill(minimum.begin(), minimum.end(), UCHAR_MAX);
+            std::fill(maximum.begin(), maximum.end(), 0);
+
+            for (size_t i = row_begin; i < row_end; i++) {
+                const ubyte *row = image + i * width;
+                for (size_t tx = 0; tx < tiles_x; tx++) {
+                    size_t begin = tx * FLAT_TILE_SIZE, end = begin + FLAT_TILE_SIZE + 1;
+                    begin = begin > 0 ? begin - 1 : 0;
+                    end = end < width ? end : width;
+
+                    // branch free, so that the compiler can vectorize it
+                    ubyte low = minimum[tx], high = maximum[tx];
+                    for (size_t j = begin; j < end; j++) {
+                        low = row[j] < low ? row[j] : low;
+                        high = row[j] > high ? row[j] : high;
+                    }
+                    minimum[tx] = low, maximum[tx] = high;
+                }
+            }
+
+            for (size_t tx = 0; tx < tiles_x; tx++) {
+                bool padded = outside || tx == 0 || (tx + 1) * FLAT_TILE_SIZE >= width;
+                ubyte low = padded ? 0 : minimum[tx];
+                flat[ty * tiles_x + tx] = maximum[tx] - low <= tolerance;
+            }
+        }
+    });
+
+    size_t skipped = 0;
+    for (ubyte tile: flat) skipped += tile;
+    if (skipped_ratio != nullptr) *skipped_ratio = flat.empty() ? 0 : (double) skipped / (double) flat.size();
+
+    ubyte table[SOBEL_MAGNITUDE_LEVELS];
+    build_edge_strength_table(threshold, strength_ratio, table);
+
+    // 2. edges of the runs of non flat tiles, zeros elsewhere
+    parallel_for(0, tiles_y, [&](size_t tile_begin, size_t tile_end, size_t) {
+        std::vector<int16> gx(width + 2), gy(width + 2);
+        std::vector<unsigned short> magnitudes(width);
+
+        for (size_t ty = tile_begin; ty < tile_end; ty++) {
+            const ubyte *tiles = flat.data() + ty * tiles_x;
+            size_t row_end = (ty + 1) * FLAT_TILE_SIZE < height ? (ty + 1) * FLAT_TILE_SIZE : height;
+
+            for (size_t i = ty * FLAT_TILE_SIZE; i < row_end; i++) {
+                const ubyte *above = i > 0 ? image + (i - 1) * width : nullptr;
+                const ubyte *below = i + 1 < height ? image + (i + 1) * width : nullptr;
+                ubyte *output = *edges_detected_image + i * width;
+
+                for (size_t tx = 0; tx < tiles_x;) {
+                    size_t run = tx;
+                    while (run < tiles_x && tiles[run] == tiles[tx]) run++;
+
+                    size_t begin = tx * FLAT_TILE_SIZE;
+                    size_t end = run * FLAT_TILE_SIZE < width ? run * FLAT_TILE_SIZE : width;
+                    bool is_flat = tiles[tx] != 0;
+                    tx = run;
+
+                    if (is_flat) {
+                        std::fill(output + begin, output + end, 0);
+                        continue;
+                    }
+
+                    // the gradients of the run with its neighbor columns, which are only used as input
+                    size_t span_begin = begin > 0 ? begin - 1 : 0;
+                    size_t span_end = end < width ? end + 1 : width;
+                    size_t offset = begin - span_begin;
+                    sobel_gradient_row(above != nullptr ? above + span_begin : nullptr,
+                                       image + i * width + span_begin,
+                                       below != nullptr ? below + span_begin : nullptr,
+                                       gx.data(), gy.data(), span_end - span_begin);
+
+                    const int16 *x = gx.data() + offset, *y = gy.data() + offset;
+                    size_t count = end - begin;
+                    if (dir == 0) {
+                        for (size_t j = 0; j < count; j++) output[begin + j] = (ubyte) std::min(abs(x[j]), UCHAR_MAX);
+                    } else if (dir == 1) {
+                        for (size_t j = 0; j < count; j++) output[begin + j] = (ubyte) std::min(abs(y[j]), UCHAR_MAX);
+                    } else {
+                        sobel_magnitude_row(x, y, magnitudes.data(), count);
+                        for (size_t j = 0; j < count; j++) output[begin + j] = table[magnitudes[j]];
+                    }
+                }
+            }
+        }
+    });
+
     return 0;
 }
 
@@ -182,47 +973,3 @@ static ubyte clip_to_ubyte(long long val) {
         return abs((int) val);
     }
 }
-
-/**
- * Extracts a sub-matrix from an input matrix centered at the given i and j indices.
- *
- * The sub-matrix is extracted using a kernel of the given height and width, and
- * the resulting sub-matrix is stored in the output array.
- *
- * If any part of the kernel extends beyond the bounds of the input matrix, the
- * corresponding elements of the output array are set to zero.
- *
- * @param input A pointer to the input matrix data.
- * @param output A pointer to the output sub-matrix data.
- * @param height The number of rows in the input matrix.
- * @param width The number of columns in the input matrix.
- * @param kernel_height The height of the kernel used to extract the sub-matrix.
- * @param kernel_width The width of the kernel used to extract the sub-matrix.
- * @param i_index The row index at the center of the sub-matrix.
- * @param j_index The column index at the center of the sub-matrix.
- */
-static void extract_kernel(const ubyte *input,
-                           ubyte *output,
-                           size_t height, size_t width,
-                           size_t kernel_height, size_t kernel_width,
-                           size_t i_index, size_t j_index) {
-
-    long i_dist, j_dist, dist_ij;
-    dist_ij = ((long) kernel_width - 1) / 2;
-
-    for (int i = 0; i < kernel_width; i++) {
-        i_dist = (long) i_index + i - dist_ij;
-        for (int j = 0; j < kernel_height; j++) {
-            j_dist = (long) j_index + j - dist_ij;
-
-            // Check if the current index is out of bounds
-            if (i_dist >= height || i_dist < 0 || j_dist >= width || j_dist < 0) {
-                output[i * kernel_width + j] = 0;
-            } else {
-                // Compute the index of the current element in the input matrix
-                size_t index = i_dist * width + j_dist;
-                output[i * kernel_width + j] = input[index];
-            }
-        }
-    }
-}
\ No newline at end of file
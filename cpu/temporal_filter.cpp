@@ -0,0 +1,182 @@
+#include <iostream>
+#include <vector>
+#include <cstring>
+#include "../filters/temporal_filter.h"
+#include "../filters/roi_filter.h"
+#include "../filters/parallel.h"
+
+
+// size of the square tiles that are compared between frames
+#define SEQUENCE_TILE_SIZE 32
+
+
+/**
+ * Starts a sequence of frames for detect_edges_sequence.
+ *
+ * @param width The width of the frames in pixels.
+ * @param height The height of the frames in pixels.
+ * @param threshold threshold to apply
+ * @param strength_ratio ratio used to strengthen or weaken the edges
+ * @param tolerance A tile is reused if none of its pixels changed by more than this value since it was computed.
+ * @param sequence A pointer to the new sequence (release it with free_edge_sequence).
+ * @return 0 if the sequence was created, or 1 if memory allocation failed.
+ */
+int create_edge_sequence(size_t width, size_t height,
+                         ubyte threshold,
+                         double strength_ratio,
+                         ubyte tolerance,
+                         edge_sequence **sequence) {
+    *sequence = (edge_sequence *) malloc(sizeof(edge_sequence));
+    if (*sequence == nullptr) {
+        std::cout << "Failed to allocate memory for the sequence!\n";
+        return 1;
+    }
+
+    **sequence = {width, height, threshold, strength_ratio, tolerance, false,
+                  (ubyte *) malloc(width * height * sizeof(ubyte)),
+                  (ubyte *) malloc(width * height * sizeof(ubyte))};
+
+    // Check if the memory was allocated
+    if ((*sequence)->reference == nullptr || (*sequence)->edges == nullptr) {
+        std::cout << "Failed to allocate memory for the sequence!\n";
+        free_edge_sequence(*sequence);
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * Releases a sequence created by create_edge_sequence.
+ *
+ * @param sequence The sequence.
+ */
+void free_edge_sequence(edge_sequence *sequence) {
+    if (sequence == nullptr) return;
+    free(sequence->reference);
+    free(sequence->edges);
+    free(sequence);
+}
+
+/**
+ * Detect Edges by using Sobel Operation on the next frame of a sequence, reusing the unchanged tiles
+ *
+ * The frame is compared tile by tile with the input every tile was last computed from, with a
+ * vectorizable maximum of the absolute differences. Only the changed tiles, grown by the one pixel
+ * halo whose 3x3 neighborhood they touch, are recomputed; the edges of the other pixels are kept from
+ * the previous frame. With a tolerance of 0 the result is identical to detect_edges on every frame.
+ * The first frame is computed in full.
+ *
+ * @param sequence The sequence (from create_edge_sequence).
+ * @param image The next frame, of the size of the sequence.
+ * @param edges_detected_image output image
+ * @param reuse_ratio if not nullptr, receives the fraction of the tiles that were reused
+ * @return 1 if any error occurs
+ */
+int detect_edges_sequence(edge_sequence *sequence, const ubyte *image, ubyte **edges_detected_image,
+                          double *reuse_ratio) {
+    // Check if the sequence and the input image are valid
+    if (sequence == nullptr || image == nullptr) {
+        std::cout << "Invalid sequence or input image\n";
+        return 1;
+    }
+
+    size_t width = sequence->width, height = sequence->height;
+    size_t tiles_x = (width + SEQUENCE_TILE_SIZE - 1) / SEQUENCE_TILE_SIZE;
+    size_t tiles_y = (height + SEQUENCE_TILE_SIZE - 1) / SEQUENCE_TILE_SIZE;
+    std::vector<ubyte> changed(tiles_x * tiles_y, 1);
+
+    // 1. compare every tile with its reference
+    if (sequence->started) {
+        parallel_for(0, tiles_y, [&](size_t tile_begin, size_t tile_end, size_t) {
+            std::vector<ubyte> difference(tiles_x);
+
+            for (size_t ty = tile_begin; ty < tile_end; ty++) {
+                std::fill(difference.begin(), difference.end(), 0);
+                size_t row_end = (ty + 1) * SEQUENCE_TILE_SIZE < height ? (ty + 1) * SEQUENCE_TILE_SIZE : height;
+
+                for (size_t i = ty * SEQUENCE_TILE_SIZE; i < row_end; i++) {
+                    const ubyte *current = image + i * width, *reference = sequence->reference + i * width;
+                    for (size_t tx = 0; tx < tiles_x; tx++) {
+                        size_t begin = tx * SEQUENCE_TILE_SIZE;
+                        size_t end = begin + SEQUENCE_TILE_SIZE < width ? begin + SEQUENCE_TILE_SIZE : width;
+
+                        // branch free, so that the compiler can vectorize it
+                        ubyte largest = difference[tx];
+                        for (size_t j = begin; j < end; j++) {
+                            ubyte d = current[j] > reference[j] ? current[j] - reference[j] : reference[j] - current[j];
+                            largest = d > largest ? d : largest;
+                        }
+                        difference[tx] = largest;
+                    }
+                }
+
+                for (size_t tx = 0; tx < tiles_x; tx++)
+                    changed[ty * tiles_x + tx] = difference[tx] > sequence->tolerance;
+            }
+        });
+    }
+
+    // 2. the changed tiles with their halo, as runs of consecutive tiles
+    std::vector<roi> rois;
+    size_t recomputed = 0;
+    for (size_t ty = 0; ty < tiles_y; ty++) {
+        for (size_t tx = 0; tx < tiles_x;) {
+            if (!changed[ty * tiles_x + tx]) {
+                tx++;
+                continue;
+            }
+
+            size_t run = tx;
+            while (run < tiles_x && changed[ty * tiles_x + run]) run++;
+            recomputed += run - tx;
+
+            size_t x = tx * SEQUENCE_TILE_SIZE, y = ty * SEQUENCE_TILE_SIZE;
+            size_t x_begin = x > 0 ? x - 1 : 0, y_begin = y > 0 ? y - 1 : 0;
+            rois.push_back({x_begin, y_begin,
+                            run * SEQUENCE_TILE_SIZE + 1 - x_begin,
+                            (ty + 1) * SEQUENCE_TILE_SIZE + 1 - y_begin});
+            tx = run;
+        }
+    }
+
+    pixel_run *runs;
+    size_t count;
+    if (rois_to_runs(rois.data(), rois.size(), width, height, &runs, &count) != 0) return 1;
+
+    int state = update_edges_runs(image, sequence->edges, width, height, runs, count,
+                                  sequence->threshold, sequence->strength_ratio);
+    free(runs);
+    if (state != 0) return 1;
+
+    // 3. the changed tiles become the reference of the next frame
+    parallel_for(0, tiles_y, [&](size_t tile_begin, size_t tile_end, size_t) {
+        for (size_t ty = tile_begin; ty < tile_end; ty++) {
+            size_t row_end = (ty + 1) * SEQUENCE_TILE_SIZE < height ? (ty + 1) * SEQUENCE_TILE_SIZE : height;
+            for (size_t tx = 0; tx < tiles_x; tx++) {
+                if (!changed[ty * tiles_x + tx]) continue;
+
+                size_t begin = tx * SEQUENCE_TILE_SIZE;
+                size_t end = begin + SEQUENCE_TILE_SIZE < width ? begin + SEQUENCE_TILE_SIZE : width;
+                for (size_t i = ty * SEQUENCE_TILE_SIZE; i < row_end; i++)
+                    memcpy(sequence->reference + i * width + begin, image + i * width + begin, end - begin);
+            }
+        }
+    });
+    sequence->started = true;
+
+    if (reuse_ratio != nullptr) {
+        *reuse_ratio = changed.empty() ? 0 : 1 - (double) recomputed / (double) changed.size();
+    }
+
+    *edges_detected_image = (ubyte *) malloc(width * height * sizeof(ubyte));
+
+    // check if the memory was allocated
+    if (*edges_detected_image == nullptr) {
+        std::cout << "Failed to allocate memory for the edge detected image!\n";
+        return 1;
+    }
+
+    memcpy(*edges_detected_image, sequence->edges, width * height * sizeof(ubyte));
+    return 0;
+}
@@ -0,0 +1,290 @@
+#include <iostream>
+#include <cstring>
+#include "../filters/video_io.h"
+
+// the errors are printed to stderr, since the frames may be written to stdout
+
+// signature of the stream header and of the frame headers of a Y4M file
+#define Y4M_SIGNATURE "YUV4MPEG2"
+#define Y4M_FRAME "FRAME"
+
+// parameters of the Y4M files written for raw input
+#define Y4M_DEFAULT_PARAMETERS "F25:1 Ip A1:1"
+
+// longest header line that is accepted
+#define MAX_HEADER_LENGTH 1024
+
+
+/**
+ * Reads a line of a Y4M header, without its newline.
+ *
+ * @return false if the stream ended or the line is too long.
+ */
+static bool read_header_line(FILE *file, char *line, size_t size) {
+    size_t length = 0;
+    int c;
+    while ((c = fgetc(file)) != EOF && c != '\n') {
+        if (length + 1 >= size) return false;
+        line[length++] = (char) c;
+    }
+    line[length] = '\0';
+    return c == '\n';
+}
+
+/**
+ * Parses the stream header of a Y4M file.
+ *
+ * The size and the color space are read; the frame rate, interlacing and aspect ratio are kept as
+ * text so that they can be copied to the output, the other parameters are ignored. Only 8 bit color spaces are supported.
+ */
+static bool parse_y4m_header(const char *header, video_reader *reader) {
+    if (strncmp(header, Y4M_SIGNATURE " ", strlen(Y4M_SIGNATURE) + 1) != 0) return false;
+
+    const char *color_space = "420";
+    char color_buffer[32] = "";
+    reader->width = reader->height = 0;
+    reader->parameters[0] = '\0';
+
+    char copy[MAX_HEADER_LENGTH];
+    strncpy(copy, header + strlen(Y4M_SIGNATURE), sizeof(copy) - 1);
+    copy[sizeof(copy) - 1] = '\0';
+
+    for (char *token = strtok(copy, " "); token != nullptr; token = strtok(nullptr, " ")) {
+        switch (token[0]) {
+            case 'W':
+                reader->width = strtoul(token + 1, nullptr, 10);
+                break;
+            case 'H':
+                reader->height = strtoul(token + 1, nullptr, 10);
+                break;
+            case 'C':
+                strncpy(color_buffer, token + 1, sizeof(color_buffer) - 1);
+                color_space = color_buffer;
+                break;
+            case 'F':
+            case 'I':
+            case 'A':
+                if (strlen(reader->parameters) + strlen(token) + 2 < sizeof(reader->parameters)) {
+                    if (reader->parameters[0] != '\0') strcat(reader->parameters, " ");
+                    strcat(reader->parameters, token);
+                }
+                break;
+            default:
+                // X parameters describe the original encoding and are not copied
+                break;
+        }
+    }
+
+    size_t chroma_width = (reader->width + 1) / 2, chroma_height = (reader->height + 1) / 2;
+    if (strcmp(color_space, "420") == 0 || strcmp(color_space, "420jpeg") == 0 ||
+        strcmp(color_space, "420paldv") == 0 || strcmp(color_space, "420mpeg2") == 0) {
+        reader->chroma_size = 2 * chroma_width * chroma_height;
+    } else if (strcmp(color_space, "422") == 0) {
+        reader->chroma_size = 2 * chroma_width * reader->height;
+    } else if (strcmp(color_space, "444") == 0) {
+        reader->chroma_size = 2 * reader->width * reader->height;
+    } else if (strcmp(color_space, "mono") == 0) {
+        reader->chroma_size = 0;
+    } else {
+        return false;
+    }
+
+    return reader->width > 0 && reader->height > 0;
+}
+
+/**
+ * Opens a stream of YUV frames.
+ *
+ * The size of a Y4M stream is read from its header; raw I420 (planar Y, U, V) and NV12 (planar Y,
+ * interleaved UV) streams have no header, so their size must be given. Both start with the luma
+ * plane and have the same chroma size, so only their headerless layout matters here.
+ *
+ * @param path The file to read, or "-" for stdin.
+ * @param format VIDEO_Y4M, VIDEO_I420 or VIDEO_NV12.
+ * @param width The width of the frames in pixels (ignored for Y4M).
+ * @param height The height of the frames in pixels (ignored for Y4M).
+ * @param reader A pointer to the new reader (release it with close_video_reader).
+ * @return 0 if the stream was opened, or 1 if it cannot be read or is not supported.
+ */
+int open_video_reader(const char *path, video_format format, size_t width, size_t height,
+                      video_reader **reader) {
+    *reader = (video_reader *) calloc(1, sizeof(video_reader));
+    if (*reader == nullptr) {
+        std::cerr << "Failed to allocate memory for the video reader!\n";
+        return 1;
+    }
+
+    video_reader *video = *reader;
+    video->format = format;
+    video->file = strcmp(path, "-") == 0 ? stdin : fopen(path, "rb");
+    if (video->file == nullptr) {
+        std::cerr << "Failed to open the video!\n";
+        close_video_reader(video);
+        return 1;
+    }
+
+    if (format == VIDEO_Y4M) {
+        char header[MAX_HEADER_LENGTH];
+        if (!read_header_line(video->file, header, sizeof(header)) || !parse_y4m_header(header, video)) {
+            std::cerr << "Invalid or unsupported Y4M header!\n";
+            close_video_reader(video);
+            return 1;
+        }
+    } else {
+        video->width = width;
+        video->height = height;
+        video->chroma_size = 2 * ((width + 1) / 2) * ((height + 1) / 2);
+    }
+
+    if (video->width == 0 || video->height == 0) {
+        std::cerr << "Invalid video size!\n";
+        close_video_reader(video);
+        return 1;
+    }
+
+    video->chroma = (ubyte *) malloc(video->chroma_size > 0 ? video->chroma_size : 1);
+    if (video->chroma == nullptr) {
+        std::cerr << "Failed to allocate memory for the video reader!\n";
+        close_video_reader(video);
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * Reads the luma plane of the next frame; the chroma planes are read and dropped.
+ *
+ * The luma plane is a gray scale image that can be given to the edge detectors as is, without any
+ * color conversion.
+ *
+ * @param reader The stream.
+ * @param luma Output buffer for the luma plane (width * height bytes).
+ * @param end_of_stream Set to true if there is no frame left.
+ * @return 0 if a frame was read or the stream ended, or 1 if the stream is truncated or malformed.
+ */
+int read_video_frame(video_reader *reader, ubyte *luma, bool *end_of_stream) {
+    *end_of_stream = false;
+
+    if (reader->format == VIDEO_Y4M) {
+        char header[MAX_HEADER_LENGTH];
+        int c = fgetc(reader->file);
+        if (c == EOF) {
+            *end_of_stream = true;
+            return 0;
+        }
+        ungetc(c, reader->file);
+
+        if (!read_header_line(reader->file, header, sizeof(header)) ||
+            strncmp(header, Y4M_FRAME, strlen(Y4M_FRAME)) != 0) {
+            std::cerr << "Invalid Y4M frame header!\n";
+            return 1;
+        }
+    }
+
+    size_t luma_size = reader->width * reader->height;
+    size_t read = fread(luma, 1, luma_size, reader->file);
+    if (read == 0 && reader->format != VIDEO_Y4M && feof(reader->file)) {
+        *end_of_stream = true;
+        return 0;
+    }
+
+    if (read != luma_size || fread(reader->chroma, 1, reader->chroma_size, reader->file) != reader->chroma_size) {
+        std::cerr << "Truncated video frame!\n";
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * Closes a stream opened by open_video_reader.
+ *
+ * @param reader The stream.
+ */
+void close_video_reader(video_reader *reader) {
+    if (reader == nullptr) return;
+    if (reader->file != nullptr && reader->file != stdin) fclose(reader->file);
+    free(reader->chroma);
+    free(reader);
+}
+
+/**
+ * Opens a stream of YUV 4:2:0 frames for writing.
+ *
+ * Only the luma plane of the frames is given, the chroma is neutral, so the frames are gray.
+ *
+ * @param path The file to write, or "-" for stdout.
+ * @param format VIDEO_Y4M, VIDEO_I420 or VIDEO_NV12.
+ * @param width The width of the frames in pixels.
+ * @param height The height of the frames in pixels.
+ * @param parameters The frame rate, interlacing and aspect ratio of the Y4M header, or nullptr for the defaults.
+ * @param writer A pointer to the new writer (release it with close_video_writer).
+ * @return 0 if the stream was opened, or 1 if it cannot be written.
+ */
+int open_video_writer(const char *path, video_format format, size_t width, size_t height,
+                      const char *parameters,
+                      video_writer **writer) {
+    *writer = (video_writer *) calloc(1, sizeof(video_writer));
+    if (*writer == nullptr) {
+        std::cerr << "Failed to allocate memory for the video writer!\n";
+        return 1;
+    }
+
+    video_writer *video = *writer;
+    video->format = format;
+    video->width = width;
+    video->height = height;
+    video->chroma_size = 2 * ((width + 1) / 2) * ((height + 1) / 2);
+    video->chroma = (ubyte *) malloc(video->chroma_size > 0 ? video->chroma_size : 1);
+    video->file = strcmp(path, "-") == 0 ? stdout : fopen(path, "wb");
+
+    if (video->chroma == nullptr || video->file == nullptr) {
+        std::cerr << "Failed to open the output video!\n";
+        close_video_writer(video);
+        return 1;
+    }
+    memset(video->chroma, 128, video->chroma_size);
+
+    if (format == VIDEO_Y4M) {
+        const char *rest = parameters != nullptr && parameters[0] != '\0' ? parameters : Y4M_DEFAULT_PARAMETERS;
+        fprintf(video->file, "%s W%zu H%zu %s C420jpeg\n", Y4M_SIGNATURE, width, height, rest);
+    }
+
+    return 0;
+}
+
+/**
+ * Writes a frame made of the given luma plane and neutral chroma.
+ *
+ * @param writer The stream.
+ * @param luma The luma plane (width * height bytes).
+ * @return 0 if the frame was written, or 1 if writing failed.
+ */
+int write_video_frame(video_writer *writer, const ubyte *luma) {
+    if (writer->format == VIDEO_Y4M) fputs(Y4M_FRAME "\n", writer->file);
+
+    size_t luma_size = writer->width * writer->height;
+    if (fwrite(luma, 1, luma_size, writer->file) != luma_size ||
+        fwrite(writer->chroma, 1, writer->chroma_size, writer->file) != writer->chroma_size) {
+        std::cerr << "Failed to write the video frame!\n";
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * Flushes and closes a stream opened by open_video_writer.
+ *
+ * @param writer The stream.
+ */
+void close_video_writer(video_writer *writer) {
+    if (writer == nullptr) return;
+    if (writer->file != nullptr) {
+        if (writer->file == stdout) fflush(stdout);
+        else fclose(writer->file);
+    }
+    free(writer->chroma);
+    free(writer);
+}
@@ -0,0 +1,224 @@
+#include <iostream>
+#include <vector>
+#include "../filters/zero_crossing_filter.h"
+#include "../filters/sobel_filter.h"
+#include "../filters/parallel.h"
+
+
+// ratio between the two sigmas of the Difference of Gaussians (Marr and Hildreth)
+#define DOG_SIGMA_RATIO 1.6
+
+// the kernels are cut at this many sigmas
+#define KERNEL_EXTENT 4.0
+
+// minimum number of rows per band, smaller bands are not worth a thread
+#define MIN_BAND_ROWS 16
+
+
+/**
+ * The response of a second order operator as a sum of two separable convolutions:
+ * response = sum over p of horizontal[p] * (vertical[p] * image).
+ */
+struct second_order_plan {
+    long radius;
+    std::vector<float> vertical[2];
+    std::vector<float> horizontal[2];
+    float strength_scale;   // turns a response slope into the contrast of the step edge
+};
+
+static inline long clamp_index(long index, long size) {
+    return index < 0 ? 0 : (index >= size ? size - 1 : index);
+}
+
+/**
+ * Samples a Gaussian with a unit sum.
+ */
+static std::vector<double> gaussian_kernel(double sigma, long radius) {
+    std::vector<double> kernel(2 * radius + 1);
+    double sum = 0;
+    for (long k = -radius; k <= radius; k++) {
+        kernel[k + radius] = exp(-(double) (k * k) / (2 * sigma * sigma));
+        sum += kernel[k + radius];
+    }
+    for (double &weight: kernel) weight /= sum;
+    return kernel;
+}
+
+/**
+ * Builds the kernels of the Laplacian of Gaussian or of the Difference of Gaussians.
+ *
+ * The LoG is Gxx(x) G(y) + G(x) Gyy(y). The sampled second derivative is corrected to a zero sum,
+ * so flat areas have no response, and to a unit second moment. The DoG is G(k sigma) - G(sigma).
+ *
+ * The LoG response of a step edge of contrast C has a slope of C / (sqrt(2 pi) sigma^3) at its zero
+ * crossing, so the slope is multiplied by sqrt(2 pi) sigma^3 to express it in gray levels. The slope
+ * of the DoG is C (k - 1) / (sqrt(2 pi) k sigma), so the DoG is rescaled by k / ((k - 1) sigma^2)
+ * to give the same slope.
+ */
+static second_order_plan make_plan(second_order_operator op, double sigma) {
+    second_order_plan plan{};
+    double outer_sigma = op == SECOND_ORDER_DOG ? sigma * DOG_SIGMA_RATIO : sigma;
+    plan.radius = (long) ceil(KERNEL_EXTENT * outer_sigma);
+    plan.strength_scale = (float) (sqrt(2 * M_PI) * sigma * sigma * sigma);
+
+    std::vector<double> gaussian = gaussian_kernel(sigma, plan.radius);
+    auto to_float = [](const std::vector<double> &kernel, double gain) {
+        std::vector<float> result(kernel.size());
+        for (size_t k = 0; k < kernel.size(); k++) result[k] = (float) (kernel[k] * gain);
+        return result;
+    };
+
+    if (op == SECOND_ORDER_LOG) {
+        std::vector<double> second(gaussian.size());
+        double sum = 0;
+        for (long k = -plan.radius; k <= plan.radius; k++) {
+            double x = (double) k;
+            second[k + plan.radius] = (x * x - sigma * sigma) / (sigma * sigma * sigma * sigma) * gaussian[k + plan.radius];
+            sum += second[k + plan.radius];
+        }
+
+        double moment = 0;
+        for (long k = -plan.radius; k <= plan.radius; k++) {
+            second[k + plan.radius] -= sum * gaussian[k + plan.radius];
+            moment += (double) (k * k) / 2 * second[k + plan.radius];
+        }
+        for (double &weight: second) weight /= moment;
+
+        plan.vertical[0] = to_float(gaussian, 1), plan.horizontal[0] = to_float(second, 1);
+        plan.vertical[1] = to_float(second, 1), plan.horizontal[1] = to_float(gaussian, 1);
+    } else {
+        std::vector<double> outer = gaussian_kernel(outer_sigma, plan.radius);
+        double gain = DOG_SIGMA_RATIO / ((DOG_SIGMA_RATIO - 1) * sigma * sigma);
+
+        plan.vertical[0] = to_float(outer, 1), plan.horizontal[0] = to_float(outer, gain);
+        plan.vertical[1] = to_float(gaussian, 1), plan.horizontal[1] = to_float(gaussian, -gain);
+    }
+
+    return plan;
+}
+
+/**
+ * Computes the second order response of the rows [row_begin, row_end).
+ *
+ * Pixels outside the image are replaced by the nearest border pixel. Every output row has one
+ * zero column on both sides (width + 2 elements), so the zero crossings need no border checks.
+ */
+static void response_rows(const ubyte *image, size_t width, size_t height,
+                          const second_order_plan &plan,
+                          size_t row_begin, size_t row_end,
+                          float *output) {
+    long radius = plan.radius;
+    std::vector<float> vertical(width + 2 * radius);
+    float *center = vertical.data() + radius;
+
+    for (size_t i = row_begin; i < row_end; i++) {
+        float *out = output + (i - row_begin) * (width + 2);
+        std::fill(out, out + width + 2, 0.0f);
+        out++;
+
+        for (int p = 0; p < 2; p++) {
+            // vertical pass
+            std::fill(center, center + width, 0.0f);
+            for (long k = -radius; k <= radius; k++) {
+                const ubyte *row = image + clamp_index((long) i + k, (long) height) * width;
+                float weight = plan.vertical[p][k + radius];
+                for (size_t j = 0; j < width; j++) center[j] += weight * (float) row[j];
+            }
+            for (long k = 1; k <= radius; k++) {
+                center[-k] = center[0];
+                center[width - 1 + k] = center[width - 1];
+            }
+
+            // horizontal pass
+            for (long k = -radius; k <= radius; k++) {
+                const float *shifted = center + k;
+                float weight = plan.horizontal[p][k + radius];
+                for (size_t j = 0; j < width; j++) out[j] += weight * shifted[j];
+            }
+        }
+    }
+}
+
+
+/**
+ * Detect Edges at the zero crossings of a Laplacian of Gaussian or a Difference of Gaussians
+ *
+ * The response is computed with separable passes, band by band with a one row halo, and never
+ * stored for the whole image. A pixel is an edge if the response changes sign towards one of its
+ * 4 neighbors and the pixel is the one closer to zero, which keeps the edges one pixel thin. The
+ * strength of the edge is the slope of the response across the crossing, in gray levels of the
+ * step edge it comes from, and is thresholded like detect_edges thresholds the Sobel magnitude.
+ *
+ * @param image input image
+ * @param edges_detected_image output image
+ * @param width width of input image
+ * @param height height of input image
+ * @param op SECOND_ORDER_LOG or SECOND_ORDER_DOG
+ * @param sigma standard deviation of the (inner) Gaussian
+ * @param threshold threshold to apply
+ * @param strength_ratio ratio used to strengthen or weaken the edges
+ * @return 1 if any error occurs
+ */
+int detect_edges_zero_crossing(const ubyte *image, ubyte **edges_detected_image, size_t width, size_t height,
+                               second_order_operator op,
+                               double sigma,
+                               ubyte threshold,
+                               double strength_ratio) {
+    // Check if the input image and sigma are valid
+    if (image == nullptr || sigma <= 0) {
+        std::cout << "Invalid input image or sigma\n";
+        return 1;
+    }
+
+    *edges_detected_image = (ubyte *) malloc(width * height * sizeof(ubyte));
+
+    // check if the memory was allocated
+    if (*edges_detected_image == nullptr) {
+        std::cout << "Failed to allocate memory for the edge detected image!\n";
+        return 1;
+    }
+
+    ubyte table[SOBEL_MAGNITUDE_LEVELS];
+    build_edge_strength_table(threshold, strength_ratio, table);
+
+    second_order_plan plan = make_plan(op, sigma);
+    size_t stride = width + 2;
+
+    parallel_for(0, height, [&](size_t row_begin, size_t row_end, size_t) {
+        size_t halo_begin = row_begin > 0 ? row_begin - 1 : 0;
+        size_t halo_end = row_end < height ? row_end + 1 : height;
+
+        std::vector<float> responses((halo_end - halo_begin) * stride);
+        response_rows(image, width, height, plan, halo_begin, halo_end, responses.data());
+
+        std::vector<float> zeros(stride, 0.0f), strength(width);
+
+        for (size_t i = row_begin; i < row_end; i++) {
+            const float *row = responses.data() + (i - halo_begin) * stride + 1;
+            const float *above = i > 0 ? row - stride : zeros.data() + 1;
+            const float *below = i + 1 < height ? row + stride : zeros.data() + 1;
+
+            // the neighbors before the pixel win ties, the ones after it lose them
+            for (size_t j = 0; j < width; j++) {
+                float value = row[j], magnitude = fabsf(value), best = 0;
+                float neighbors[4] = {row[j - 1], above[j], row[j + 1], below[j]};
+                for (int n = 0; n < 4; n++) {
+                    float neighbor = neighbors[n];
+                    bool closer = n < 2 ? magnitude < fabsf(neighbor) : magnitude <= fabsf(neighbor);
+                    bool crossing = (value < 0) != (neighbor < 0) && neighbor != 0 && closer;
+                    float slope = crossing ? fabsf(value - neighbor) : 0.0f;
+                    best = slope > best ? slope : best;
+                }
+                strength[j] = best * plan.strength_scale;
+            }
+
+            ubyte *output = *edges_detected_image + i * width;
+            for (size_t j = 0; j < width; j++) {
+                float level = strength[j] < SOBEL_MAGNITUDE_LEVELS - 1 ? strength[j] : SOBEL_MAGNITUDE_LEVELS - 1;
+                output[j] = table[(size_t) (level + 0.5f)];
+            }
+        }
+    }, MIN_BAND_ROWS);
+
+    return 0;
+}
@@ -8,10 +8,18 @@ typedef signed short int16;
 
 #include <iostream>
 #include <climits>
+#include "pixel_traits.h"
 
 int
 change_brightness(const ubyte *gray_scaled_img, ubyte **brightness_changed_img, size_t width, size_t height,
                   size_t channels,
                   byte brightness_change);
 
+// instantiated for ubyte, uint16 and float pixels
+template<typename Pixel>
+int
+change_brightness(const Pixel *gray_scaled_img, Pixel **brightness_changed_img, size_t width, size_t height,
+                  size_t channels,
+                  double brightness_change);
+
 #endif //BRIGHTNESS_FILTER_H
@@ -0,0 +1,20 @@
+#include <cstddef>
+#include <cstdlib>
+#include <cmath>
+
+#ifndef CANNY_FILTER_H
+#define CANNY_FILTER_H
+
+
+typedef unsigned char ubyte;
+
+// largest gradient magnitude, the Sobel gradients are not clipped: hypot(1020, 1020) truncates to 1442
+#define CANNY_MAX_MAGNITUDE 1442
+
+
+int detect_edges_canny(const ubyte *image, ubyte **edges_detected_image, size_t width, size_t height,
+                       unsigned short low_threshold,
+                       unsigned short high_threshold,
+                       bool smooth);
+
+#endif //CANNY_FILTER_H
@@ -0,0 +1,25 @@
+#include <cstddef>
+#include <cstdlib>
+
+#ifndef CONNECTED_COMPONENTS_H
+#define CONNECTED_COMPONENTS_H
+
+
+typedef unsigned char ubyte;
+
+/**
+ * Statistics of a connected component (label 1 is stored at index 0).
+ */
+struct component_stats {
+    unsigned int label;
+    size_t area;
+    size_t min_x, min_y, max_x, max_y;
+    double centroid_x, centroid_y;
+};
+
+
+int label_components(const ubyte *edges, unsigned int **labels, component_stats **stats, size_t *count,
+                     size_t width, size_t height,
+                     ubyte threshold);
+
+#endif //CONNECTED_COMPONENTS_H
@@ -0,0 +1,37 @@
+#include <cstddef>
+#include <cstdlib>
+#include <cmath>
+
+#ifndef CORNER_DETECTOR_H
+#define CORNER_DETECTOR_H
+
+
+typedef unsigned char ubyte;
+
+enum corner_response {
+    CORNER_HARRIS,
+    CORNER_SHI_TOMASI
+};
+
+/**
+ * A corner and the strength of its response.
+ */
+struct corner {
+    size_t x, y;
+    float response;
+};
+
+
+int detect_edges_and_corners(const ubyte *image, ubyte **edges_detected_image,
+                             corner **corners, size_t *count,
+                             size_t width, size_t height,
+                             ubyte threshold,
+                             double strength_ratio,
+                             corner_response response,
+                             size_t window,
+                             double harris_k,
+                             double quality,
+                             size_t min_distance,
+                             size_t max_corners);
+
+#endif //CORNER_DETECTOR_H
@@ -0,0 +1,15 @@
+#include <cstddef>
+#include <cstdlib>
+#include <cmath>
+
+#ifndef DISTANCE_TRANSFORM_H
+#define DISTANCE_TRANSFORM_H
+
+
+typedef unsigned char ubyte;
+
+
+int distance_transform(const ubyte *edges, float **distances, size_t width, size_t height,
+                       ubyte threshold);
+
+#endif //DISTANCE_TRANSFORM_H
@@ -0,0 +1,33 @@
+#include <cstddef>
+#include <cstdlib>
+#include <cmath>
+
+#ifndef EDGE_OPERATORS_H
+#define EDGE_OPERATORS_H
+
+
+typedef unsigned char ubyte;
+typedef signed short int16;
+
+enum edge_operator {
+    OPERATOR_SOBEL,
+    OPERATOR_SCHARR,
+    OPERATOR_PREWITT,
+    OPERATOR_ROBERTS,
+    OPERATOR_SOBEL_5,
+    OPERATOR_SOBEL_7
+};
+
+
+void operator_gradient_row(edge_operator op, const ubyte *image, size_t width, size_t height, size_t row,
+                           int16 *gx, int16 *gy);
+
+int compute_operator_gradients(const ubyte *image, int16 **gx, int16 **gy, size_t width, size_t height,
+                               edge_operator op);
+
+int detect_edges_operator(const ubyte *image, ubyte **edges_detected_image, size_t width, size_t height,
+                          edge_operator op,
+                          ubyte threshold,
+                          double strength_ratio);
+
+#endif //EDGE_OPERATORS_H
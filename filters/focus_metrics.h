@@ -0,0 +1,27 @@
+#include <cstddef>
+#include <cstdlib>
+#include <cmath>
+
+#ifndef FOCUS_METRICS_H
+#define FOCUS_METRICS_H
+
+
+typedef unsigned char ubyte;
+
+/**
+ * Sharpness of an image or of a tile, the higher the sharper.
+ */
+struct focus_metrics {
+    double tenengrad;            // mean of the squared Sobel gradient magnitude
+    double laplacian_variance;   // variance of the 4-neighbor Laplacian
+    double edge_density;         // fraction of the pixels whose Sobel magnitude is above the threshold
+};
+
+
+int compute_focus_metrics(const ubyte *image, size_t width, size_t height,
+                          ubyte threshold,
+                          size_t tile_size,
+                          focus_metrics *metrics,
+                          focus_metrics **tile_metrics, size_t *tiles_x, size_t *tiles_y);
+
+#endif //FOCUS_METRICS_H
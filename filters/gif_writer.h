@@ -0,0 +1,13 @@
+#include <cstddef>
+#include <cstdlib>
+
+#ifndef GIF_WRITER_H
+#define GIF_WRITER_H
+
+
+typedef unsigned char ubyte;
+
+int write_gray_gif(const char *path, const ubyte *const *frames, size_t count, size_t width, size_t height,
+                   const int *delays);
+
+#endif //GIF_WRITER_H
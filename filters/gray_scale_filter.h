@@ -2,12 +2,30 @@
 #define GRAY_SCALE_FILTER_H
 
 #include <cstdio>
+#include "pixel_traits.h"
 
 typedef unsigned char ubyte;
 
+enum alpha_mode {
+    ALPHA_IGNORE,
+    ALPHA_PREMULTIPLY
+};
+
 int
 convert_to_gray_scale(const ubyte *image, ubyte **gray_scaled_image, size_t width, size_t height,
                       size_t channels);
 
+int
+convert_to_gray_scale(const ubyte *image, ubyte **gray_scaled_image, size_t width, size_t height,
+                      size_t channels,
+                      alpha_mode alpha);
+
+// instantiated for ubyte, uint16 and float pixels
+template<typename Pixel>
+int
+convert_to_gray_scale(const Pixel *image, Pixel **gray_scaled_image, size_t width, size_t height,
+                      size_t channels,
+                      alpha_mode alpha = ALPHA_IGNORE);
+
 
 #endif //GRAY_SCALE_FILTER_H
@@ -0,0 +1,31 @@
+#include <cstddef>
+#include <cstdlib>
+#include <cmath>
+
+#ifndef HOUGH_TRANSFORM_H
+#define HOUGH_TRANSFORM_H
+
+
+typedef unsigned char ubyte;
+typedef signed short int16;
+
+/**
+ * A line in normal form: x * cos(theta) + y * sin(theta) = rho.
+ */
+struct hough_line {
+    double rho;
+    double theta;
+    unsigned int votes;
+};
+
+
+int detect_lines(const ubyte *edges, size_t width, size_t height,
+                 ubyte threshold,
+                 const int16 *gx, const int16 *gy,
+                 double angle_window,
+                 size_t theta_bins,
+                 unsigned int min_votes,
+                 size_t max_lines,
+                 hough_line **lines, size_t *count);
+
+#endif //HOUGH_TRANSFORM_H
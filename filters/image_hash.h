@@ -0,0 +1,42 @@
+#include <cstddef>
+#include <cstdlib>
+#include <cmath>
+
+#ifndef IMAGE_HASH_H
+#define IMAGE_HASH_H
+
+
+typedef unsigned char ubyte;
+typedef unsigned long long hash64;
+
+// size of the gray scale thumbnail every hash is computed from
+#define HASH_THUMBNAIL_SIZE 32
+
+enum hash_method {
+    HASH_AVERAGE,
+    HASH_DIFFERENCE,
+    HASH_PERCEPTUAL
+};
+
+
+int gray_scale_thumbnail(const ubyte *image, size_t width, size_t height, size_t channels,
+                         float *thumbnail);
+
+hash64 thumbnail_hash(const float *thumbnail, hash_method method);
+
+int compute_image_hash(const ubyte *image, size_t width, size_t height, size_t channels,
+                       hash_method method,
+                       hash64 *hash);
+
+/**
+ * Returns the number of bits two hashes differ in.
+ */
+inline unsigned int hash_distance(hash64 a, hash64 b) {
+    return (unsigned int) __builtin_popcountll(a ^ b);
+}
+
+int find_similar_hashes(const hash64 *hashes, size_t count, hash64 query,
+                        unsigned int max_distance,
+                        size_t **matches, size_t *match_count);
+
+#endif //IMAGE_HASH_H
@@ -0,0 +1,26 @@
+#include <cstddef>
+#include <cstdlib>
+#include <cmath>
+
+#ifndef INTEGRAL_IMAGE_H
+#define INTEGRAL_IMAGE_H
+
+
+typedef unsigned char ubyte;
+
+enum adaptive_mode {
+    ADAPTIVE_MEAN,
+    ADAPTIVE_SAUVOLA
+};
+
+
+int build_integral_image(const ubyte *image, unsigned long long **sums, unsigned long long **squared_sums,
+                         size_t width, size_t height);
+
+int adaptive_threshold(const ubyte *edges, ubyte **thresholded_image, size_t width, size_t height,
+                       size_t window,
+                       adaptive_mode mode,
+                       double k,
+                       double strength_ratio);
+
+#endif //INTEGRAL_IMAGE_H
@@ -0,0 +1,13 @@
+#include <cstddef>
+#include <cstdlib>
+
+#ifndef JPEG_DECODER_H
+#define JPEG_DECODER_H
+
+
+typedef unsigned char ubyte;
+
+int decode_jpeg_gray_scaled(const ubyte *data, size_t size, size_t reduction,
+                            ubyte **image, size_t *width, size_t *height);
+
+#endif //JPEG_DECODER_H
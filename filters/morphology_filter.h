@@ -0,0 +1,28 @@
+#include <cstddef>
+#include <cstdlib>
+
+#ifndef MORPHOLOGY_FILTER_H
+#define MORPHOLOGY_FILTER_H
+
+
+typedef unsigned char ubyte;
+
+enum morphology_operation {
+    MORPHOLOGY_DILATE,
+    MORPHOLOGY_ERODE,
+    MORPHOLOGY_CLOSE,
+    MORPHOLOGY_OPEN
+};
+
+
+int apply_morphology(const ubyte *image, ubyte **result_image, size_t width, size_t height,
+                     size_t element_width, size_t element_height,
+                     morphology_operation operation);
+
+int detect_edges_morphology(const ubyte *image, ubyte **edges_detected_image, size_t width, size_t height,
+                            ubyte threshold,
+                            double strength_ratio,
+                            size_t element_width, size_t element_height,
+                            morphology_operation operation);
+
+#endif //MORPHOLOGY_FILTER_H
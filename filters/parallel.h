@@ -0,0 +1,79 @@
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+
+/**
+ * Returns the number of worker threads the CPU filters split their work into.
+ *
+ * @return The number of hardware threads, or 1 if it cannot be determined.
+ */
+inline size_t worker_count() {
+    unsigned int n = std::thread::hardware_concurrency();
+    return n == 0 ? 1 : n;
+}
+
+/**
+ * Returns whether the calling thread is running a band of a parallel_for.
+ */
+inline bool &inside_parallel_band() {
+    static thread_local bool inside = false;
+    return inside;
+}
+
+/**
+ * Splits the range [begin, end) into contiguous bands and runs the body on each band in its own thread.
+ *
+ * The body is called as body(band_begin, band_end, worker), where worker is a unique index in
+ * [0, worker_count()) that can be used to address per-thread scratch buffers. The calling thread
+ * processes the last band itself and returns once every band is finished. A parallel_for called
+ * from inside a band runs serially on its thread, so the filters can be run in parallel on whole
+ * images (e.g. the frames of an animation) without multiplying the threads.
+ *
+ * @param begin The first index of the range.
+ * @param end One past the last index of the range.
+ * @param body The callable applied to every band.
+ * @param min_band The minimum number of indices per band (avoids spawning threads for tiny ranges).
+ */
+template<typename Body>
+void parallel_for(size_t begin, size_t end, Body body, size_t min_band = 1) {
+    if (end <= begin) return;
+
+    size_t total = end - begin;
+    if (min_band == 0) min_band = 1;
+
+    size_t bands = worker_count();
+    if (bands > (total + min_band - 1) / min_band) bands = (total + min_band - 1) / min_band;
+    if (bands <= 1 || inside_parallel_band()) {
+        body(begin, end, (size_t) 0);
+        return;
+    }
+
+    auto band = [&body](size_t band_begin, size_t band_end, size_t worker) {
+        bool &inside = inside_parallel_band();
+        inside = true;
+        body(band_begin, band_end, worker);
+        inside = false;
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(bands - 1);
+
+    size_t band_size = total / bands, remainder = total % bands, band_begin = begin;
+    for (size_t worker = 0; worker < bands; worker++) {
+        size_t band_end = band_begin + band_size + (worker < remainder ? 1 : 0);
+        if (worker + 1 == bands) {
+            band(band_begin, band_end, worker);
+        } else {
+            threads.emplace_back(band, band_begin, band_end, worker);
+        }
+        band_begin = band_end;
+    }
+
+    for (auto &thread: threads) thread.join();
+}
+
+#endif //PARALLEL_H
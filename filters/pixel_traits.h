@@ -0,0 +1,63 @@
+#include <cstddef>
+#include <climits>
+#include <cfloat>
+
+#ifndef PIXEL_TRAITS_H
+#define PIXEL_TRAITS_H
+
+
+typedef unsigned char ubyte;
+typedef unsigned short uint16;
+
+/**
+ * The properties of a pixel type the filters are instantiated for: 8 bit and 16 bit integer pixels,
+ * and float pixels of HDR images.
+ *
+ * integer: whether the results are truncated and saturated to [0, max] like for 8 bit pixels.
+ * max: the brightest pixel value (float pixels are only bounded below, so HDR values above 1 are kept).
+ * opaque: the value of a fully opaque alpha channel.
+ * arithmetic: the type the filters compute with, wide enough for the Sobel responses of the pixel type.
+ * real: the type of the weighted sums (double for integer pixels, so the truncation is the one of 8 bit pixels).
+ */
+template<typename Pixel>
+struct pixel_traits;
+
+template<>
+struct pixel_traits<ubyte> {
+    static constexpr bool integer = true;
+    static constexpr double max = UCHAR_MAX;
+    static constexpr double opaque = UCHAR_MAX;
+    typedef int arithmetic;
+    typedef double real;
+};
+
+template<>
+struct pixel_traits<uint16> {
+    static constexpr bool integer = true;
+    static constexpr double max = USHRT_MAX;
+    static constexpr double opaque = USHRT_MAX;
+    typedef int arithmetic;
+    typedef double real;
+};
+
+template<>
+struct pixel_traits<float> {
+    static constexpr bool integer = false;
+    static constexpr double max = FLT_MAX;
+    static constexpr double opaque = 1;
+    typedef float arithmetic;
+    typedef float real;
+};
+
+/**
+ * Converts a result of a filter to a pixel: negative values become 0, and integer pixels are
+ * saturated to max and truncated.
+ */
+template<typename Pixel, typename Value>
+static inline Pixel to_pixel(Value value) {
+    if (value <= 0) return (Pixel) 0;
+    if (pixel_traits<Pixel>::integer && value >= (Value) pixel_traits<Pixel>::max) return (Pixel) pixel_traits<Pixel>::max;
+    return (Pixel) value;
+}
+
+#endif //PIXEL_TRAITS_H
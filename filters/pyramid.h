@@ -0,0 +1,37 @@
+#include <cstddef>
+#include <cstdlib>
+#include <cmath>
+
+#ifndef PYRAMID_H
+#define PYRAMID_H
+
+
+typedef unsigned char ubyte;
+
+/**
+ * A level of an image pyramid (level 0 has the size of the input image).
+ */
+struct pyramid_level {
+    ubyte *image;
+    size_t width, height;
+};
+
+
+int pyramid_down(const ubyte *image, ubyte **reduced_image, size_t width, size_t height);
+
+int build_pyramid(const ubyte *image, size_t width, size_t height, size_t levels,
+                  pyramid_level **pyramid, size_t *count);
+
+void free_pyramid(pyramid_level *pyramid, size_t count);
+
+int detect_edges_multiscale(const ubyte *image, size_t width, size_t height, size_t levels,
+                            ubyte threshold,
+                            double strength_ratio,
+                            pyramid_level **edges, size_t *count);
+
+int detect_edges_multiscale_max(const ubyte *image, ubyte **edges_detected_image, size_t width, size_t height,
+                                size_t levels,
+                                ubyte threshold,
+                                double strength_ratio);
+
+#endif //PYRAMID_H
@@ -0,0 +1,21 @@
+#include <cstddef>
+#include <cstdlib>
+#include <cmath>
+
+#ifndef RESIZE_FILTER_H
+#define RESIZE_FILTER_H
+
+
+typedef unsigned char ubyte;
+
+enum resize_method {
+    RESIZE_AREA,
+    RESIZE_BILINEAR
+};
+
+
+int resize_image(const ubyte *image, ubyte **resized_image, size_t width, size_t height, size_t channels,
+                 size_t resized_width, size_t resized_height,
+                 resize_method method);
+
+#endif //RESIZE_FILTER_H
@@ -0,0 +1,52 @@
+#include <cstddef>
+#include <cstdlib>
+#include <cmath>
+
+#ifndef ROI_FILTER_H
+#define ROI_FILTER_H
+
+
+typedef unsigned char ubyte;
+
+/**
+ * A rectangular region of interest.
+ */
+struct roi {
+    size_t x, y, width, height;
+};
+
+/**
+ * A run of consecutive pixels [begin, end) of a row.
+ */
+struct pixel_run {
+    size_t row, begin, end;
+};
+
+
+int rois_to_runs(const roi *rois, size_t roi_count, size_t width, size_t height,
+                 pixel_run **runs, size_t *count);
+
+int mask_to_runs(const ubyte *mask, size_t width, size_t height,
+                 pixel_run **runs, size_t *count);
+
+int update_edges_runs(const ubyte *image, ubyte *edges_detected_image, size_t width, size_t height,
+                      const pixel_run *runs, size_t count,
+                      ubyte threshold,
+                      double strength_ratio);
+
+int detect_edges_runs(const ubyte *image, ubyte **edges_detected_image, size_t width, size_t height,
+                      const pixel_run *runs, size_t count,
+                      ubyte threshold,
+                      double strength_ratio);
+
+int detect_edges_roi(const ubyte *image, ubyte **edges_detected_image, size_t width, size_t height,
+                     const roi *rois, size_t roi_count,
+                     ubyte threshold,
+                     double strength_ratio);
+
+int detect_edges_masked(const ubyte *image, ubyte **edges_detected_image, size_t width, size_t height,
+                        const ubyte *mask,
+                        ubyte threshold,
+                        double strength_ratio);
+
+#endif //ROI_FILTER_H
@@ -0,0 +1,20 @@
+#include <cstddef>
+#include <cstdlib>
+#include <cmath>
+
+#ifndef SMOOTHING_FILTER_H
+#define SMOOTHING_FILTER_H
+
+
+typedef unsigned char ubyte;
+
+
+int gaussian_blur(const ubyte *image, ubyte **blurred_image, size_t width, size_t height,
+                  double sigma);
+
+int detect_edges_smoothed(const ubyte *image, ubyte **edges_detected_image, size_t width, size_t height,
+                          double sigma,
+                          ubyte threshold,
+                          double strength_ratio);
+
+#endif //SMOOTHING_FILTER_H
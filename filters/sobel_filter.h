@@ -3,6 +3,7 @@
 #include <cmath>
 #include <cassert>
 #include <climits>
+#include "pixel_traits.h"
 
 #ifndef SOBEL_FILTER_H
 #define SOBEL_FILTER_H
@@ -10,6 +11,20 @@
 
 typedef char byte;
 typedef unsigned char ubyte;
+typedef signed short int16;
+
+// number of distinct Sobel magnitudes, hypot(255, 255) truncates to 360
+#define SOBEL_MAGNITUDE_LEVELS 361
+
+enum threshold_mode {
+    THRESHOLD_OTSU,
+    THRESHOLD_PERCENTILE
+};
+
+enum color_edge_mode {
+    COLOR_EDGES_MAX_CHANNEL,
+    COLOR_EDGES_DI_ZENZO
+};
 
 
 int detect_edges(const ubyte *image, ubyte **edges_detected_image, size_t width, size_t height,
@@ -17,4 +32,61 @@ int detect_edges(const ubyte *image, ubyte **edges_detected_image, size_t width,
                  double strength_ratio,
                  short dir);
 
+// instantiated for ubyte, uint16 and float pixels, the threshold is in the units of the pixel type
+template<typename Pixel>
+int detect_edges(const Pixel *image, Pixel **edges_detected_image, size_t width, size_t height,
+                 double threshold,
+                 double strength_ratio,
+                 short dir);
+
+int detect_edges_color(const ubyte *image, ubyte **edges_detected_image, size_t width, size_t height,
+                       size_t channels,
+                       color_edge_mode mode,
+                       ubyte threshold,
+                       double strength_ratio);
+
+void sobel_gradient_row(const ubyte *above, const ubyte *row, const ubyte *below,
+                        int16 *gx, int16 *gy,
+                        size_t width);
+
+int compute_gradients(const ubyte *image, int16 **gx, int16 **gy, size_t width, size_t height);
+
+void sobel_magnitude_row(const int16 *gx, const int16 *gy, unsigned short *magnitudes, size_t width);
+
+int compute_magnitudes(const ubyte *image, unsigned short **magnitudes, size_t width, size_t height,
+                       unsigned long long *histogram);
+
+ubyte otsu_threshold(const unsigned long long *histogram);
+
+ubyte percentile_threshold(const unsigned long long *histogram, double percentile);
+
+void build_edge_strength_table(ubyte threshold, double strength_ratio, ubyte *table);
+
+int apply_edge_strength(const unsigned short *magnitudes, ubyte **edges_detected_image, size_t width, size_t height,
+                        ubyte threshold,
+                        double strength_ratio);
+
+int apply_edge_strength_gradients(const int16 *gx, const int16 *gy, ubyte **edges_detected_image,
+                                  size_t width, size_t height,
+                                  ubyte threshold,
+                                  double strength_ratio);
+
+int apply_edge_strength_sweep(const unsigned short *magnitudes, ubyte **edges_detected_images, size_t count,
+                              size_t width, size_t height,
+                              const ubyte *thresholds,
+                              const double *strength_ratios);
+
+int detect_edges_skip_flat(const ubyte *image, ubyte **edges_detected_image, size_t width, size_t height,
+                           ubyte threshold,
+                           double strength_ratio,
+                           short dir,
+                           ubyte tolerance,
+                           double *skipped_ratio);
+
+int detect_edges_auto(const ubyte *image, ubyte **edges_detected_image, size_t width, size_t height,
+                      threshold_mode mode,
+                      double percentile,
+                      double strength_ratio,
+                      ubyte *threshold);
+
 #endif //SOBEL_FILTER_H
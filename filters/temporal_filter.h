@@ -0,0 +1,36 @@
+#include <cstddef>
+#include <cstdlib>
+#include <cmath>
+
+#ifndef TEMPORAL_FILTER_H
+#define TEMPORAL_FILTER_H
+
+
+typedef unsigned char ubyte;
+
+/**
+ * The state of a sequence of frames: the last input every tile was computed from and the last edges.
+ */
+struct edge_sequence {
+    size_t width, height;
+    ubyte threshold;
+    double strength_ratio;
+    ubyte tolerance;
+    bool started;
+    ubyte *reference;
+    ubyte *edges;
+};
+
+
+int create_edge_sequence(size_t width, size_t height,
+                         ubyte threshold,
+                         double strength_ratio,
+                         ubyte tolerance,
+                         edge_sequence **sequence);
+
+int detect_edges_sequence(edge_sequence *sequence, const ubyte *image, ubyte **edges_detected_image,
+                          double *reuse_ratio);
+
+void free_edge_sequence(edge_sequence *sequence);
+
+#endif //TEMPORAL_FILTER_H
@@ -0,0 +1,56 @@
+#include <cstddef>
+#include <cstdlib>
+#include <cstdio>
+
+#ifndef VIDEO_IO_H
+#define VIDEO_IO_H
+
+
+typedef unsigned char ubyte;
+
+enum video_format {
+    VIDEO_Y4M,
+    VIDEO_I420,
+    VIDEO_NV12
+};
+
+/**
+ * A stream of 8 bit YUV frames read from a file or from stdin.
+ */
+struct video_reader {
+    FILE *file;
+    video_format format;
+    size_t width, height;
+    size_t chroma_size;          // bytes of chroma after the luma plane of every frame
+    char parameters[256];        // the frame rate, interlacing and aspect ratio of a Y4M header
+    ubyte *chroma;               // scratch buffer the chroma is read into and dropped
+};
+
+/**
+ * A stream of 8 bit YUV frames written to a file or to stdout.
+ */
+struct video_writer {
+    FILE *file;
+    video_format format;
+    size_t width, height;
+    ubyte *chroma;               // neutral chroma written after every luma plane
+    size_t chroma_size;
+};
+
+
+int open_video_reader(const char *path, video_format format, size_t width, size_t height,
+                      video_reader **reader);
+
+int read_video_frame(video_reader *reader, ubyte *luma, bool *end_of_stream);
+
+void close_video_reader(video_reader *reader);
+
+int open_video_writer(const char *path, video_format format, size_t width, size_t height,
+                      const char *parameters,
+                      video_writer **writer);
+
+int write_video_frame(video_writer *writer, const ubyte *luma);
+
+void close_video_writer(video_writer *writer);
+
+#endif //VIDEO_IO_H
@@ -0,0 +1,23 @@
+#include <cstddef>
+#include <cstdlib>
+#include <cmath>
+
+#ifndef ZERO_CROSSING_FILTER_H
+#define ZERO_CROSSING_FILTER_H
+
+
+typedef unsigned char ubyte;
+
+enum second_order_operator {
+    SECOND_ORDER_LOG,
+    SECOND_ORDER_DOG
+};
+
+
+int detect_edges_zero_crossing(const ubyte *image, ubyte **edges_detected_image, size_t width, size_t height,
+                               second_order_operator op,
+                               double sigma,
+                               ubyte threshold,
+                               double strength_ratio);
+
+#endif //ZERO_CROSSING_FILTER_H
@@ -4,56 +4,67 @@
 #define GRID_SIZE 1024
 #define BLOCK_SIZE 1024
 
-#define CHANNELS_NUM 3
-
 /**
  * Converts a color image to grayscale using CUDA kernel parallelization.
  *
- * The input image is assumed to have 3 color channels (red, green, and blue) per pixel,
+ * The input image has 1 to 4 channels per pixel (gray, gray and alpha, RGB or RGBA),
  * and the output grayscale image is stored in a separate buffer allocated by the caller.
  *
  * @param image A pointer to the input image data.
  * @param gray_scaled_image A pointer to a buffer that will hold the resulting grayscale image data.
  * @param width The width of the image in pixels.
  * @param height The height of the image in pixels.
+ * @param channels The number of channels per pixel, the alpha channel is the last one.
+ * @param premultiply Whether the gray value is multiplied by the alpha channel.
  */
 __global__
-static void convert_to_gray_scale_kernel(const ubyte *image, ubyte *gray_scaled_image, size_t width, size_t height) {
+static void convert_to_gray_scale_kernel(const ubyte *image, ubyte *gray_scaled_image, size_t width, size_t height,
+                                         size_t channels, bool premultiply) {
     // Calculate the index of the current pixel in the image
     size_t i = blockIdx.x * blockDim.x + threadIdx.x;
 
     // Only execute the kernel for valid pixel indices
     if (i < width * height) {
         // Calculate the index of the current pixel in the input image
-        size_t image_index = i * CHANNELS_NUM;
+        size_t image_index = i * channels;
 
         // Convert the pixel to grayscale using the specified weights for each channel
-        gray_scaled_image[i] = (ubyte) (0.21 * image[image_index] +
+        double value = channels >= 3 ? 0.21 * image[image_index] +
                                        0.72 * image[image_index + 1] +
-                                       0.07 * image[image_index + 2]);
+                                       0.07 * image[image_index + 2]
+                                     : (double) image[image_index];
+
+        // Multiply by the opacity
+        if (premultiply && channels % 2 == 0) value = value * image[image_index + channels - 1] / 255;
+
+        gray_scaled_image[i] = (ubyte) value;
     }
 }
 
 /**
  * Converts a color image to grayscale.
  *
- * The input image is assumed to have 3 color channels (red, green, and blue) per pixel.
+ * The input image has 1 (gray), 2 (gray and alpha), 3 (red, green and blue) or 4 (red, green, blue
+ * and alpha) channels per pixel. The alpha channel is ignored, or with ALPHA_PREMULTIPLY the gray
+ * value is multiplied by the opacity.
  * The output grayscale image is stored in a separate buffer allocated by this function.
  *
  * @param image A pointer to the input image data.
  * @param gray_scaled_image A pointer to a buffer that will hold the resulting grayscale image data.
  * @param width The width of the image in pixels.
  * @param height The height of the image in pixels.
- * @param channels The number of color channels per pixel in the input image (should be 3 for RGB images).
+ * @param channels The number of channels per pixel in the input image (1 to 4, the alpha channel is the last one).
+ * @param alpha ALPHA_IGNORE or ALPHA_PREMULTIPLY.
  * @return 0 if the conversion succeeded, or 1 if memory allocation failed.
  */
 int convert_to_gray_scale(const ubyte *image, ubyte **gray_scaled_image, size_t width, size_t height,
-                          size_t channels) {
+                          size_t channels,
+                          alpha_mode alpha) {
 
 
     // Check if the input image and channels are valid
-    if (image == nullptr || channels != 3) {
-        std::cout << "Invalid input image or number of channels. Expected a 3-channel RGB image.\n";
+    if (image == nullptr || channels == 0 || channels > 4) {
+        std::cout << "Invalid input image or number of channels. Expected a gray, gray and alpha, RGB or RGBA image.\n";
         return 1;
     }
 
@@ -86,7 +97,8 @@ int convert_to_gray_scale(const ubyte *image, ubyte **gray_scaled_image, size_t
     convert_to_gray_scale_kernel<<<number_of_blocks, BLOCK_SIZE>>>
             (
                     d_image, d_gray_scaled_image,
-                    width, height
+                    width, height,
+                    channels, alpha == ALPHA_PREMULTIPLY
             );
 
     // copy the gray scaled image to the host
@@ -100,3 +112,11 @@ int convert_to_gray_scale(const ubyte *image, ubyte **gray_scaled_image, size_t
 
     return 0;
 }
+
+/**
+ * Converts a color image to grayscale, ignoring the alpha channel (see above).
+ */
+int convert_to_gray_scale(const ubyte *image, ubyte **gray_scaled_image, size_t width, size_t height,
+                          size_t channels) {
+    return convert_to_gray_scale(image, gray_scaled_image, width, height, channels, ALPHA_IGNORE);
+}
@@ -53,7 +53,7 @@ int main(int argc, char *argv[]) {
         SET_OR_DEFAULT(argv[2], input_filename, DEFAULT_INPUT_FILENAME)
         SET_OR_DEFAULT(argv[3], result_path, DEFAULT_RESULT_PATH)
 
-        if (!IS_PNG(input_filename)) { ERROR_COUT_AND_RETURN(INVALID_FILE_TYPE) }
+        if (!IS_IMAGE(input_filename)) { ERROR_COUT_AND_RETURN(INVALID_FILE_TYPE) }
 
         // concat the path and filename
         strcat(input_path, input_filename);
@@ -62,13 +62,14 @@ int main(int argc, char *argv[]) {
         if (!PATH_EXISTS(result_path)) { ERROR_COUT_AND_RETURN(INVALID_RESULT_PATH) }
 
         // concat the result path and filename without the .png
-        input_filename[strlen(input_filename) - 4] = '\0';
+        REMOVE_EXTENSION(input_filename)
         strcat(result_path, input_filename);
         strcat(result_path, "_bright.png");
 
         // the fourth arg is the brightness change
-        brightness_change = (byte) strtol(argv[4], nullptr, 10);
-        if (brightness_change < 0 || brightness_change > 127) { ERROR_COUT_AND_RETURN(INVALID_BRIGHTNESS_CHANGE) }
+        long brightness_value = strtol(argv[4], nullptr, 10);
+        if (brightness_value < -128 || brightness_value > 127) { ERROR_COUT_AND_RETURN(INVALID_BRIGHTNESS_CHANGE) }
+        brightness_change = (byte) brightness_value;
 
     } else if (argc == 1) {
         // use default values
@@ -79,13 +80,12 @@ int main(int argc, char *argv[]) {
         brightness_change = BRIGHTNESS_DEFAULT;
 
 
-        if (!IS_PNG(input_filename)) { ERROR_COUT_AND_RETURN(INVALID_FILE_TYPE) }
+        if (!IS_IMAGE(input_filename)) { ERROR_COUT_AND_RETURN(INVALID_FILE_TYPE) }
         if (!PATH_EXISTS(input_path)) { ERROR_COUT_AND_RETURN(INVALID_FILE_PATH) }
         if (!PATH_EXISTS(result_path)) { ERROR_COUT_AND_RETURN(INVALID_RESULT_PATH) }
-        if (brightness_change < 0 || brightness_change > 127) { ERROR_COUT_AND_RETURN(INVALID_BRIGHTNESS_CHANGE) }
 
         // remove the .png from the filename
-        input_filename[strlen(input_filename) - 4] = '\0';
+        REMOVE_EXTENSION(input_filename)
         strcat(result_path, input_filename);
         strcat(result_path, "_bright.png");
 
@@ -0,0 +1,168 @@
+
+#include <iostream>
+#include <chrono>
+#include <filesystem>
+
+#define STB_IMAGE_IMPLEMENTATION
+
+
+#include "../stb/stb_image.h"
+
+#include "../filters/focus_metrics.h"
+
+#include "../config.h"
+
+#include "helper.cpp"
+
+namespace fs = std::filesystem;
+
+
+void guide() {
+    std::cout << "\033[1;33m" << "----------------------------------------\n" << "\033[0m";
+
+    std::cout << "\033[1;33m" << "GUIDE: " << "\033[0m\n";
+
+    std::cout << "\033[1;33m" << "No arguments were provided! Default values will be used!" << "\033[0m\n";
+    std::cout << "\033[1;33m"
+              << "Usage: ./focus_metrics_runner.out <input_path> <input_filename> <result_path> <threshold> <tile_size>"
+              << "\033[0m\n";
+
+    std::cout << "\033[1;33m" << "Default values: " << "\033[0m\n";
+    std::cout << "\033[1;33m" << "input_path: " << DEFAULT_INPUT_PATH << "\033[0m\n";
+    std::cout << "\033[1;33m" << "input_filename: " << DEFAULT_INPUT_FILENAME << "\033[0m\n";
+    std::cout << "\033[1;33m" << "result_path: " << DEFAULT_RESULT_PATH << "\033[0m\n";
+    std::cout << "\033[1;33m" << "threshold: " << SOBEL_THRESHOLD << "\033[0m\n";
+    std::cout << "\033[1;33m" << "tile_size: " << FOCUS_TILE_SIZE << "\033[0m\n";
+    std::cout << "\033[1;33m" << "Example: ./focus_metrics_runner.out - - - 50 0" << "\033[0m\n";
+
+    std::cout << "\033[1;33m" << "----------------------------------------\n" << "\033[0m\n";
+}
+
+int main(int argc, char *argv[]) {
+
+    char *input_filename = (char *) malloc(sizeof(char) * FILENAME_MAX);
+    char *result_path = (char *) malloc(sizeof(char) * (FILENAME_MAX + PATH_MAX));
+    char *input_path = (char *) malloc(sizeof(char) * (FILENAME_MAX + PATH_MAX));
+
+    ubyte threshold;
+    long tile_size;
+
+    if (argc == 6) {
+        SET_OR_DEFAULT(argv[1], input_path, DEFAULT_INPUT_PATH)
+        SET_OR_DEFAULT(argv[2], input_filename, DEFAULT_INPUT_FILENAME)
+        SET_OR_DEFAULT(argv[3], result_path, DEFAULT_RESULT_PATH)
+
+        if (!IS_IMAGE(input_filename)) { ERROR_COUT_AND_RETURN(INVALID_FILE_TYPE) }
+
+        // construct the input path
+        strcat(input_path, input_filename);
+
+        // check if the path is valid and the file exists
+        if (!PATH_EXISTS(input_path)) { ERROR_COUT_AND_RETURN(INVALID_FILE_PATH) }
+
+        // check if the result path is valid
+        if (!PATH_EXISTS(result_path)) { ERROR_COUT_AND_RETURN(INVALID_RESULT_PATH) }
+
+        // remove the extension
+        REMOVE_EXTENSION(input_filename)
+
+        strcat(result_path, input_filename);
+        strcat(result_path, "_focus.csv");
+
+        // fourth arg is the threshold
+        int threshold_value = atoi(argv[4]);
+        if (threshold_value < 0 || threshold_value > 255) { ERROR_COUT_AND_RETURN(INVALID_THRESHOLD) }
+        threshold = (ubyte) threshold_value;
+
+        // fifth arg is the tile size
+        tile_size = strcmp(argv[5], "-") == 0 ? FOCUS_TILE_SIZE : atol(argv[5]);
+        if (tile_size < 0) { ERROR_COUT_AND_RETURN(INVALID_TILE_SIZE) }
+
+    } else if (argc == 1) {
+        // use default values
+        strcpy(input_path, DEFAULT_INPUT_PATH);
+        strcpy(input_filename, DEFAULT_INPUT_FILENAME);
+        strcat(input_path, input_filename);
+        strcpy(result_path, DEFAULT_RESULT_PATH);
+        threshold = SOBEL_THRESHOLD;
+        tile_size = FOCUS_TILE_SIZE;
+
+        if (!IS_IMAGE(input_path)) { ERROR_COUT_AND_RETURN(INVALID_FILE_TYPE) }
+        if (!PATH_EXISTS(input_path)) { ERROR_COUT_AND_RETURN(INVALID_FILE_PATH) }
+        if (!PATH_EXISTS(result_path)) { ERROR_COUT_AND_RETURN(INVALID_RESULT_PATH) }
+        if (tile_size < 0) { ERROR_COUT_AND_RETURN(INVALID_TILE_SIZE) }
+
+
+        // remove the extension
+        REMOVE_EXTENSION(input_filename)
+        strcat(result_path, input_filename);
+        strcat(result_path, "_focus.csv");
+
+        guide();
+
+    } else {
+        ERROR_COUT_AND_RETURN(INVALID_ARGUMENTS)
+    }
+
+    // read the image
+    int width, height, bpp;
+    ubyte *image = stbi_load(input_path, &width, &height, &bpp, 1);
+
+    // start the timer
+    auto start = std::chrono::high_resolution_clock::now();
+
+    // compute the metrics, no output image is produced
+    focus_metrics metrics;
+    focus_metrics *tile_metrics;
+    size_t tiles_x, tiles_y;
+    compute_focus_metrics(
+            image,
+            width, height,
+            threshold,
+            (size_t) tile_size,
+            &metrics,
+            &tile_metrics, &tiles_x, &tiles_y);
+
+    // stop the timer
+    auto finish = std::chrono::high_resolution_clock::now();
+
+    // write the metrics of the tiles
+    if (tiles_x > 0) {
+        FILE *tiles_file = fopen(result_path, "w");
+        if (tiles_file == nullptr) { ERROR_COUT_AND_RETURN(INVALID_RESULT_PATH) }
+        fprintf(tiles_file, "x,y,tenengrad,laplacian_variance,edge_density\n");
+        for (size_t t = 0; t < tiles_x * tiles_y; t++) {
+            fprintf(tiles_file, "%zu,%zu,%g,%g,%g\n", (t % tiles_x) * tile_size, (t / tiles_x) * tile_size,
+                    tile_metrics[t].tenengrad, tile_metrics[t].laplacian_variance, tile_metrics[t].edge_density);
+        }
+        fclose(tiles_file);
+    }
+
+
+    std::cout << "\033[1;34m" << "----------------------------------------\n" << "\033[0m";
+    std::cout << "\033[1;34m" << "REPORT: " << "\033[0m\n";
+
+    std::cout << "\033[1;34m" << "Time: "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(finish - start).count()
+              << "ms\n" << "\033[0m";
+    std::cout << "\033[1;34m" << "----------------------------------------\n" << "\033[0m\n";
+
+    std::cout << "\033[1;32m" << "----------------------------------------\n" << "\033[0m";
+    std::cout << "\033[1;32m" << "RESULT: " << "\033[0m\n";
+    std::cout << "\033[1;32m" << "Tenengrad: " << metrics.tenengrad << "\033[0m\n";
+    std::cout << "\033[1;32m" << "Variance of Laplacian: " << metrics.laplacian_variance << "\033[0m\n";
+    std::cout << "\033[1;32m" << "Edge density: " << metrics.edge_density << "\033[0m\n";
+    std::cout << "\033[1;32m" << "Blurry: " << (metrics.laplacian_variance < FOCUS_BLUR_THRESHOLD ? "yes" : "no")
+              << "\033[0m\n";
+    if (tiles_x > 0) std::cout << "\033[1;32m" << "Tiles saved in : " << result_path << "\033[0m\n";
+    std::cout << "\033[1;32m" << "----------------------------------------\n" << "\033[0m\n";
+
+    // free the memory
+    free(input_filename);
+    free(result_path);
+    free(input_path);
+    stbi_image_free(image);
+    free(tile_metrics);
+
+    return 0;
+}
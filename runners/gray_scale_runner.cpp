@@ -26,18 +26,19 @@ void guide() {
 
     std::cout << "\033[1;33m" << "No arguments were provided! Default values will be used!" << "\033[0m\n";
     std::cout << "\033[1;33m"
-              << "Usage: ./gray_scale_filter_runner.out <input_path> <input_filename> <result_path>"
+              << "Usage: ./gray_scale_filter_runner.out <input_path> <input_filename> <result_path> [alpha_mode]"
               << "\033[0m\n";
 
     std::cout << "\033[1;33m" << "Default values: " << "\033[0m\n";
     std::cout << "\033[1;33m" << "input_path: " << DEFAULT_INPUT_PATH << "\033[0m\n";
     std::cout << "\033[1;33m" << "input_filename: " << DEFAULT_INPUT_FILENAME << "\033[0m\n";
     std::cout << "\033[1;33m" << "result_path: " << DEFAULT_RESULT_PATH << "\033[0m\n";
+    std::cout << "\033[1;33m" << "alpha_mode: " << GRAY_ALPHA_MODE << " (ignore or premultiply)" << "\033[0m\n";
 
     std::cout << "\033[1;33m" << "Use '-' as an argument to use the default value!" << "\033[0m\n";
 
     std::cout << "\033[1;33m"
-              << "Example: ./gray_scale_filter_runner.out /home/user/images/ image.png -"
+              << "Example: ./gray_scale_filter_runner.out /home/user/images/ image.png - premultiply"
               << "\033[0m\n";
 
     std::cout << "\033[1;33m" << "----------------------------------------\n" << "\033[0m\n";
@@ -48,25 +49,28 @@ int main(int argc, char *argv[]) {
     char *input_filename = (char *) malloc(sizeof(char) * FILENAME_MAX);
     char *result_path = (char *) malloc(sizeof(char) * (FILENAME_MAX + PATH_MAX));
     char *input_path = (char *) malloc(sizeof(char) * (FILENAME_MAX + PATH_MAX));
+    char *alpha_name = (char *) malloc(sizeof(char) * FILENAME_MAX);
 
 
-    if (argc == 4) {
+    if (argc == 4 || argc == 5) {
         SET_OR_DEFAULT(argv[1], input_path, DEFAULT_INPUT_PATH)
         SET_OR_DEFAULT(argv[2], input_filename,  DEFAULT_INPUT_FILENAME)
         SET_OR_DEFAULT(argv[3], result_path, DEFAULT_RESULT_PATH)
+        if (argc == 5) { SET_OR_DEFAULT(argv[4], alpha_name, GRAY_ALPHA_MODE) }
+        else strcpy(alpha_name, GRAY_ALPHA_MODE);
 
-        if (!IS_PNG(input_filename)) { ERROR_COUT_AND_RETURN(INVALID_FILE_TYPE) }
+        if (!IS_IMAGE(input_filename)) { ERROR_COUT_AND_RETURN(INVALID_FILE_TYPE) }
+        strcat(input_path, input_filename);
 
         // check if the path is valid and the file exists
         if (!PATH_EXISTS(input_path)) { ERROR_COUT_AND_RETURN(INVALID_FILE_PATH) }
+        if (!PATH_EXISTS(result_path)) { ERROR_COUT_AND_RETURN(INVALID_RESULT_PATH) }
 
-        // remove the .png extension
-        input_filename[strlen(input_filename) - 4] = '\0';
+        // remove the extension
+        REMOVE_EXTENSION(input_filename)
         strcat(result_path, input_filename);
         strcat(result_path, "_gray_scaled.png");
 
-        if (!PATH_EXISTS(result_path)) { ERROR_COUT_AND_RETURN(INVALID_RESULT_PATH) }
-
 
     } else if (argc == 1) {
         // use default values
@@ -74,13 +78,14 @@ int main(int argc, char *argv[]) {
         strcat(input_path, DEFAULT_INPUT_FILENAME);
         strcpy(input_filename, DEFAULT_INPUT_FILENAME);
         strcpy(result_path, DEFAULT_RESULT_PATH);
+        strcpy(alpha_name, GRAY_ALPHA_MODE);
 
-        if (!IS_PNG(input_filename)) { ERROR_COUT_AND_RETURN(INVALID_FILE_TYPE) }
+        if (!IS_IMAGE(input_filename)) { ERROR_COUT_AND_RETURN(INVALID_FILE_TYPE) }
         if (!PATH_EXISTS(input_path)) { ERROR_COUT_AND_RETURN(INVALID_FILE_PATH) }
         if (!PATH_EXISTS(result_path)) { ERROR_COUT_AND_RETURN(INVALID_RESULT_PATH) }
 
-        // remove the .png extension
-        input_filename[strlen(input_filename) - 4] = '\0';
+        // remove the extension
+        REMOVE_EXTENSION(input_filename)
         strcat(result_path, input_filename);
         strcat(result_path, "_gray_scaled.png");
 
@@ -90,17 +95,23 @@ int main(int argc, char *argv[]) {
         ERROR_COUT_AND_RETURN(INVALID_ARGUMENTS)
     }
 
-    // load the image
+    alpha_mode alpha;
+    if (strcmp(alpha_name, "ignore") == 0) alpha = ALPHA_IGNORE;
+    else if (strcmp(alpha_name, "premultiply") == 0) alpha = ALPHA_PREMULTIPLY;
+    else { ERROR_COUT_AND_RETURN(INVALID_ALPHA_MODE) }
+
+    // load the image with its own channels, gray + alpha and RGBA are converted without repacking
     int width, height, channels;
     ubyte *image;
-    image = stbi_load(input_path, &width, &height, &channels, 3);
+    image = stbi_load(input_path, &width, &height, &channels, 0);
+    if (image == nullptr) { ERROR_COUT_AND_RETURN(INVALID_IMAGE) }
 
     // start timer
     auto start = std::chrono::high_resolution_clock::now();
 
     // gray scales the image
     ubyte *gray_scaled_image;
-    int state = convert_to_gray_scale(image, &gray_scaled_image, width, height, 3);
+    int state = convert_to_gray_scale(image, &gray_scaled_image, width, height, channels, alpha);
     if (state == 1) {
         std::cout << "Error while converting to gray scale!\n";
         return 1;
@@ -131,6 +142,7 @@ int main(int argc, char *argv[]) {
     free(input_filename);
     free(result_path);
     free(input_path);
+    free(alpha_name);
     stbi_image_free(image);
     stbi_image_free(gray_scaled_image);
 
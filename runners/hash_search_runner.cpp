@@ -0,0 +1,158 @@
+#include <iostream>
+#include <chrono>
+#include <filesystem>
+#include <cstring>
+#include <climits>
+#include <string>
+#include <vector>
+
+#include "../filters/image_hash.h"
+
+#include "../config.h"
+
+#include "helper.cpp"
+
+namespace fs = std::filesystem;
+
+
+void guide() {
+    std::cout << "\033[1;33m" << "----------------------------------------\n" << "\033[0m";
+
+    std::cout << "\033[1;33m" << "GUIDE: " << "\033[0m\n";
+
+    std::cout << "\033[1;33m" << "No arguments were provided! Default values will be used!" << "\033[0m\n";
+    std::cout << "\033[1;33m"
+              << "Usage: ./hash_search_runner.out <hash_file> <query> <max_distance>"
+              << "\033[0m\n";
+
+    std::cout << "\033[1;33m" << "Default values: " << "\033[0m\n";
+    std::cout << "\033[1;33m" << "hash_file: " << DEFAULT_RESULT_PATH << HASH_FILENAME << "\033[0m\n";
+    std::cout << "\033[1;33m" << "query: every pair of the hash file" << "\033[0m\n";
+    std::cout << "\033[1;33m" << "max_distance: " << HASH_MAX_DISTANCE << "\033[0m\n";
+    std::cout << "\033[1;33m" << "Example: ./hash_search_runner.out - 80a8999cdcf82081 4" << "\033[0m\n";
+
+    std::cout << "\033[1;33m" << "----------------------------------------\n" << "\033[0m\n";
+}
+
+/**
+ * Parses a hash written as 16 hexadecimal digits.
+ *
+ * @param text The hexadecimal hash.
+ * @param hash The parsed hash.
+ * @return false if the text is not a hash.
+ */
+static bool parse_hash(const char *text, hash64 *hash) {
+    if (strlen(text) != 16) return false;
+    char *end;
+    *hash = strtoull(text, &end, 16);
+    return *end == '\0';
+}
+
+int main(int argc, char *argv[]) {
+
+    char *hash_path = (char *) malloc(sizeof(char) * (FILENAME_MAX + PATH_MAX));
+
+    bool all_pairs;
+    hash64 query = 0;
+    long max_distance;
+
+    if (argc == 4) {
+        if (strcmp(argv[1], "-") == 0) {
+            strcpy(hash_path, DEFAULT_RESULT_PATH);
+            strcat(hash_path, HASH_FILENAME);
+        } else {
+            strcpy(hash_path, argv[1]);
+        }
+        if (!PATH_EXISTS(hash_path)) { ERROR_COUT_AND_RETURN(INVALID_FILE_PATH) }
+
+        // second arg is the query, '-' compares every pair
+        all_pairs = strcmp(argv[2], "-") == 0;
+        if (!all_pairs && !parse_hash(argv[2], &query)) { ERROR_COUT_AND_RETURN(INVALID_HASH) }
+
+        // third arg is the maximum distance
+        max_distance = strcmp(argv[3], "-") == 0 ? HASH_MAX_DISTANCE : atol(argv[3]);
+        if (max_distance < 0 || max_distance > 64) { ERROR_COUT_AND_RETURN(INVALID_HASH_DISTANCE) }
+
+    } else if (argc == 1) {
+        // use default values
+        strcpy(hash_path, DEFAULT_RESULT_PATH);
+        strcat(hash_path, HASH_FILENAME);
+        all_pairs = true;
+        max_distance = HASH_MAX_DISTANCE;
+
+        if (!PATH_EXISTS(hash_path)) { ERROR_COUT_AND_RETURN(INVALID_FILE_PATH) }
+
+        guide();
+
+    } else {
+        ERROR_COUT_AND_RETURN(INVALID_ARGUMENTS)
+    }
+
+    // read the hash file written by the image hash runner
+    std::vector<hash64> hashes;
+    std::vector<std::string> filenames;
+    FILE *hash_file = fopen(hash_path, "r");
+    if (hash_file == nullptr) { ERROR_COUT_AND_RETURN(INVALID_FILE_PATH) }
+
+    char line[FILENAME_MAX + 32];
+    while (fgets(line, sizeof(line), hash_file) != nullptr) {
+        line[strcspn(line, "\r\n")] = '\0';
+        if (strlen(line) < 18 || line[16] != ' ') continue;
+
+        line[16] = '\0';
+        hash64 hash;
+        if (!parse_hash(line, &hash)) continue;
+        hashes.push_back(hash);
+        filenames.emplace_back(line + 17);
+    }
+    fclose(hash_file);
+
+    // start the timer
+    auto start = std::chrono::high_resolution_clock::now();
+
+    // search the hashes
+    std::vector<std::pair<size_t, size_t>> pairs;
+    size_t *matches;
+    size_t match_count;
+    if (all_pairs) {
+        for (size_t i = 0; i + 1 < hashes.size(); i++) {
+            find_similar_hashes(hashes.data() + i + 1, hashes.size() - i - 1, hashes[i],
+                                (unsigned int) max_distance, &matches, &match_count);
+            for (size_t k = 0; k < match_count; k++) pairs.emplace_back(i, i + 1 + matches[k]);
+            free(matches);
+        }
+    } else {
+        find_similar_hashes(hashes.data(), hashes.size(), query, (unsigned int) max_distance, &matches, &match_count);
+        for (size_t k = 0; k < match_count; k++) pairs.emplace_back(matches[k], matches[k]);
+        free(matches);
+    }
+
+    // stop the timer
+    auto finish = std::chrono::high_resolution_clock::now();
+
+
+    std::cout << "\033[1;34m" << "----------------------------------------\n" << "\033[0m";
+    std::cout << "\033[1;34m" << "REPORT: " << "\033[0m\n";
+
+    std::cout << "\033[1;34m" << "Time: "
+              << std::chrono::duration_cast<std::chrono::microseconds>(finish - start).count()
+              << "us\n" << "\033[0m";
+    std::cout << "\033[1;34m" << "Hashes: " << hashes.size() << "\n" << "\033[0m";
+    std::cout << "\033[1;34m" << "Matches: " << pairs.size() << "\n" << "\033[0m";
+    std::cout << "\033[1;34m" << "----------------------------------------\n" << "\033[0m\n";
+
+    std::cout << "\033[1;32m" << "----------------------------------------\n" << "\033[0m";
+    std::cout << "\033[1;32m" << "RESULT: " << "\033[0m\n";
+    for (const auto &pair: pairs) {
+        hash64 other = all_pairs ? hashes[pair.second] : query;
+        std::cout << "\033[1;32m" << hash_distance(hashes[pair.first], other) << " " << filenames[pair.first];
+        if (all_pairs) std::cout << " " << filenames[pair.second];
+        std::cout << "\033[0m\n";
+    }
+    std::cout << "\033[1;32m" << "----------------------------------------\n" << "\033[0m\n";
+
+    // free the memory
+    free(hash_path);
+
+    return 0;
+}
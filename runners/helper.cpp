@@ -1,3 +1,6 @@
+#include <cstdio>
+#include <vector>
+
 
 #define SET_OR_DEFAULT(input, var, default) \
     if (strcmp(input, "-") == 0) { \
@@ -10,21 +13,97 @@
 
 // decleare some error types messages
 #define INVALID_ARGUMENTS "Invalid number of arguments!"
-#define INVALID_FILE_TYPE "Invalid file type! Only png files are supported!"
+#define INVALID_FILE_TYPE "Invalid file type! Only png and jpeg files are supported!"
 #define INVALID_FILE_PATH "Invalid file path!"
 #define INVALID_RESULT_PATH "Invalid result path!"
 #define INVALID_BRIGHTNESS_CHANGE "Invalid brightness change value! It should be between -128 and 127!"
 #define INVALID_SCALE_FACTOR "Invalid scale factor value! It should be between 0 and 1!"
 #define INVALID_THRESHOLD "Invalid threshold value! It should be between 0 and 255!"
+#define INVALID_SIGMA "Invalid sigma value! It should be between 0 and 100!"
+#define INVALID_LEVELS "Invalid number of levels! It should be between 1 and 16!"
+#define INVALID_ADAPTIVE_MODE "Invalid adaptive mode! It should be 'mean' or 'sauvola'!"
+#define INVALID_WINDOW "Invalid window size! It should be at least 1!"
+#define INVALID_MORPHOLOGY_OPERATION "Invalid operation! It should be 'dilate', 'erode', 'close' or 'open'!"
+#define INVALID_ELEMENT_SIZE "Invalid structuring element size! It should be at least 1!"
+#define INVALID_EDGE_OPERATOR "Invalid operator! It should be 'sobel', 'scharr', 'prewitt', 'roberts', 'sobel5' or 'sobel7'!"
+#define INVALID_COLOR_EDGE_MODE "Invalid mode! It should be 'max' or 'dizenzo'!"
+#define INVALID_SECOND_ORDER_OPERATOR "Invalid operator! It should be 'log' or 'dog'!"
+#define INVALID_CORNER_RESPONSE "Invalid corner response! It should be 'harris' or 'shi-tomasi'!"
+#define INVALID_MIN_VOTES "Invalid minimum number of votes! It should be at least 1!"
+#define INVALID_MAX_LINES "Invalid maximum number of lines! It should be at least 1!"
+#define INVALID_REGIONS "Invalid regions! They should be 'x,y,width,height' rectangles separated by ';' or a png mask!"
+#define INVALID_MASK "Invalid mask! It should be a png image of the size of the input image!"
+#define INVALID_TOLERANCE "Invalid tolerance! It should be between 0 and 255!"
+#define INVALID_TILE_SIZE "Invalid tile size! It should be 0 (no tiles) or more!"
+#define INVALID_SIZE "Invalid size! The width and the height should be at least 1!"
+#define INVALID_RESIZE_METHOD "Invalid resize method! It should be 'area' or 'bilinear'!"
+#define INVALID_HASH_METHOD "Invalid hash method! It should be 'ahash', 'dhash' or 'phash'!"
+#define INVALID_HASH "Invalid hash! It should be 16 hexadecimal digits or '-'!"
+#define INVALID_HASH_DISTANCE "Invalid distance! It should be between 0 and 64!"
+#define INVALID_VIDEO_FORMAT "Invalid video format! It should be 'y4m', 'i420' or 'nv12'!"
+#define INVALID_VIDEO "Invalid or truncated video!"
+#define INVALID_GIF_FILE_TYPE "Invalid file type! Only GIF files are supported!"
+#define INVALID_GIF "Invalid or unreadable GIF file!"
+#define INVALID_GIF_OUTPUT "Invalid output! It should be 'gif' or 'png'!"
+#define INVALID_REDUCTION "Invalid reduction! It should be 1, 2, 4 or 8!"
+#define INVALID_IMAGE "Invalid or unreadable image!"
+#define EDGE_DETECTION_FAILED "Failed to detect the edges!"
+#define INVALID_HDR_FILE_TYPE "Invalid file type! Only png and hdr files are supported!"
+#define INVALID_ALPHA_MODE "Invalid alpha mode! It should be 'ignore' or 'premultiply'!"
+#define INVALID_PERCENTILE "Invalid percentile value! It should be 'otsu' or between 0 and 100!"
+#define INVALID_CANNY_THRESHOLD "Invalid threshold value! It should be between 0 and 1442!"
+#define INVALID_CANNY_THRESHOLDS "Invalid thresholds! The low threshold should not be greater than the high threshold!"
 
 // macro for checking if the file is PNG or not
 #define IS_PNG(filename) (strstr(filename, ".png") != nullptr)
 
+// macro for checking if the file is JPEG or not
+#define IS_JPEG(filename) (strstr(filename, ".jpg") != nullptr || strstr(filename, ".jpeg") != nullptr)
+
+// macro for checking if the file is a Radiance HDR image or not
+#define IS_HDR(filename) (strstr(filename, ".hdr") != nullptr)
+
+// macro for checking if the file is an image the runners can read
+#define IS_IMAGE(filename) (IS_PNG(filename) || IS_JPEG(filename))
+
+// macro for removing the extension of a file name
+#define REMOVE_EXTENSION(filename) *strrchr(filename, '.') = '\0';
+
+// macro for checking if the file is GIF or not
+#define IS_GIF(filename) (strstr(filename, ".gif") != nullptr)
+
 // ERROR COUT AND RETURN
 #define ERROR_COUT_AND_RETURN(message) \
     std::cout  << "\033[1;33m" << message << "\n" << "\033[0m"; \
     return 1;
 
+// ERROR CERR AND RETURN, for the runners that write their results to stdout
+#define ERROR_CERR_AND_RETURN(message) \
+    std::cerr  << "\033[1;33m" << message << "\n" << "\033[0m"; \
+    return 1;
+
 // FILE EXISTS
 # define PATH_EXISTS(path) fs::exists(path)
 
+
+
+/**
+ * Reads a whole file into memory.
+ *
+ * @param path The path of the file.
+ * @param data Receives the content of the file.
+ * @return false if the file could not be read.
+ */
+static inline bool read_file(const char *path, std::vector<unsigned char> &data) {
+    FILE *file = fopen(path, "rb");
+    if (file == nullptr) return false;
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    data.resize(size > 0 ? (size_t) size : 0);
+    bool read = size > 0 && fread(data.data(), 1, data.size(), file) == data.size();
+    fclose(file);
+    return read;
+}
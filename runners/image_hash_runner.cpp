@@ -0,0 +1,179 @@
+#include <iostream>
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#define STB_IMAGE_IMPLEMENTATION
+
+
+#include "../stb/stb_image.h"
+
+#include "../filters/image_hash.h"
+
+#include "../config.h"
+
+#include "helper.cpp"
+
+namespace fs = std::filesystem;
+
+
+void guide() {
+    std::cout << "\033[1;33m" << "----------------------------------------\n" << "\033[0m";
+
+    std::cout << "\033[1;33m" << "GUIDE: " << "\033[0m\n";
+
+    std::cout << "\033[1;33m" << "No arguments were provided! Default values will be used!" << "\033[0m\n";
+    std::cout << "\033[1;33m"
+              << "Usage: ./image_hash_runner.out <input_path> <input_filename> <result_path> <method>"
+              << "\033[0m\n";
+
+    std::cout << "\033[1;33m" << "Default values: " << "\033[0m\n";
+    std::cout << "\033[1;33m" << "input_path: " << DEFAULT_INPUT_PATH << "\033[0m\n";
+    std::cout << "\033[1;33m" << "input_filename: " << DEFAULT_INPUT_FILENAME << "\033[0m\n";
+    std::cout << "\033[1;33m" << "result_path: " << DEFAULT_RESULT_PATH << "\033[0m\n";
+    std::cout << "\033[1;33m" << "method: " << HASH_METHOD << "\033[0m\n";
+    std::cout << "\033[1;33m" << "Use '*' as the input filename to hash every png file of the input path!"
+              << "\033[0m\n";
+    std::cout << "\033[1;33m" << "Example: ./image_hash_runner.out - '*' - dhash" << "\033[0m\n";
+
+    std::cout << "\033[1;33m" << "----------------------------------------\n" << "\033[0m\n";
+}
+
+/**
+ * Parses the name of a hash method.
+ *
+ * @param name "ahash", "dhash" or "phash".
+ * @param method The parsed method.
+ * @return false if the name is unknown.
+ */
+static bool parse_method(const char *name, hash_method *method) {
+    if (strcmp(name, "ahash") == 0) *method = HASH_AVERAGE;
+    else if (strcmp(name, "dhash") == 0) *method = HASH_DIFFERENCE;
+    else if (strcmp(name, "phash") == 0) *method = HASH_PERCEPTUAL;
+    else return false;
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+
+    char *input_filename = (char *) malloc(sizeof(char) * FILENAME_MAX);
+    char *result_path = (char *) malloc(sizeof(char) * (FILENAME_MAX + PATH_MAX));
+    char *input_path = (char *) malloc(sizeof(char) * (FILENAME_MAX + PATH_MAX));
+
+    hash_method method;
+
+    if (argc == 5) {
+        SET_OR_DEFAULT(argv[1], input_path, DEFAULT_INPUT_PATH)
+        SET_OR_DEFAULT(argv[2], input_filename, DEFAULT_INPUT_FILENAME)
+        SET_OR_DEFAULT(argv[3], result_path, DEFAULT_RESULT_PATH)
+
+        if (strcmp(input_filename, "*") != 0 && !IS_IMAGE(input_filename)) { ERROR_COUT_AND_RETURN(INVALID_FILE_TYPE) }
+
+        // check if the path is valid and the file exists
+        if (!PATH_EXISTS(input_path)) { ERROR_COUT_AND_RETURN(INVALID_FILE_PATH) }
+        if (strcmp(input_filename, "*") != 0 && !PATH_EXISTS(std::string(input_path) + input_filename)) {
+            ERROR_COUT_AND_RETURN(INVALID_FILE_PATH)
+        }
+
+        // check if the result path is valid
+        if (!PATH_EXISTS(result_path)) { ERROR_COUT_AND_RETURN(INVALID_RESULT_PATH) }
+
+        strcat(result_path, HASH_FILENAME);
+
+        // fourth arg is the method
+        if (!parse_method(strcmp(argv[4], "-") == 0 ? HASH_METHOD : argv[4], &method)) {
+            ERROR_COUT_AND_RETURN(INVALID_HASH_METHOD)
+        }
+
+    } else if (argc == 1) {
+        // use default values
+        strcpy(input_path, DEFAULT_INPUT_PATH);
+        strcpy(input_filename, DEFAULT_INPUT_FILENAME);
+        strcpy(result_path, DEFAULT_RESULT_PATH);
+
+        if (!IS_IMAGE(input_filename)) { ERROR_COUT_AND_RETURN(INVALID_FILE_TYPE) }
+        if (!PATH_EXISTS(std::string(input_path) + input_filename)) { ERROR_COUT_AND_RETURN(INVALID_FILE_PATH) }
+        if (!PATH_EXISTS(result_path)) { ERROR_COUT_AND_RETURN(INVALID_RESULT_PATH) }
+        if (!parse_method(HASH_METHOD, &method)) { ERROR_COUT_AND_RETURN(INVALID_HASH_METHOD) }
+
+        strcat(result_path, HASH_FILENAME);
+
+        guide();
+
+    } else {
+        ERROR_COUT_AND_RETURN(INVALID_ARGUMENTS)
+    }
+
+    // the files to hash, in a stable order
+    std::vector<std::string> filenames;
+    if (strcmp(input_filename, "*") == 0) {
+        for (const auto &entry: fs::directory_iterator(input_path)) {
+            std::string filename = entry.path().filename().string();
+            if (entry.is_regular_file() && IS_IMAGE(filename.c_str())) filenames.push_back(filename);
+        }
+        std::sort(filenames.begin(), filenames.end());
+    } else {
+        filenames.emplace_back(input_filename);
+    }
+
+    FILE *hash_file = fopen(result_path, "w");
+    if (hash_file == nullptr) { ERROR_COUT_AND_RETURN(INVALID_RESULT_PATH) }
+
+    std::chrono::high_resolution_clock::duration decode_time{}, hash_time{};
+    size_t hashed = 0;
+
+    for (const std::string &filename: filenames) {
+        std::string path = std::string(input_path) + filename;
+
+        // read the image as gray scale, as the Sobel runner decodes it, so both give the same hashes
+        auto start = std::chrono::high_resolution_clock::now();
+        int width, height, bpp;
+        ubyte *image = stbi_load(path.c_str(), &width, &height, &bpp, 1);
+        auto decoded = std::chrono::high_resolution_clock::now();
+
+        // hash the image
+        hash64 hash;
+        int state = image == nullptr ? 1 : compute_image_hash(image, width, height, 1, method, &hash);
+        auto finish = std::chrono::high_resolution_clock::now();
+        stbi_image_free(image);
+
+        if (state != 0) {
+            std::cout << "\033[1;33m" << "Skipping unreadable file: " << filename << "\n" << "\033[0m";
+            continue;
+        }
+
+        decode_time += decoded - start;
+        hash_time += finish - decoded;
+        hashed++;
+
+        fprintf(hash_file, "%016llx %s\n", hash, filename.c_str());
+    }
+    fclose(hash_file);
+
+
+    std::cout << "\033[1;34m" << "----------------------------------------\n" << "\033[0m";
+    std::cout << "\033[1;34m" << "REPORT: " << "\033[0m\n";
+
+    std::cout << "\033[1;34m" << "Images: " << hashed << "\n" << "\033[0m";
+    std::cout << "\033[1;34m" << "Decode time: "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(decode_time).count()
+              << "ms\n" << "\033[0m";
+    std::cout << "\033[1;34m" << "Hash time: "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(hash_time).count()
+              << "ms\n" << "\033[0m";
+    std::cout << "\033[1;34m" << "----------------------------------------\n" << "\033[0m\n";
+
+    std::cout << "\033[1;32m" << "----------------------------------------\n" << "\033[0m";
+    std::cout << "\033[1;32m" << "RESULT: " << "\033[0m\n";
+    std::cout << "\033[1;32m" << "Hashes saved in : " << result_path << "\033[0m\n";
+    std::cout << "\033[1;32m" << "----------------------------------------\n" << "\033[0m\n";
+
+    // free the memory
+    free(input_filename);
+    free(result_path);
+    free(input_path);
+
+    return 0;
+}
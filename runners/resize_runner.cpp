@@ -0,0 +1,175 @@
+
+#include <iostream>
+#include <chrono>
+#include <filesystem>
+
+#define STB_IMAGE_IMPLEMENTATION
+
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+
+
+#include "../stb/stb_image.h"
+
+#include "../stb/stb_image_write.h"
+
+#include "../filters/resize_filter.h"
+
+#include "../config.h"
+
+#include "helper.cpp"
+
+namespace fs = std::filesystem;
+
+
+void guide() {
+    std::cout << "\033[1;33m" << "----------------------------------------\n" << "\033[0m";
+
+    std::cout << "\033[1;33m" << "GUIDE: " << "\033[0m\n";
+
+    std::cout << "\033[1;33m" << "No arguments were provided! Default values will be used!" << "\033[0m\n";
+    std::cout << "\033[1;33m"
+              << "Usage: ./resize_filter_runner.out <input_path> <input_filename> <result_path> <width> <height> <method>"
+              << "\033[0m\n";
+
+    std::cout << "\033[1;33m" << "Default values: " << "\033[0m\n";
+    std::cout << "\033[1;33m" << "input_path: " << DEFAULT_INPUT_PATH << "\033[0m\n";
+    std::cout << "\033[1;33m" << "input_filename: " << DEFAULT_INPUT_FILENAME << "\033[0m\n";
+    std::cout << "\033[1;33m" << "result_path: " << DEFAULT_RESULT_PATH << "\033[0m\n";
+    std::cout << "\033[1;33m" << "width: " << RESIZE_WIDTH << "\033[0m\n";
+    std::cout << "\033[1;33m" << "height: " << RESIZE_HEIGHT << "\033[0m\n";
+    std::cout << "\033[1;33m" << "method: " << RESIZE_METHOD << "\033[0m\n";
+    std::cout << "\033[1;33m" << "Example: ./resize_filter_runner.out - - - 1280 720 bilinear" << "\033[0m\n";
+
+    std::cout << "\033[1;33m" << "----------------------------------------\n" << "\033[0m\n";
+}
+
+/**
+ * Parses the name of a resize method.
+ *
+ * @param name "area" or "bilinear".
+ * @param method The parsed method.
+ * @return false if the name is unknown.
+ */
+static bool parse_method(const char *name, resize_method *method) {
+    if (strcmp(name, "area") == 0) *method = RESIZE_AREA;
+    else if (strcmp(name, "bilinear") == 0) *method = RESIZE_BILINEAR;
+    else return false;
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+
+    char *input_filename = (char *) malloc(sizeof(char) * FILENAME_MAX);
+    char *result_path = (char *) malloc(sizeof(char) * (FILENAME_MAX + PATH_MAX));
+    char *input_path = (char *) malloc(sizeof(char) * (FILENAME_MAX + PATH_MAX));
+
+    long resized_width, resized_height;
+    resize_method method;
+
+    if (argc == 7) {
+        SET_OR_DEFAULT(argv[1], input_path, DEFAULT_INPUT_PATH)
+        SET_OR_DEFAULT(argv[2], input_filename, DEFAULT_INPUT_FILENAME)
+        SET_OR_DEFAULT(argv[3], result_path, DEFAULT_RESULT_PATH)
+
+        if (!IS_IMAGE(input_filename)) { ERROR_COUT_AND_RETURN(INVALID_FILE_TYPE) }
+
+        // construct the input path
+        strcat(input_path, input_filename);
+
+        // check if the path is valid and the file exists
+        if (!PATH_EXISTS(input_path)) { ERROR_COUT_AND_RETURN(INVALID_FILE_PATH) }
+
+        // check if the result path is valid
+        if (!PATH_EXISTS(result_path)) { ERROR_COUT_AND_RETURN(INVALID_RESULT_PATH) }
+
+        // remove the extension
+        REMOVE_EXTENSION(input_filename)
+
+        strcat(result_path, input_filename);
+        strcat(result_path, "_resized.png");
+
+        // fourth and fifth args are the size of the result
+        resized_width = strcmp(argv[4], "-") == 0 ? RESIZE_WIDTH : atol(argv[4]);
+        resized_height = strcmp(argv[5], "-") == 0 ? RESIZE_HEIGHT : atol(argv[5]);
+        if (resized_width < 1 || resized_height < 1) { ERROR_COUT_AND_RETURN(INVALID_SIZE) }
+
+        // sixth arg is the method
+        if (!parse_method(strcmp(argv[6], "-") == 0 ? RESIZE_METHOD : argv[6], &method)) {
+            ERROR_COUT_AND_RETURN(INVALID_RESIZE_METHOD)
+        }
+
+    } else if (argc == 1) {
+        // use default values
+        strcpy(input_path, DEFAULT_INPUT_PATH);
+        strcpy(input_filename, DEFAULT_INPUT_FILENAME);
+        strcat(input_path, input_filename);
+        strcpy(result_path, DEFAULT_RESULT_PATH);
+        resized_width = RESIZE_WIDTH;
+        resized_height = RESIZE_HEIGHT;
+
+        if (!IS_IMAGE(input_path)) { ERROR_COUT_AND_RETURN(INVALID_FILE_TYPE) }
+        if (!PATH_EXISTS(input_path)) { ERROR_COUT_AND_RETURN(INVALID_FILE_PATH) }
+        if (!PATH_EXISTS(result_path)) { ERROR_COUT_AND_RETURN(INVALID_RESULT_PATH) }
+        if (resized_width < 1 || resized_height < 1) { ERROR_COUT_AND_RETURN(INVALID_SIZE) }
+        if (!parse_method(RESIZE_METHOD, &method)) { ERROR_COUT_AND_RETURN(INVALID_RESIZE_METHOD) }
+
+
+        // remove the extension
+        REMOVE_EXTENSION(input_filename)
+        strcat(result_path, input_filename);
+        strcat(result_path, "_resized.png");
+
+        guide();
+
+    } else {
+        ERROR_COUT_AND_RETURN(INVALID_ARGUMENTS)
+    }
+
+    // read the image, gray scale images stay single channel
+    int width, height, bpp;
+    stbi_info(input_path, &width, &height, &bpp);
+    int channels = bpp <= 2 ? 1 : 3;
+    ubyte *image = stbi_load(input_path, &width, &height, &bpp, channels);
+
+    // start the timer
+    auto start = std::chrono::high_resolution_clock::now();
+
+    // apply the filters
+    ubyte *resized_image;
+    resize_image(
+            image,
+            &resized_image,
+            width, height, channels,
+            resized_width, resized_height,
+            method);
+
+    // stop the timer
+    auto finish = std::chrono::high_resolution_clock::now();
+
+    // write the image
+    stbi_write_png(result_path, (int) resized_width, (int) resized_height, channels, resized_image,
+                   (int) resized_width * channels);
+
+
+    std::cout << "\033[1;34m" << "----------------------------------------\n" << "\033[0m";
+    std::cout << "\033[1;34m" << "REPORT: " << "\033[0m\n";
+
+    std::cout << "\033[1;34m" << "Time: "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(finish - start).count()
+              << "ms\n" << "\033[0m";
+    std::cout << "\033[1;34m" << "----------------------------------------\n" << "\033[0m\n";
+
+    std::cout << "\033[1;32m" << "----------------------------------------\n" << "\033[0m";
+    std::cout << "\033[1;32m" << "RESULT: " << "\033[0m\n";
+    std::cout << "\033[1;32m" << "Result saved in : " << result_path << "\033[0m\n";
+    std::cout << "\033[1;32m" << "----------------------------------------\n" << "\033[0m\n";
+
+    // free the memory
+    free(input_filename);
+    free(result_path);
+    free(input_path);
+    stbi_image_free(image);
+    stbi_image_free(resized_image);
+
+    return 0;
+}
@@ -0,0 +1,146 @@
+
+#include <iostream>
+#include <chrono>
+#include <filesystem>
+
+#define STB_IMAGE_IMPLEMENTATION
+
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+
+
+#include "../stb/stb_image.h"
+
+#include "../stb/stb_image_write.h"
+
+#include "../filters/smoothing_filter.h"
+
+#include "../config.h"
+
+#include "helper.cpp"
+
+namespace fs = std::filesystem;
+
+
+void guide() {
+    std::cout << "\033[1;33m" << "----------------------------------------\n" << "\033[0m";
+
+    std::cout << "\033[1;33m" << "GUIDE: " << "\033[0m\n";
+
+    std::cout << "\033[1;33m" << "No arguments were provided! Default values will be used!" << "\033[0m\n";
+    std::cout << "\033[1;33m"
+              << "Usage: ./smoothing_filter_runner.out <input_path> <input_filename> <result_path> <sigma>"
+              << "\033[0m\n";
+
+    std::cout << "\033[1;33m" << "Default values: " << "\033[0m\n";
+    std::cout << "\033[1;33m" << "input_path: " << DEFAULT_INPUT_PATH << "\033[0m\n";
+    std::cout << "\033[1;33m" << "input_filename: " << DEFAULT_INPUT_FILENAME << "\033[0m\n";
+    std::cout << "\033[1;33m" << "result_path: " << DEFAULT_RESULT_PATH << "\033[0m\n";
+    std::cout << "\033[1;33m" << "sigma: " << SMOOTHING_SIGMA << "\033[0m\n";
+    std::cout << "\033[1;33m" << "Example: ./smoothing_filter_runner.out - - - 4.5" << "\033[0m\n";
+
+    std::cout << "\033[1;33m" << "----------------------------------------\n" << "\033[0m\n";
+}
+
+int main(int argc, char *argv[]) {
+
+    char *input_filename = (char *) malloc(sizeof(char) * FILENAME_MAX);
+    char *result_path = (char *) malloc(sizeof(char) * (FILENAME_MAX + PATH_MAX));
+    char *input_path = (char *) malloc(sizeof(char) * (FILENAME_MAX + PATH_MAX));
+
+    double sigma;
+
+    if (argc == 5) {
+        SET_OR_DEFAULT(argv[1], input_path, DEFAULT_INPUT_PATH)
+        SET_OR_DEFAULT(argv[2], input_filename, DEFAULT_INPUT_FILENAME)
+        SET_OR_DEFAULT(argv[3], result_path, DEFAULT_RESULT_PATH)
+
+        if (!IS_IMAGE(input_filename)) { ERROR_COUT_AND_RETURN(INVALID_FILE_TYPE) }
+
+        // construct the input path
+        strcat(input_path, input_filename);
+
+        // check if the path is valid and the file exists
+        if (!PATH_EXISTS(input_path)) { ERROR_COUT_AND_RETURN(INVALID_FILE_PATH) }
+
+        // check if the result path is valid
+        if (!PATH_EXISTS(result_path)) { ERROR_COUT_AND_RETURN(INVALID_RESULT_PATH) }
+
+        // remove the extension
+        REMOVE_EXTENSION(input_filename)
+
+        strcat(result_path, input_filename);
+        strcat(result_path, "_smoothed.png");
+
+        // fourth arg is the sigma
+        sigma = atof(argv[4]);
+        if (sigma < 0 || sigma > MAX_SIGMA) { ERROR_COUT_AND_RETURN(INVALID_SIGMA) }
+
+    } else if (argc == 1) {
+        // use default values
+        strcpy(input_path, DEFAULT_INPUT_PATH);
+        strcpy(input_filename, DEFAULT_INPUT_FILENAME);
+        strcat(input_path, input_filename);
+        strcpy(result_path, DEFAULT_RESULT_PATH);
+        sigma = SMOOTHING_SIGMA;
+
+        if (!IS_IMAGE(input_path)) { ERROR_COUT_AND_RETURN(INVALID_FILE_TYPE) }
+        if (!PATH_EXISTS(input_path)) { ERROR_COUT_AND_RETURN(INVALID_FILE_PATH) }
+        if (!PATH_EXISTS(result_path)) { ERROR_COUT_AND_RETURN(INVALID_RESULT_PATH) }
+        if (sigma < 0 || sigma > MAX_SIGMA) { ERROR_COUT_AND_RETURN(INVALID_SIGMA) }
+
+
+        // remove the extension
+        REMOVE_EXTENSION(input_filename)
+        strcat(result_path, input_filename);
+        strcat(result_path, "_smoothed.png");
+
+        guide();
+
+    } else {
+        ERROR_COUT_AND_RETURN(INVALID_ARGUMENTS)
+    }
+
+    // read the image
+    int width, height, bpp;
+    ubyte *image = stbi_load(input_path, &width, &height, &bpp, 1);
+
+    // start the timer
+    auto start = std::chrono::high_resolution_clock::now();
+
+    // apply the filters
+    ubyte *smoothed_image;
+    gaussian_blur(
+            image,
+            &smoothed_image,
+            width, height,
+            sigma);
+
+    // stop the timer
+    auto finish = std::chrono::high_resolution_clock::now();
+
+    // write the image
+    stbi_write_png(result_path, width, height, 1, smoothed_image, width);
+
+
+    std::cout << "\033[1;34m" << "----------------------------------------\n" << "\033[0m";
+    std::cout << "\033[1;34m" << "REPORT: " << "\033[0m\n";
+
+    std::cout << "\033[1;34m" << "Time: "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(finish - start).count()
+              << "ms\n" << "\033[0m";
+    std::cout << "\033[1;34m" << "----------------------------------------\n" << "\033[0m\n";
+
+    std::cout << "\033[1;32m" << "----------------------------------------\n" << "\033[0m";
+    std::cout << "\033[1;32m" << "RESULT: " << "\033[0m\n";
+    std::cout << "\033[1;32m" << "Result saved in : " << result_path << "\033[0m\n";
+    std::cout << "\033[1;32m" << "----------------------------------------\n" << "\033[0m\n";
+
+    // free the memory
+    free(input_filename);
+    free(result_path);
+    free(input_path);
+    stbi_image_free(image);
+    stbi_image_free(smoothed_image);
+
+    return 0;
+}
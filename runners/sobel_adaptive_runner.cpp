@@ -0,0 +1,179 @@
+
+#include <iostream>
+#include <chrono>
+#include <filesystem>
+
+#define STB_IMAGE_IMPLEMENTATION
+
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+
+
+#include "../stb/stb_image.h"
+
+#include "../stb/stb_image_write.h"
+
+#include "../filters/sobel_filter.h"
+
+#include "../filters/integral_image.h"
+
+#include "../config.h"
+
+#include "helper.cpp"
+
+namespace fs = std::filesystem;
+
+
+void guide() {
+    std::cout << "\033[1;33m" << "----------------------------------------\n" << "\033[0m";
+
+    std::cout << "\033[1;33m" << "GUIDE: " << "\033[0m\n";
+
+    std::cout << "\033[1;33m" << "No arguments were provided! Default values will be used!" << "\033[0m\n";
+    std::cout << "\033[1;33m"
+              << "Usage: ./sobel_adaptive_filter_runner.out <input_path> <input_filename> <result_path> <mode> <window> <k> <scale>"
+              << "\033[0m\n";
+
+    std::cout << "\033[1;33m" << "Default values: " << "\033[0m\n";
+    std::cout << "\033[1;33m" << "input_path: " << DEFAULT_INPUT_PATH << "\033[0m\n";
+    std::cout << "\033[1;33m" << "input_filename: " << DEFAULT_INPUT_FILENAME << "\033[0m\n";
+    std::cout << "\033[1;33m" << "result_path: " << DEFAULT_RESULT_PATH << "\033[0m\n";
+    std::cout << "\033[1;33m" << "mode: " << ADAPTIVE_THRESHOLD_MODE << "\033[0m\n";
+    std::cout << "\033[1;33m" << "window: " << ADAPTIVE_WINDOW << "\033[0m\n";
+    std::cout << "\033[1;33m" << "k: " << ADAPTIVE_K << "\033[0m\n";
+    std::cout << "\033[1;33m" << "scale: " << STRENGTH_RATIO << "\033[0m\n";
+    std::cout << "\033[1;33m" << "mode is 'mean' or 'sauvola'" << "\033[0m\n";
+    std::cout << "\033[1;33m" << "Example: ./sobel_adaptive_filter_runner.out - - - sauvola 31 0.2 0.3" << "\033[0m\n";
+
+    std::cout << "\033[1;33m" << "----------------------------------------\n" << "\033[0m\n";
+}
+
+int main(int argc, char *argv[]) {
+
+    char *input_filename = (char *) malloc(sizeof(char) * FILENAME_MAX);
+    char *result_path = (char *) malloc(sizeof(char) * (FILENAME_MAX + PATH_MAX));
+    char *input_path = (char *) malloc(sizeof(char) * (FILENAME_MAX + PATH_MAX));
+
+    adaptive_mode mode;
+    long window;
+    double k;
+    double scale;
+
+    if (argc == 8) {
+        SET_OR_DEFAULT(argv[1], input_path, DEFAULT_INPUT_PATH)
+        SET_OR_DEFAULT(argv[2], input_filename, DEFAULT_INPUT_FILENAME)
+        SET_OR_DEFAULT(argv[3], result_path, DEFAULT_RESULT_PATH)
+
+        if (!IS_IMAGE(input_filename)) { ERROR_COUT_AND_RETURN(INVALID_FILE_TYPE) }
+
+        // construct the input path
+        strcat(input_path, input_filename);
+
+        // check if the path is valid and the file exists
+        if (!PATH_EXISTS(input_path)) { ERROR_COUT_AND_RETURN(INVALID_FILE_PATH) }
+
+        // check if the result path is valid
+        if (!PATH_EXISTS(result_path)) { ERROR_COUT_AND_RETURN(INVALID_RESULT_PATH) }
+
+        // remove the extension
+        REMOVE_EXTENSION(input_filename)
+
+        strcat(result_path, input_filename);
+        strcat(result_path, "_sobel_adaptive.png");
+
+        // fourth arg is the mode
+        const char *mode_name = strcmp(argv[4], "-") == 0 ? ADAPTIVE_THRESHOLD_MODE : argv[4];
+        if (strcmp(mode_name, "mean") == 0) mode = ADAPTIVE_MEAN;
+        else if (strcmp(mode_name, "sauvola") == 0) mode = ADAPTIVE_SAUVOLA;
+        else { ERROR_COUT_AND_RETURN(INVALID_ADAPTIVE_MODE) }
+
+        // fifth arg is the window size
+        window = strcmp(argv[5], "-") == 0 ? ADAPTIVE_WINDOW : atol(argv[5]);
+        if (window < 1) { ERROR_COUT_AND_RETURN(INVALID_WINDOW) }
+
+        // sixth arg is k
+        k = strcmp(argv[6], "-") == 0 ? ADAPTIVE_K : atof(argv[6]);
+
+        // seventh arg is the scale
+        scale = atof(argv[7]);
+        if (scale < 0 || scale > 1) { ERROR_COUT_AND_RETURN(INVALID_SCALE_FACTOR) }
+
+    } else if (argc == 1) {
+        // use default values
+        strcpy(input_path, DEFAULT_INPUT_PATH);
+        strcpy(input_filename, DEFAULT_INPUT_FILENAME);
+        strcat(input_path, input_filename);
+        strcpy(result_path, DEFAULT_RESULT_PATH);
+        mode = strcmp(ADAPTIVE_THRESHOLD_MODE, "sauvola") == 0 ? ADAPTIVE_SAUVOLA : ADAPTIVE_MEAN;
+        window = ADAPTIVE_WINDOW;
+        k = ADAPTIVE_K;
+        scale = STRENGTH_RATIO;
+
+        if (!IS_IMAGE(input_path)) { ERROR_COUT_AND_RETURN(INVALID_FILE_TYPE) }
+        if (!PATH_EXISTS(input_path)) { ERROR_COUT_AND_RETURN(INVALID_FILE_PATH) }
+        if (!PATH_EXISTS(result_path)) { ERROR_COUT_AND_RETURN(INVALID_RESULT_PATH) }
+        if (window < 1) { ERROR_COUT_AND_RETURN(INVALID_WINDOW) }
+        if (scale < 0 || scale > 1) { ERROR_COUT_AND_RETURN(INVALID_SCALE_FACTOR) }
+
+
+        // remove the extension
+        REMOVE_EXTENSION(input_filename)
+        strcat(result_path, input_filename);
+        strcat(result_path, "_sobel_adaptive.png");
+
+        guide();
+
+    } else {
+        ERROR_COUT_AND_RETURN(INVALID_ARGUMENTS)
+    }
+
+    // read the image
+    int width, height, bpp;
+    ubyte *image = stbi_load(input_path, &width, &height, &bpp, 1);
+
+    // start the timer
+    auto start = std::chrono::high_resolution_clock::now();
+
+    // apply the filters
+    // plain gradient magnitudes (no global threshold), then the local thresholds
+    ubyte *magnitude_image, *edge_detected_image;
+    detect_edges(
+            image,
+            &magnitude_image,
+            width, height,
+            0, 0, 2);
+    adaptive_threshold(
+            magnitude_image,
+            &edge_detected_image,
+            width, height,
+            window, mode, k, scale);
+
+    // stop the timer
+    auto finish = std::chrono::high_resolution_clock::now();
+
+    // write the image
+    stbi_write_png(result_path, width, height, 1, edge_detected_image, width);
+
+
+    std::cout << "\033[1;34m" << "----------------------------------------\n" << "\033[0m";
+    std::cout << "\033[1;34m" << "REPORT: " << "\033[0m\n";
+
+    std::cout << "\033[1;34m" << "Time: "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(finish - start).count()
+              << "ms\n" << "\033[0m";
+    std::cout << "\033[1;34m" << "----------------------------------------\n" << "\033[0m\n";
+
+    std::cout << "\033[1;32m" << "----------------------------------------\n" << "\033[0m";
+    std::cout << "\033[1;32m" << "RESULT: " << "\033[0m\n";
+    std::cout << "\033[1;32m" << "Result saved in : " << result_path << "\033[0m\n";
+    std::cout << "\033[1;32m" << "----------------------------------------\n" << "\033[0m\n";
+
+    // free the memory
+    free(input_filename);
+    free(result_path);
+    free(input_path);
+    stbi_image_free(image);
+    stbi_image_free(magnitude_image);
+    stbi_image_free(edge_detected_image);
+
+    return 0;
+}
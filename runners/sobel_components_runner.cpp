@@ -0,0 +1,192 @@
+
+#include <iostream>
+#include <chrono>
+#include <filesystem>
+
+#define STB_IMAGE_IMPLEMENTATION
+
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+
+
+#include "../stb/stb_image.h"
+
+#include "../stb/stb_image_write.h"
+
+#include "../filters/sobel_filter.h"
+
+#include "../filters/connected_components.h"
+
+#include "../config.h"
+
+#include "helper.cpp"
+
+namespace fs = std::filesystem;
+
+
+void guide() {
+    std::cout << "\033[1;33m" << "----------------------------------------\n" << "\033[0m";
+
+    std::cout << "\033[1;33m" << "GUIDE: " << "\033[0m\n";
+
+    std::cout << "\033[1;33m" << "No arguments were provided! Default values will be used!" << "\033[0m\n";
+    std::cout << "\033[1;33m"
+              << "Usage: ./sobel_components_filter_runner.out <input_path> <input_filename> <result_path> <threshold> <scale>"
+              << "\033[0m\n";
+
+    std::cout << "\033[1;33m" << "Default values: " << "\033[0m\n";
+    std::cout << "\033[1;33m" << "input_path: " << DEFAULT_INPUT_PATH << "\033[0m\n";
+    std::cout << "\033[1;33m" << "input_filename: " << DEFAULT_INPUT_FILENAME << "\033[0m\n";
+    std::cout << "\033[1;33m" << "result_path: " << DEFAULT_RESULT_PATH << "\033[0m\n";
+    std::cout << "\033[1;33m" << "threshold: " << SOBEL_THRESHOLD << "\033[0m\n";
+    std::cout << "\033[1;33m" << "scale: " << STRENGTH_RATIO << "\033[0m\n";
+    std::cout << "\033[1;33m" << "Example: ./sobel_components_filter_runner.out - - - 50 0.3" << "\033[0m\n";
+
+    std::cout << "\033[1;33m" << "----------------------------------------\n" << "\033[0m\n";
+}
+
+int main(int argc, char *argv[]) {
+
+    char *input_filename = (char *) malloc(sizeof(char) * FILENAME_MAX);
+    char *result_path = (char *) malloc(sizeof(char) * (FILENAME_MAX + PATH_MAX));
+    char *input_path = (char *) malloc(sizeof(char) * (FILENAME_MAX + PATH_MAX));
+
+    ubyte threshold;
+    double scale;
+
+    if (argc == 6) {
+        SET_OR_DEFAULT(argv[1], input_path, DEFAULT_INPUT_PATH)
+        SET_OR_DEFAULT(argv[2], input_filename, DEFAULT_INPUT_FILENAME)
+        SET_OR_DEFAULT(argv[3], result_path, DEFAULT_RESULT_PATH)
+
+        if (!IS_IMAGE(input_filename)) { ERROR_COUT_AND_RETURN(INVALID_FILE_TYPE) }
+
+        // construct the input path
+        strcat(input_path, input_filename);
+
+        // check if the path is valid and the file exists
+        if (!PATH_EXISTS(input_path)) { ERROR_COUT_AND_RETURN(INVALID_FILE_PATH) }
+
+        // check if the result path is valid
+        if (!PATH_EXISTS(result_path)) { ERROR_COUT_AND_RETURN(INVALID_RESULT_PATH) }
+
+        // remove the extension
+        REMOVE_EXTENSION(input_filename)
+
+        strcat(result_path, input_filename);
+        strcat(result_path, "_components.png");
+
+        // fourth arg is the threshold
+        int threshold_value = atoi(argv[4]);
+        if (threshold_value < 0 || threshold_value > 255) { ERROR_COUT_AND_RETURN(INVALID_THRESHOLD) }
+        threshold = (ubyte) threshold_value;
+
+        // fifth arg is the scale
+        scale = atof(argv[5]);
+        if (scale < 0 || scale > 1) { ERROR_COUT_AND_RETURN(INVALID_SCALE_FACTOR) }
+
+    } else if (argc == 1) {
+        // use default values
+        strcpy(input_path, DEFAULT_INPUT_PATH);
+        strcpy(input_filename, DEFAULT_INPUT_FILENAME);
+        strcat(input_path, input_filename);
+        strcpy(result_path, DEFAULT_RESULT_PATH);
+        threshold = SOBEL_THRESHOLD;
+        scale = STRENGTH_RATIO;
+
+        if (!IS_IMAGE(input_path)) { ERROR_COUT_AND_RETURN(INVALID_FILE_TYPE) }
+        if (!PATH_EXISTS(input_path)) { ERROR_COUT_AND_RETURN(INVALID_FILE_PATH) }
+        if (!PATH_EXISTS(result_path)) { ERROR_COUT_AND_RETURN(INVALID_RESULT_PATH) }
+        if (scale < 0 || scale > 1) { ERROR_COUT_AND_RETURN(INVALID_SCALE_FACTOR) }
+
+
+        // remove the extension
+        REMOVE_EXTENSION(input_filename)
+        strcat(result_path, input_filename);
+        strcat(result_path, "_components.png");
+
+        guide();
+
+    } else {
+        ERROR_COUT_AND_RETURN(INVALID_ARGUMENTS)
+    }
+
+    // read the image
+    int width, height, bpp;
+    ubyte *image = stbi_load(input_path, &width, &height, &bpp, 1);
+
+    // start the timer
+    auto start = std::chrono::high_resolution_clock::now();
+
+    // apply the filters
+    ubyte *edge_detected_image;
+    detect_edges(
+            image,
+            &edge_detected_image,
+            width, height,
+            threshold, scale, 2);
+
+    // label the edges above the threshold
+    unsigned int *labels;
+    component_stats *stats;
+    size_t count;
+    label_components(
+            edge_detected_image,
+            &labels, &stats, &count,
+            width, height,
+            threshold);
+
+    // stop the timer
+    auto finish = std::chrono::high_resolution_clock::now();
+
+    // write the labels, every component gets a color derived from its label
+    auto *label_image = (ubyte *) malloc((size_t) width * height * 3);
+    for (size_t i = 0; i < (size_t) width * height; i++) {
+        unsigned int hash = labels[i] * 2654435761u;
+        label_image[3 * i] = labels[i] == 0 ? 0 : (ubyte) (hash >> 24 | 64);
+        label_image[3 * i + 1] = labels[i] == 0 ? 0 : (ubyte) (hash >> 16 | 64);
+        label_image[3 * i + 2] = labels[i] == 0 ? 0 : (ubyte) (hash >> 8 | 64);
+    }
+    stbi_write_png(result_path, width, height, 3, label_image, width * 3);
+
+    // write the statistics next to the image
+    std::string stats_path(result_path);
+    stats_path.replace(stats_path.size() - 4, 4, ".csv");
+    FILE *stats_file = fopen(stats_path.c_str(), "w");
+    if (stats_file == nullptr) { ERROR_COUT_AND_RETURN(INVALID_RESULT_PATH) }
+    fprintf(stats_file, "label,area,min_x,min_y,max_x,max_y,centroid_x,centroid_y\n");
+    for (size_t k = 0; k < count; k++) {
+        fprintf(stats_file, "%u,%zu,%zu,%zu,%zu,%zu,%.2f,%.2f\n",
+                stats[k].label, stats[k].area,
+                stats[k].min_x, stats[k].min_y, stats[k].max_x, stats[k].max_y,
+                stats[k].centroid_x, stats[k].centroid_y);
+    }
+    fclose(stats_file);
+
+
+    std::cout << "\033[1;34m" << "----------------------------------------\n" << "\033[0m";
+    std::cout << "\033[1;34m" << "REPORT: " << "\033[0m\n";
+
+    std::cout << "\033[1;34m" << "Time: "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(finish - start).count()
+              << "ms\n" << "\033[0m";
+    std::cout << "\033[1;34m" << "Components: " << count << "\n" << "\033[0m";
+    std::cout << "\033[1;34m" << "----------------------------------------\n" << "\033[0m\n";
+
+    std::cout << "\033[1;32m" << "----------------------------------------\n" << "\033[0m";
+    std::cout << "\033[1;32m" << "RESULT: " << "\033[0m\n";
+    std::cout << "\033[1;32m" << "Result saved in : " << result_path << "\033[0m\n";
+    std::cout << "\033[1;32m" << "Statistics saved in : " << stats_path << "\033[0m\n";
+    std::cout << "\033[1;32m" << "----------------------------------------\n" << "\033[0m\n";
+
+    // free the memory
+    free(input_filename);
+    free(result_path);
+    free(input_path);
+    stbi_image_free(image);
+    stbi_image_free(edge_detected_image);
+    free(label_image);
+    free(labels);
+    free(stats);
+
+    return 0;
+}
@@ -0,0 +1,218 @@
+
+#include <iostream>
+#include <chrono>
+#include <filesystem>
+
+#define STB_IMAGE_IMPLEMENTATION
+
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+
+
+#include "../stb/stb_image.h"
+
+#include "../stb/stb_image_write.h"
+
+#include "../filters/sobel_filter.h"
+
+#include "../filters/corner_detector.h"
+
+#include "../config.h"
+
+#include "helper.cpp"
+
+namespace fs = std::filesystem;
+
+
+void guide() {
+    std::cout << "\033[1;33m" << "----------------------------------------\n" << "\033[0m";
+
+    std::cout << "\033[1;33m" << "GUIDE: " << "\033[0m\n";
+
+    std::cout << "\033[1;33m" << "No arguments were provided! Default values will be used!" << "\033[0m\n";
+    std::cout << "\033[1;33m"
+              << "Usage: ./sobel_corners_filter_runner.out <input_path> <input_filename> <result_path> <response> <threshold> <scale>"
+              << "\033[0m\n";
+
+    std::cout << "\033[1;33m" << "Default values: " << "\033[0m\n";
+    std::cout << "\033[1;33m" << "input_path: " << DEFAULT_INPUT_PATH << "\033[0m\n";
+    std::cout << "\033[1;33m" << "input_filename: " << DEFAULT_INPUT_FILENAME << "\033[0m\n";
+    std::cout << "\033[1;33m" << "result_path: " << DEFAULT_RESULT_PATH << "\033[0m\n";
+    std::cout << "\033[1;33m" << "response: " << CORNER_RESPONSE << "\033[0m\n";
+    std::cout << "\033[1;33m" << "threshold: " << SOBEL_THRESHOLD << "\033[0m\n";
+    std::cout << "\033[1;33m" << "scale: " << STRENGTH_RATIO << "\033[0m\n";
+    std::cout << "\033[1;33m" << "Example: ./sobel_corners_filter_runner.out - - - shi-tomasi 50 0.3" << "\033[0m\n";
+
+    std::cout << "\033[1;33m" << "----------------------------------------\n" << "\033[0m\n";
+}
+
+/**
+ * Parses the name of a corner response.
+ *
+ * @param name "harris" or "shi-tomasi".
+ * @param response The parsed response.
+ * @return false if the name is unknown.
+ */
+static bool parse_response(const char *name, corner_response *response) {
+    if (strcmp(name, "harris") == 0) *response = CORNER_HARRIS;
+    else if (strcmp(name, "shi-tomasi") == 0) *response = CORNER_SHI_TOMASI;
+    else return false;
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+
+    char *input_filename = (char *) malloc(sizeof(char) * FILENAME_MAX);
+    char *result_path = (char *) malloc(sizeof(char) * (FILENAME_MAX + PATH_MAX));
+    char *input_path = (char *) malloc(sizeof(char) * (FILENAME_MAX + PATH_MAX));
+
+    corner_response response;
+    ubyte threshold;
+    double scale;
+
+    if (argc == 7) {
+        SET_OR_DEFAULT(argv[1], input_path, DEFAULT_INPUT_PATH)
+        SET_OR_DEFAULT(argv[2], input_filename, DEFAULT_INPUT_FILENAME)
+        SET_OR_DEFAULT(argv[3], result_path, DEFAULT_RESULT_PATH)
+
+        if (!IS_IMAGE(input_filename)) { ERROR_COUT_AND_RETURN(INVALID_FILE_TYPE) }
+
+        // construct the input path
+        strcat(input_path, input_filename);
+
+        // check if the path is valid and the file exists
+        if (!PATH_EXISTS(input_path)) { ERROR_COUT_AND_RETURN(INVALID_FILE_PATH) }
+
+        // check if the result path is valid
+        if (!PATH_EXISTS(result_path)) { ERROR_COUT_AND_RETURN(INVALID_RESULT_PATH) }
+
+        // remove the extension
+        REMOVE_EXTENSION(input_filename)
+
+        strcat(result_path, input_filename);
+        strcat(result_path, "_corners.png");
+
+        // fourth arg is the corner response
+        if (!parse_response(strcmp(argv[4], "-") == 0 ? CORNER_RESPONSE : argv[4], &response)) {
+            ERROR_COUT_AND_RETURN(INVALID_CORNER_RESPONSE)
+        }
+
+        // fifth arg is the threshold
+        int threshold_value = atoi(argv[5]);
+        if (threshold_value < 0 || threshold_value > 255) { ERROR_COUT_AND_RETURN(INVALID_THRESHOLD) }
+        threshold = (ubyte) threshold_value;
+
+        // sixth arg is the scale
+        scale = atof(argv[6]);
+        if (scale < 0 || scale > 1) { ERROR_COUT_AND_RETURN(INVALID_SCALE_FACTOR) }
+
+    } else if (argc == 1) {
+        // use default values
+        strcpy(input_path, DEFAULT_INPUT_PATH);
+        strcpy(input_filename, DEFAULT_INPUT_FILENAME);
+        strcat(input_path, input_filename);
+        strcpy(result_path, DEFAULT_RESULT_PATH);
+        threshold = SOBEL_THRESHOLD;
+        scale = STRENGTH_RATIO;
+
+        if (!IS_IMAGE(input_path)) { ERROR_COUT_AND_RETURN(INVALID_FILE_TYPE) }
+        if (!PATH_EXISTS(input_path)) { ERROR_COUT_AND_RETURN(INVALID_FILE_PATH) }
+        if (!PATH_EXISTS(result_path)) { ERROR_COUT_AND_RETURN(INVALID_RESULT_PATH) }
+        if (!parse_response(CORNER_RESPONSE, &response)) { ERROR_COUT_AND_RETURN(INVALID_CORNER_RESPONSE) }
+        if (scale < 0 || scale > 1) { ERROR_COUT_AND_RETURN(INVALID_SCALE_FACTOR) }
+
+
+        // remove the extension
+        REMOVE_EXTENSION(input_filename)
+        strcat(result_path, input_filename);
+        strcat(result_path, "_corners.png");
+
+        guide();
+
+    } else {
+        ERROR_COUT_AND_RETURN(INVALID_ARGUMENTS)
+    }
+
+    // read the image
+    int width, height, bpp;
+    ubyte *image = stbi_load(input_path, &width, &height, &bpp, 1);
+
+    // start the timer
+    auto start = std::chrono::high_resolution_clock::now();
+
+    // edges and corners from the same gradients
+    ubyte *edge_detected_image;
+    corner *corners;
+    size_t count;
+    detect_edges_and_corners(
+            image,
+            &edge_detected_image,
+            &corners, &count,
+            width, height,
+            threshold, scale,
+            response,
+            CORNER_WINDOW,
+            CORNER_HARRIS_K,
+            CORNER_QUALITY,
+            CORNER_MIN_DISTANCE,
+            CORNER_MAX_CORNERS);
+
+    // stop the timer
+    auto finish = std::chrono::high_resolution_clock::now();
+
+    // draw the corners as red crosses over the edges
+    auto *corner_image = (ubyte *) malloc((size_t) width * height * 3);
+    for (size_t i = 0; i < (size_t) width * height; i++) {
+        corner_image[3 * i] = corner_image[3 * i + 1] = corner_image[3 * i + 2] = edge_detected_image[i];
+    }
+    for (size_t k = 0; k < count; k++) {
+        for (long d = -2; d <= 2; d++) {
+            long x[] = {(long) corners[k].x + d, (long) corners[k].x};
+            long y[] = {(long) corners[k].y, (long) corners[k].y + d};
+            for (int p = 0; p < 2; p++) {
+                if (x[p] < 0 || x[p] >= width || y[p] < 0 || y[p] >= height) continue;
+                size_t index = 3 * ((size_t) y[p] * width + x[p]);
+                corner_image[index] = 255;
+                corner_image[index + 1] = corner_image[index + 2] = 0;
+            }
+        }
+    }
+    stbi_write_png(result_path, width, height, 3, corner_image, width * 3);
+
+    // write the corners next to the image
+    std::string corners_path(result_path);
+    corners_path.replace(corners_path.size() - 4, 4, ".csv");
+    FILE *corners_file = fopen(corners_path.c_str(), "w");
+    if (corners_file == nullptr) { ERROR_COUT_AND_RETURN(INVALID_RESULT_PATH) }
+    fprintf(corners_file, "x,y,response\n");
+    for (size_t k = 0; k < count; k++) {
+        fprintf(corners_file, "%zu,%zu,%g\n", corners[k].x, corners[k].y, corners[k].response);
+    }
+    fclose(corners_file);
+
+
+    std::cout << "\033[1;34m" << "----------------------------------------\n" << "\033[0m";
+    std::cout << "\033[1;34m" << "REPORT: " << "\033[0m\n";
+
+    std::cout << "\033[1;34m" << "Time: "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(finish - start).count()
+              << "ms\n" << "\033[0m";
+    std::cout << "\033[1;34m" << "Corners: " << count << "\n" << "\033[0m";
+    std::cout << "\033[1;34m" << "----------------------------------------\n" << "\033[0m\n";
+
+    std::cout << "\033[1;32m" << "----------------------------------------\n" << "\033[0m";
+    std::cout << "\033[1;32m" << "RESULT: " << "\033[0m\n";
+    std::cout << "\033[1;32m" << "Result saved in : " << result_path << "\033[0m\n";
+    std::cout << "\033[1;32m" << "Corners saved in : " << corners_path << "\033[0m\n";
+    std::cout << "\033[1;32m" << "----------------------------------------\n" << "\033[0m\n";
+
+    // free the memory
+    free(input_filename);
+    free(result_path);
+    free(input_path);
+    stbi_image_free(image);
+    stbi_image_free(edge_detected_image);
+    free(corner_image);
+    free(corners);
+
+    return 0;
+}
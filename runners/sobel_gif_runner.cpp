@@ -0,0 +1,235 @@
+
+#include <iostream>
+#include <chrono>
+#include <filesystem>
+#include <vector>
+
+#define STB_IMAGE_IMPLEMENTATION
+
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+
+
+#include "../stb/stb_image.h"
+
+#include "../stb/stb_image_write.h"
+
+#include "../filters/edge_operators.h"
+
+#include "../filters/gif_writer.h"
+
+#include "../filters/parallel.h"
+
+#include "../config.h"
+
+#include "helper.cpp"
+
+namespace fs = std::filesystem;
+
+
+void guide() {
+    std::cout << "\033[1;33m" << "----------------------------------------\n" << "\033[0m";
+
+    std::cout << "\033[1;33m" << "GUIDE: " << "\033[0m\n";
+
+    std::cout << "\033[1;33m" << "No arguments were provided! Default values will be used!" << "\033[0m\n";
+    std::cout << "\033[1;33m"
+              << "Usage: ./sobel_gif_filter_runner.out <input_path> <input_filename> <result_path> <operator> <threshold> <scale> <output>"
+              << "\033[0m\n";
+
+    std::cout << "\033[1;33m" << "Default values: " << "\033[0m\n";
+    std::cout << "\033[1;33m" << "input_path: " << DEFAULT_INPUT_PATH << "\033[0m\n";
+    std::cout << "\033[1;33m" << "input_filename: " << GIF_INPUT_FILENAME << "\033[0m\n";
+    std::cout << "\033[1;33m" << "result_path: " << DEFAULT_RESULT_PATH << "\033[0m\n";
+    std::cout << "\033[1;33m" << "operator: " << GIF_EDGE_OPERATOR << "\033[0m\n";
+    std::cout << "\033[1;33m" << "threshold: " << SOBEL_THRESHOLD << "\033[0m\n";
+    std::cout << "\033[1;33m" << "scale: " << STRENGTH_RATIO << "\033[0m\n";
+    std::cout << "\033[1;33m" << "output: " << GIF_OUTPUT << "\033[0m\n";
+    std::cout << "\033[1;33m" << "Example: ./sobel_gif_filter_runner.out - recording.gif - sobel 100 0.3 png" << "\033[0m\n";
+
+    std::cout << "\033[1;33m" << "----------------------------------------\n" << "\033[0m\n";
+}
+
+/**
+ * Parses the name of a gradient operator.
+ *
+ * @param name "sobel", "scharr", "prewitt", "roberts", "sobel5" or "sobel7".
+ * @param op The parsed operator.
+ * @return false if the name is unknown.
+ */
+static bool parse_operator(const char *name, edge_operator *op) {
+    if (strcmp(name, "sobel") == 0) *op = OPERATOR_SOBEL;
+    else if (strcmp(name, "scharr") == 0) *op = OPERATOR_SCHARR;
+    else if (strcmp(name, "prewitt") == 0) *op = OPERATOR_PREWITT;
+    else if (strcmp(name, "roberts") == 0) *op = OPERATOR_ROBERTS;
+    else if (strcmp(name, "sobel5") == 0) *op = OPERATOR_SOBEL_5;
+    else if (strcmp(name, "sobel7") == 0) *op = OPERATOR_SOBEL_7;
+    else return false;
+    return true;
+}
+
+/**
+ * Parses the kind of result.
+ *
+ * @param name "gif" for an animated GIF, or "png" for one png file per frame.
+ * @param animated Whether the result is an animated GIF.
+ * @return false if the name is unknown.
+ */
+static bool parse_output(const char *name, bool *animated) {
+    if (strcmp(name, "gif") == 0) *animated = true;
+    else if (strcmp(name, "png") == 0) *animated = false;
+    else return false;
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+
+    char *input_filename = (char *) malloc(sizeof(char) * FILENAME_MAX);
+    char *result_path = (char *) malloc(sizeof(char) * (FILENAME_MAX + PATH_MAX));
+    char *input_path = (char *) malloc(sizeof(char) * (FILENAME_MAX + PATH_MAX));
+
+    edge_operator op;
+    ubyte threshold;
+    double scale;
+    bool animated;
+
+    if (argc == 8) {
+        SET_OR_DEFAULT(argv[1], input_path, DEFAULT_INPUT_PATH)
+        SET_OR_DEFAULT(argv[2], input_filename, GIF_INPUT_FILENAME)
+        SET_OR_DEFAULT(argv[3], result_path, DEFAULT_RESULT_PATH)
+
+        if (!IS_GIF(input_filename)) { ERROR_COUT_AND_RETURN(INVALID_GIF_FILE_TYPE) }
+
+        // construct the input path
+        strcat(input_path, input_filename);
+
+        // check if the path is valid and the file exists
+        if (!PATH_EXISTS(input_path)) { ERROR_COUT_AND_RETURN(INVALID_FILE_PATH) }
+
+        // check if the result path is valid
+        if (!PATH_EXISTS(result_path)) { ERROR_COUT_AND_RETURN(INVALID_RESULT_PATH) }
+
+        // fourth arg is the operator
+        if (!parse_operator(strcmp(argv[4], "-") == 0 ? GIF_EDGE_OPERATOR : argv[4], &op)) {
+            ERROR_COUT_AND_RETURN(INVALID_EDGE_OPERATOR)
+        }
+
+        // fifth arg is the threshold
+        int threshold_value = atoi(argv[5]);
+        if (threshold_value < 0 || threshold_value > 255) { ERROR_COUT_AND_RETURN(INVALID_THRESHOLD) }
+        threshold = (ubyte) threshold_value;
+
+        // sixth arg is the scale
+        scale = atof(argv[6]);
+        if (scale < 0 || scale > 1) { ERROR_COUT_AND_RETURN(INVALID_SCALE_FACTOR) }
+
+        // seventh arg is the kind of result
+        if (!parse_output(strcmp(argv[7], "-") == 0 ? GIF_OUTPUT : argv[7], &animated)) {
+            ERROR_COUT_AND_RETURN(INVALID_GIF_OUTPUT)
+        }
+
+    } else if (argc == 1) {
+        // use default values
+        strcpy(input_path, DEFAULT_INPUT_PATH);
+        strcpy(input_filename, GIF_INPUT_FILENAME);
+        strcat(input_path, input_filename);
+        strcpy(result_path, DEFAULT_RESULT_PATH);
+        threshold = SOBEL_THRESHOLD;
+        scale = STRENGTH_RATIO;
+
+        if (!IS_GIF(input_path)) { ERROR_COUT_AND_RETURN(INVALID_GIF_FILE_TYPE) }
+        if (!PATH_EXISTS(input_path)) { ERROR_COUT_AND_RETURN(INVALID_FILE_PATH) }
+        if (!PATH_EXISTS(result_path)) { ERROR_COUT_AND_RETURN(INVALID_RESULT_PATH) }
+        if (!parse_operator(GIF_EDGE_OPERATOR, &op)) { ERROR_COUT_AND_RETURN(INVALID_EDGE_OPERATOR) }
+        if (scale < 0 || scale > 1) { ERROR_COUT_AND_RETURN(INVALID_SCALE_FACTOR) }
+        if (!parse_output(GIF_OUTPUT, &animated)) { ERROR_COUT_AND_RETURN(INVALID_GIF_OUTPUT) }
+
+        guide();
+
+    } else {
+        ERROR_COUT_AND_RETURN(INVALID_ARGUMENTS)
+    }
+
+    // remove the .gif extension
+    REMOVE_EXTENSION(input_filename)
+    strcat(result_path, input_filename);
+
+    // decode every frame of the animation at once, as gray scale
+    std::vector<ubyte> file;
+    if (!read_file(input_path, file)) { ERROR_COUT_AND_RETURN(INVALID_GIF) }
+
+    int width, height, frame_count, bpp;
+    int *delays = nullptr;
+    ubyte *frames = stbi_load_gif_from_memory(file.data(), (int) file.size(), &delays,
+                                              &width, &height, &frame_count, &bpp, 1);
+    if (frames == nullptr || frame_count <= 0) { ERROR_COUT_AND_RETURN(INVALID_GIF) }
+
+    size_t frame_size = (size_t) width * height;
+    std::vector<ubyte *> edges((size_t) frame_count, nullptr);
+    std::vector<int> frame_failed((size_t) frame_count, 0);
+
+    // start the timer
+    auto start = std::chrono::high_resolution_clock::now();
+
+    // with at least one frame per thread, the frames are filtered in parallel, every frame on a single
+    // thread; with fewer frames they are filtered one after the other, every frame on all threads
+    auto filter_frames = [&](size_t frame_begin, size_t frame_end, size_t) {
+        for (size_t f = frame_begin; f < frame_end; f++) {
+            frame_failed[f] = detect_edges_operator(frames + f * frame_size, &edges[f], width, height,
+                                                    op, threshold, scale);
+        }
+    };
+    if ((size_t) frame_count >= worker_count()) parallel_for(0, (size_t) frame_count, filter_frames);
+    else filter_frames(0, (size_t) frame_count, 0);
+
+    // stop the timer
+    auto finish = std::chrono::high_resolution_clock::now();
+
+    int failed = 0;
+    for (int frame_failure: frame_failed) failed |= frame_failure;
+
+    // write the result
+    if (!failed) {
+        if (animated) {
+            strcat(result_path, "_edges.gif");
+            failed = write_gray_gif(result_path, edges.data(), edges.size(), width, height, delays);
+        } else {
+            size_t length = strlen(result_path);
+            for (size_t f = 0; f < edges.size(); f++) {
+                snprintf(result_path + length, FILENAME_MAX, "_edges_%03zu.png", f);
+                if (!stbi_write_png(result_path, width, height, 1, edges[f], width)) {
+                    std::cout << "Failed to write " << result_path << "!\n";
+                    failed = 1;
+                    break;
+                }
+            }
+            if (!failed) snprintf(result_path + length, FILENAME_MAX, "_edges_*.png");
+        }
+    }
+
+
+    std::cout << "\033[1;34m" << "----------------------------------------\n" << "\033[0m";
+    std::cout << "\033[1;34m" << "REPORT: " << "\033[0m\n";
+
+    std::cout << "\033[1;34m" << "Frames: " << frame_count << "\n" << "\033[0m";
+    std::cout << "\033[1;34m" << "Time: "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(finish - start).count()
+              << "ms\n" << "\033[0m";
+    std::cout << "\033[1;34m" << "----------------------------------------\n" << "\033[0m\n";
+
+    if (!failed) {
+        std::cout << "\033[1;32m" << "----------------------------------------\n" << "\033[0m";
+        std::cout << "\033[1;32m" << "RESULT: " << "\033[0m\n";
+        std::cout << "\033[1;32m" << "Result saved in : " << result_path << "\033[0m\n";
+        std::cout << "\033[1;32m" << "----------------------------------------\n" << "\033[0m\n";
+    }
+
+    // free the memory
+    free(input_filename);
+    free(result_path);
+    free(input_path);
+    for (ubyte *frame_edges: edges) free(frame_edges);
+    stbi_image_free(frames);
+    stbi_image_free(delays);
+
+    return failed;
+}
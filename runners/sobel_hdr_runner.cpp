@@ -0,0 +1,205 @@
+
+#include <iostream>
+#include <chrono>
+#include <filesystem>
+
+#define STB_IMAGE_IMPLEMENTATION
+
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+
+
+#include "../stb/stb_image.h"
+
+#include "../stb/stb_image_write.h"
+
+#include "../filters/gray_scale_filter.h"
+
+#include "../filters/sobel_filter.h"
+
+#include "../config.h"
+
+#include "helper.cpp"
+
+namespace fs = std::filesystem;
+
+
+void guide() {
+    std::cout << "\033[1;33m" << "----------------------------------------\n" << "\033[0m";
+
+    std::cout << "\033[1;33m" << "GUIDE: " << "\033[0m\n";
+
+    std::cout << "\033[1;33m" << "No arguments were provided! Default values will be used!" << "\033[0m\n";
+    std::cout << "\033[1;33m"
+              << "Usage: ./sobel_hdr_filter_runner.out <input_path> <input_filename> <result_path> <threshold> <scale>"
+              << "\033[0m\n";
+
+    std::cout << "\033[1;33m" << "Default values: " << "\033[0m\n";
+    std::cout << "\033[1;33m" << "input_path: " << DEFAULT_INPUT_PATH << "\033[0m\n";
+    std::cout << "\033[1;33m" << "input_filename: " << HDR_INPUT_FILENAME << "\033[0m\n";
+    std::cout << "\033[1;33m" << "result_path: " << DEFAULT_RESULT_PATH << "\033[0m\n";
+    std::cout << "\033[1;33m" << "threshold: " << SOBEL_THRESHOLD << "\033[0m\n";
+    std::cout << "\033[1;33m" << "scale: " << STRENGTH_RATIO << "\033[0m\n";
+    std::cout << "\033[1;33m" << "Example: ./sobel_hdr_filter_runner.out - scan.png - 50 0.3" << "\033[0m\n";
+
+    std::cout << "\033[1;33m" << "----------------------------------------\n" << "\033[0m\n";
+}
+
+/**
+ * Writes a 16 bit gray scale image as a binary PGM (P5) file, which stb can not write as a png.
+ *
+ * @param path The path of the file.
+ * @param image The image.
+ * @param width The width of the image in pixels.
+ * @param height The height of the image in pixels.
+ * @return false if the file could not be written.
+ */
+static bool write_pgm_16(const char *path, const uint16 *image, size_t width, size_t height) {
+    FILE *file = fopen(path, "wb");
+    if (file == nullptr) return false;
+
+    fprintf(file, "P5\n%zu %zu\n65535\n", width, height);
+    for (size_t i = 0; i < width * height; i++) {
+        // PGM samples are big endian
+        fputc(image[i] >> 8, file);
+        fputc(image[i] & 0xFF, file);
+    }
+
+    return fclose(file) == 0;
+}
+
+/**
+ * Loads an image with its depth, converts it to gray scale and detects its edges.
+ *
+ * @param load stbi_load_16 or stbi_loadf.
+ * @param threshold The threshold, in the units of the pixel type.
+ */
+template<typename Pixel, typename Loader>
+static int detect_edges_deep(Loader load, const char *input_path, Pixel **edges, int *width, int *height,
+                             double threshold, double scale) {
+    // images are loaded with their own channels and converted to gray scale at their depth, gray scale
+    // images are used as they are
+    int channels;
+    Pixel *image = load(input_path, width, height, &channels, 0);
+    if (image == nullptr) return 1;
+
+    Pixel *gray = image;
+    if (channels > 1 && convert_to_gray_scale<Pixel>(image, &gray, *width, *height, channels) != 0) {
+        stbi_image_free(image);
+        return 1;
+    }
+
+    int result = detect_edges<Pixel>(gray, edges, *width, *height, threshold, scale, 2);
+
+    if (gray != image) free(gray);
+    stbi_image_free(image);
+    return result;
+}
+
+int main(int argc, char *argv[]) {
+
+    char *input_filename = (char *) malloc(sizeof(char) * FILENAME_MAX);
+    char *result_path = (char *) malloc(sizeof(char) * (FILENAME_MAX + PATH_MAX));
+    char *input_path = (char *) malloc(sizeof(char) * (FILENAME_MAX + PATH_MAX));
+
+    ubyte threshold;
+    double scale;
+
+    if (argc == 6) {
+        SET_OR_DEFAULT(argv[1], input_path, DEFAULT_INPUT_PATH)
+        SET_OR_DEFAULT(argv[2], input_filename, HDR_INPUT_FILENAME)
+        SET_OR_DEFAULT(argv[3], result_path, DEFAULT_RESULT_PATH)
+
+        if (!IS_PNG(input_filename) && !IS_HDR(input_filename)) { ERROR_COUT_AND_RETURN(INVALID_HDR_FILE_TYPE) }
+
+        // construct the input path
+        strcat(input_path, input_filename);
+
+        // check if the path is valid and the file exists
+        if (!PATH_EXISTS(input_path)) { ERROR_COUT_AND_RETURN(INVALID_FILE_PATH) }
+
+        // check if the result path is valid
+        if (!PATH_EXISTS(result_path)) { ERROR_COUT_AND_RETURN(INVALID_RESULT_PATH) }
+
+        // fourth arg is the threshold
+        int threshold_value = atoi(argv[4]);
+        if (threshold_value < 0 || threshold_value > 255) { ERROR_COUT_AND_RETURN(INVALID_THRESHOLD) }
+        threshold = (ubyte) threshold_value;
+
+        // fifth arg is the scale
+        scale = atof(argv[5]);
+        if (scale < 0 || scale > 1) { ERROR_COUT_AND_RETURN(INVALID_SCALE_FACTOR) }
+
+    } else if (argc == 1) {
+        // use default values
+        strcpy(input_path, DEFAULT_INPUT_PATH);
+        strcpy(input_filename, HDR_INPUT_FILENAME);
+        strcat(input_path, input_filename);
+        strcpy(result_path, DEFAULT_RESULT_PATH);
+        threshold = SOBEL_THRESHOLD;
+        scale = STRENGTH_RATIO;
+
+        if (!IS_PNG(input_path) && !IS_HDR(input_path)) { ERROR_COUT_AND_RETURN(INVALID_HDR_FILE_TYPE) }
+        if (!PATH_EXISTS(input_path)) { ERROR_COUT_AND_RETURN(INVALID_FILE_PATH) }
+        if (!PATH_EXISTS(result_path)) { ERROR_COUT_AND_RETURN(INVALID_RESULT_PATH) }
+        if (scale < 0 || scale > 1) { ERROR_COUT_AND_RETURN(INVALID_SCALE_FACTOR) }
+
+        guide();
+
+    } else {
+        ERROR_COUT_AND_RETURN(INVALID_ARGUMENTS)
+    }
+
+    bool hdr = IS_HDR(input_filename);
+
+    // remove the extension
+    REMOVE_EXTENSION(input_filename)
+    strcat(result_path, input_filename);
+    strcat(result_path, hdr ? "_sobel.hdr" : "_sobel.pgm");
+
+    // start the timer
+    auto start = std::chrono::high_resolution_clock::now();
+
+    // read the image and apply the filters, the threshold is given in 8 bit levels
+    int width, height, failed;
+    uint16 *edges_16 = nullptr;
+    float *edges_float = nullptr;
+    if (hdr) {
+        failed = detect_edges_deep<float>(stbi_loadf, input_path, &edges_float, &width, &height,
+                                          threshold / 255.0, scale);
+    } else {
+        failed = detect_edges_deep<uint16>(stbi_load_16, input_path, &edges_16, &width, &height,
+                                           threshold * 257.0, scale);
+    }
+
+    // stop the timer
+    auto finish = std::chrono::high_resolution_clock::now();
+
+    if (failed) { ERROR_COUT_AND_RETURN(INVALID_IMAGE) }
+
+    // write the image at its depth
+    if (hdr) stbi_write_hdr(result_path, width, height, 1, edges_float);
+    else write_pgm_16(result_path, edges_16, width, height);
+
+
+    std::cout << "\033[1;34m" << "----------------------------------------\n" << "\033[0m";
+    std::cout << "\033[1;34m" << "REPORT: " << "\033[0m\n";
+
+    std::cout << "\033[1;34m" << "Time: "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(finish - start).count()
+              << "ms\n" << "\033[0m";
+    std::cout << "\033[1;34m" << "----------------------------------------\n" << "\033[0m\n";
+
+    std::cout << "\033[1;32m" << "----------------------------------------\n" << "\033[0m";
+    std::cout << "\033[1;32m" << "RESULT: " << "\033[0m\n";
+    std::cout << "\033[1;32m" << "Result saved in : " << result_path << "\033[0m\n";
+    std::cout << "\033[1;32m" << "----------------------------------------\n" << "\033[0m\n";
+
+    // free the memory
+    free(input_filename);
+    free(result_path);
+    free(input_path);
+    free(edges_16);
+    free(edges_float);
+
+    return 0;
+}
@@ -0,0 +1,207 @@
+
+#include <iostream>
+#include <chrono>
+#include <filesystem>
+
+#define STB_IMAGE_IMPLEMENTATION
+
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+
+
+#include "../stb/stb_image.h"
+
+#include "../stb/stb_image_write.h"
+
+#include "../filters/sobel_filter.h"
+
+#include "../filters/hough_transform.h"
+
+#include "../config.h"
+
+#include "helper.cpp"
+
+namespace fs = std::filesystem;
+
+
+void guide() {
+    std::cout << "\033[1;33m" << "----------------------------------------\n" << "\033[0m";
+
+    std::cout << "\033[1;33m" << "GUIDE: " << "\033[0m\n";
+
+    std::cout << "\033[1;33m" << "No arguments were provided! Default values will be used!" << "\033[0m\n";
+    std::cout << "\033[1;33m"
+              << "Usage: ./sobel_hough_filter_runner.out <input_path> <input_filename> <result_path> <threshold> <min_votes> <max_lines>"
+              << "\033[0m\n";
+
+    std::cout << "\033[1;33m" << "Default values: " << "\033[0m\n";
+    std::cout << "\033[1;33m" << "input_path: " << DEFAULT_INPUT_PATH << "\033[0m\n";
+    std::cout << "\033[1;33m" << "input_filename: " << DEFAULT_INPUT_FILENAME << "\033[0m\n";
+    std::cout << "\033[1;33m" << "result_path: " << DEFAULT_RESULT_PATH << "\033[0m\n";
+    std::cout << "\033[1;33m" << "threshold: " << SOBEL_THRESHOLD << "\033[0m\n";
+    std::cout << "\033[1;33m" << "min_votes: " << HOUGH_MIN_VOTES << "\033[0m\n";
+    std::cout << "\033[1;33m" << "max_lines: " << HOUGH_MAX_LINES << "\033[0m\n";
+    std::cout << "\033[1;33m" << "Example: ./sobel_hough_filter_runner.out - - - 100 150 10" << "\033[0m\n";
+
+    std::cout << "\033[1;33m" << "----------------------------------------\n" << "\033[0m\n";
+}
+
+int main(int argc, char *argv[]) {
+
+    char *input_filename = (char *) malloc(sizeof(char) * FILENAME_MAX);
+    char *result_path = (char *) malloc(sizeof(char) * (FILENAME_MAX + PATH_MAX));
+    char *input_path = (char *) malloc(sizeof(char) * (FILENAME_MAX + PATH_MAX));
+
+    ubyte threshold;
+    long min_votes, max_lines;
+
+    if (argc == 7) {
+        SET_OR_DEFAULT(argv[1], input_path, DEFAULT_INPUT_PATH)
+        SET_OR_DEFAULT(argv[2], input_filename, DEFAULT_INPUT_FILENAME)
+        SET_OR_DEFAULT(argv[3], result_path, DEFAULT_RESULT_PATH)
+
+        if (!IS_IMAGE(input_filename)) { ERROR_COUT_AND_RETURN(INVALID_FILE_TYPE) }
+
+        // construct the input path
+        strcat(input_path, input_filename);
+
+        // check if the path is valid and the file exists
+        if (!PATH_EXISTS(input_path)) { ERROR_COUT_AND_RETURN(INVALID_FILE_PATH) }
+
+        // check if the result path is valid
+        if (!PATH_EXISTS(result_path)) { ERROR_COUT_AND_RETURN(INVALID_RESULT_PATH) }
+
+        // remove the extension
+        REMOVE_EXTENSION(input_filename)
+
+        strcat(result_path, input_filename);
+        strcat(result_path, "_hough.png");
+
+        // fourth arg is the threshold
+        int threshold_value = atoi(argv[4]);
+        if (threshold_value < 0 || threshold_value > 255) { ERROR_COUT_AND_RETURN(INVALID_THRESHOLD) }
+        threshold = (ubyte) threshold_value;
+
+        // fifth arg is the minimum number of votes
+        min_votes = atol(argv[5]);
+        if (min_votes < 1) { ERROR_COUT_AND_RETURN(INVALID_MIN_VOTES) }
+
+        // sixth arg is the maximum number of lines
+        max_lines = atol(argv[6]);
+        if (max_lines < 1) { ERROR_COUT_AND_RETURN(INVALID_MAX_LINES) }
+
+    } else if (argc == 1) {
+        // use default values
+        strcpy(input_path, DEFAULT_INPUT_PATH);
+        strcpy(input_filename, DEFAULT_INPUT_FILENAME);
+        strcat(input_path, input_filename);
+        strcpy(result_path, DEFAULT_RESULT_PATH);
+        threshold = SOBEL_THRESHOLD;
+        min_votes = HOUGH_MIN_VOTES;
+        max_lines = HOUGH_MAX_LINES;
+
+        if (!IS_IMAGE(input_path)) { ERROR_COUT_AND_RETURN(INVALID_FILE_TYPE) }
+        if (!PATH_EXISTS(input_path)) { ERROR_COUT_AND_RETURN(INVALID_FILE_PATH) }
+        if (!PATH_EXISTS(result_path)) { ERROR_COUT_AND_RETURN(INVALID_RESULT_PATH) }
+        if (min_votes < 1) { ERROR_COUT_AND_RETURN(INVALID_MIN_VOTES) }
+        if (max_lines < 1) { ERROR_COUT_AND_RETURN(INVALID_MAX_LINES) }
+
+
+        // remove the extension
+        REMOVE_EXTENSION(input_filename)
+        strcat(result_path, input_filename);
+        strcat(result_path, "_hough.png");
+
+        guide();
+
+    } else {
+        ERROR_COUT_AND_RETURN(INVALID_ARGUMENTS)
+    }
+
+    // read the image
+    int width, height, bpp;
+    ubyte *image = stbi_load(input_path, &width, &height, &bpp, 1);
+
+    // start the timer
+    auto start = std::chrono::high_resolution_clock::now();
+
+    // a single Sobel pass: the gradients restrict the votes of every edge pixel to the thetas around
+    // its orientation, and the edge map is derived from them
+    int16 *gx, *gy;
+    compute_gradients(image, &gx, &gy, width, height);
+
+    ubyte *edge_detected_image;
+    apply_edge_strength_gradients(
+            gx, gy,
+            &edge_detected_image,
+            width, height,
+            threshold, STRENGTH_RATIO);
+
+    hough_line *lines;
+    size_t count;
+    detect_lines(
+            edge_detected_image,
+            width, height,
+            threshold,
+            gx, gy,
+            HOUGH_ANGLE_WINDOW * M_PI / 180,
+            HOUGH_THETA_BINS,
+            (unsigned int) min_votes,
+            (size_t) max_lines,
+            &lines, &count);
+
+    // stop the timer
+    auto finish = std::chrono::high_resolution_clock::now();
+
+    // draw the lines in red over the gray image
+    auto *line_image = (ubyte *) malloc((size_t) width * height * 3);
+    for (size_t i = 0; i < (size_t) width * height; i++) {
+        line_image[3 * i] = line_image[3 * i + 1] = line_image[3 * i + 2] = image[i];
+    }
+    for (size_t k = 0; k < count; k++) {
+        double c = cos(lines[k].theta), s = sin(lines[k].theta);
+        bool steep = fabs(s) < fabs(c);
+        long steps = steep ? height : width;
+        for (long t = 0; t < steps; t++) {
+            long x = steep ? lround((lines[k].rho - t * s) / c) : t;
+            long y = steep ? t : lround((lines[k].rho - t * c) / s);
+            if (x < 0 || x >= width || y < 0 || y >= height) continue;
+            size_t index = 3 * ((size_t) y * width + x);
+            line_image[index] = 255;
+            line_image[index + 1] = line_image[index + 2] = 0;
+        }
+    }
+    stbi_write_png(result_path, width, height, 3, line_image, width * 3);
+
+
+    std::cout << "\033[1;34m" << "----------------------------------------\n" << "\033[0m";
+    std::cout << "\033[1;34m" << "REPORT: " << "\033[0m\n";
+
+    std::cout << "\033[1;34m" << "Time: "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(finish - start).count()
+              << "ms\n" << "\033[0m";
+    std::cout << "\033[1;34m" << "Lines: " << count << "\n" << "\033[0m";
+    for (size_t k = 0; k < count; k++) {
+        std::cout << "\033[1;34m" << "  rho: " << lines[k].rho
+                  << " theta: " << lines[k].theta * 180 / M_PI
+                  << " votes: " << lines[k].votes << "\n" << "\033[0m";
+    }
+    std::cout << "\033[1;34m" << "----------------------------------------\n" << "\033[0m\n";
+
+    std::cout << "\033[1;32m" << "----------------------------------------\n" << "\033[0m";
+    std::cout << "\033[1;32m" << "RESULT: " << "\033[0m\n";
+    std::cout << "\033[1;32m" << "Result saved in : " << result_path << "\033[0m\n";
+    std::cout << "\033[1;32m" << "----------------------------------------\n" << "\033[0m\n";
+
+    // free the memory
+    free(input_filename);
+    free(result_path);
+    free(input_path);
+    stbi_image_free(image);
+    stbi_image_free(edge_detected_image);
+    free(line_image);
+    free(gx);
+    free(gy);
+    free(lines);
+
+    return 0;
+}
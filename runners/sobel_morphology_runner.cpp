@@ -0,0 +1,191 @@
+
+#include <iostream>
+#include <chrono>
+#include <filesystem>
+
+#define STB_IMAGE_IMPLEMENTATION
+
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+
+
+#include "../stb/stb_image.h"
+
+#include "../stb/stb_image_write.h"
+
+#include "../filters/morphology_filter.h"
+
+#include "../config.h"
+
+#include "helper.cpp"
+
+namespace fs = std::filesystem;
+
+
+void guide() {
+    std::cout << "\033[1;33m" << "----------------------------------------\n" << "\033[0m";
+
+    std::cout << "\033[1;33m" << "GUIDE: " << "\033[0m\n";
+
+    std::cout << "\033[1;33m" << "No arguments were provided! Default values will be used!" << "\033[0m\n";
+    std::cout << "\033[1;33m"
+              << "Usage: ./sobel_morphology_filter_runner.out <input_path> <input_filename> <result_path> <operation> <element_width> <element_height> <threshold> <scale>"
+              << "\033[0m\n";
+
+    std::cout << "\033[1;33m" << "Default values: " << "\033[0m\n";
+    std::cout << "\033[1;33m" << "input_path: " << DEFAULT_INPUT_PATH << "\033[0m\n";
+    std::cout << "\033[1;33m" << "input_filename: " << DEFAULT_INPUT_FILENAME << "\033[0m\n";
+    std::cout << "\033[1;33m" << "result_path: " << DEFAULT_RESULT_PATH << "\033[0m\n";
+    std::cout << "\033[1;33m" << "operation: " << MORPHOLOGY_OPERATION << "\033[0m\n";
+    std::cout << "\033[1;33m" << "element_width: " << MORPHOLOGY_ELEMENT_SIZE << "\033[0m\n";
+    std::cout << "\033[1;33m" << "element_height: " << MORPHOLOGY_ELEMENT_SIZE << "\033[0m\n";
+    std::cout << "\033[1;33m" << "threshold: " << SOBEL_THRESHOLD << "\033[0m\n";
+    std::cout << "\033[1;33m" << "scale: " << STRENGTH_RATIO << "\033[0m\n";
+    std::cout << "\033[1;33m" << "operation is 'dilate', 'erode', 'close' or 'open'" << "\033[0m\n";
+    std::cout << "\033[1;33m" << "Example: ./sobel_morphology_filter_runner.out - - - close 5 5 50 0.3" << "\033[0m\n";
+
+    std::cout << "\033[1;33m" << "----------------------------------------\n" << "\033[0m\n";
+}
+
+/**
+ * Parses the name of a morphological operation.
+ *
+ * @param name The name of the operation.
+ * @param operation The parsed operation.
+ * @return false if the name is unknown.
+ */
+static bool parse_operation(const char *name, morphology_operation *operation) {
+    if (strcmp(name, "dilate") == 0) *operation = MORPHOLOGY_DILATE;
+    else if (strcmp(name, "erode") == 0) *operation = MORPHOLOGY_ERODE;
+    else if (strcmp(name, "close") == 0) *operation = MORPHOLOGY_CLOSE;
+    else if (strcmp(name, "open") == 0) *operation = MORPHOLOGY_OPEN;
+    else return false;
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+
+    char *input_filename = (char *) malloc(sizeof(char) * FILENAME_MAX);
+    char *result_path = (char *) malloc(sizeof(char) * (FILENAME_MAX + PATH_MAX));
+    char *input_path = (char *) malloc(sizeof(char) * (FILENAME_MAX + PATH_MAX));
+
+    morphology_operation operation;
+    long element_width, element_height;
+    ubyte threshold;
+    double scale;
+
+    if (argc == 9) {
+        SET_OR_DEFAULT(argv[1], input_path, DEFAULT_INPUT_PATH)
+        SET_OR_DEFAULT(argv[2], input_filename, DEFAULT_INPUT_FILENAME)
+        SET_OR_DEFAULT(argv[3], result_path, DEFAULT_RESULT_PATH)
+
+        if (!IS_IMAGE(input_filename)) { ERROR_COUT_AND_RETURN(INVALID_FILE_TYPE) }
+
+        // construct the input path
+        strcat(input_path, input_filename);
+
+        // check if the path is valid and the file exists
+        if (!PATH_EXISTS(input_path)) { ERROR_COUT_AND_RETURN(INVALID_FILE_PATH) }
+
+        // check if the result path is valid
+        if (!PATH_EXISTS(result_path)) { ERROR_COUT_AND_RETURN(INVALID_RESULT_PATH) }
+
+        // remove the extension
+        REMOVE_EXTENSION(input_filename)
+
+        strcat(result_path, input_filename);
+        strcat(result_path, "_sobel_morphology.png");
+
+        // fourth arg is the operation
+        if (!parse_operation(strcmp(argv[4], "-") == 0 ? MORPHOLOGY_OPERATION : argv[4], &operation)) {
+            ERROR_COUT_AND_RETURN(INVALID_MORPHOLOGY_OPERATION)
+        }
+
+        // fifth and sixth args are the size of the structuring element
+        element_width = strcmp(argv[5], "-") == 0 ? MORPHOLOGY_ELEMENT_SIZE : atol(argv[5]);
+        element_height = strcmp(argv[6], "-") == 0 ? MORPHOLOGY_ELEMENT_SIZE : atol(argv[6]);
+        if (element_width < 1 || element_height < 1) { ERROR_COUT_AND_RETURN(INVALID_ELEMENT_SIZE) }
+
+        // seventh arg is the threshold
+        int threshold_value = atoi(argv[7]);
+        if (threshold_value < 0 || threshold_value > 255) { ERROR_COUT_AND_RETURN(INVALID_THRESHOLD) }
+        threshold = (ubyte) threshold_value;
+
+        // eighth arg is the scale
+        scale = atof(argv[8]);
+        if (scale < 0 || scale > 1) { ERROR_COUT_AND_RETURN(INVALID_SCALE_FACTOR) }
+
+    } else if (argc == 1) {
+        // use default values
+        strcpy(input_path, DEFAULT_INPUT_PATH);
+        strcpy(input_filename, DEFAULT_INPUT_FILENAME);
+        strcat(input_path, input_filename);
+        strcpy(result_path, DEFAULT_RESULT_PATH);
+        element_width = element_height = MORPHOLOGY_ELEMENT_SIZE;
+        threshold = SOBEL_THRESHOLD;
+        scale = STRENGTH_RATIO;
+
+        if (!IS_IMAGE(input_path)) { ERROR_COUT_AND_RETURN(INVALID_FILE_TYPE) }
+        if (!PATH_EXISTS(input_path)) { ERROR_COUT_AND_RETURN(INVALID_FILE_PATH) }
+        if (!PATH_EXISTS(result_path)) { ERROR_COUT_AND_RETURN(INVALID_RESULT_PATH) }
+        if (!parse_operation(MORPHOLOGY_OPERATION, &operation)) { ERROR_COUT_AND_RETURN(INVALID_MORPHOLOGY_OPERATION) }
+        if (element_width < 1 || element_height < 1) { ERROR_COUT_AND_RETURN(INVALID_ELEMENT_SIZE) }
+        if (scale < 0 || scale > 1) { ERROR_COUT_AND_RETURN(INVALID_SCALE_FACTOR) }
+
+
+        // remove the extension
+        REMOVE_EXTENSION(input_filename)
+        strcat(result_path, input_filename);
+        strcat(result_path, "_sobel_morphology.png");
+
+        guide();
+
+    } else {
+        ERROR_COUT_AND_RETURN(INVALID_ARGUMENTS)
+    }
+
+    // read the image
+    int width, height, bpp;
+    ubyte *image = stbi_load(input_path, &width, &height, &bpp, 1);
+
+    // start the timer
+    auto start = std::chrono::high_resolution_clock::now();
+
+    // apply the filters
+    ubyte *edge_detected_image;
+    detect_edges_morphology(
+            image,
+            &edge_detected_image,
+            width, height,
+            threshold, scale,
+            element_width, element_height,
+            operation);
+
+    // stop the timer
+    auto finish = std::chrono::high_resolution_clock::now();
+
+    // write the image
+    stbi_write_png(result_path, width, height, 1, edge_detected_image, width);
+
+
+    std::cout << "\033[1;34m" << "----------------------------------------\n" << "\033[0m";
+    std::cout << "\033[1;34m" << "REPORT: " << "\033[0m\n";
+
+    std::cout << "\033[1;34m" << "Time: "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(finish - start).count()
+              << "ms\n" << "\033[0m";
+    std::cout << "\033[1;34m" << "----------------------------------------\n" << "\033[0m\n";
+
+    std::cout << "\033[1;32m" << "----------------------------------------\n" << "\033[0m";
+    std::cout << "\033[1;32m" << "RESULT: " << "\033[0m\n";
+    std::cout << "\033[1;32m" << "Result saved in : " << result_path << "\033[0m\n";
+    std::cout << "\033[1;32m" << "----------------------------------------\n" << "\033[0m\n";
+
+    // free the memory
+    free(input_filename);
+    free(result_path);
+    free(input_path);
+    stbi_image_free(image);
+    stbi_image_free(edge_detected_image);
+
+    return 0;
+}
@@ -0,0 +1,204 @@
+
+#include <iostream>
+#include <chrono>
+#include <filesystem>
+#include <vector>
+
+#define STB_IMAGE_IMPLEMENTATION
+
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+
+
+#include "../stb/stb_image.h"
+
+#include "../stb/stb_image_write.h"
+
+#include "../filters/sobel_filter.h"
+
+#include "../filters/jpeg_decoder.h"
+
+#include "../filters/resize_filter.h"
+
+#include "../config.h"
+
+#include "helper.cpp"
+
+namespace fs = std::filesystem;
+
+
+void guide() {
+    std::cout << "\033[1;33m" << "----------------------------------------\n" << "\033[0m";
+
+    std::cout << "\033[1;33m" << "GUIDE: " << "\033[0m\n";
+
+    std::cout << "\033[1;33m" << "No arguments were provided! Default values will be used!" << "\033[0m\n";
+    std::cout << "\033[1;33m"
+              << "Usage: ./sobel_preview_filter_runner.out <input_path> <input_filename> <result_path> <threshold> <scale> <reduction>"
+              << "\033[0m\n";
+
+    std::cout << "\033[1;33m" << "Default values: " << "\033[0m\n";
+    std::cout << "\033[1;33m" << "input_path: " << DEFAULT_INPUT_PATH << "\033[0m\n";
+    std::cout << "\033[1;33m" << "input_filename: " << DEFAULT_INPUT_FILENAME << "\033[0m\n";
+    std::cout << "\033[1;33m" << "result_path: " << DEFAULT_RESULT_PATH << "\033[0m\n";
+    std::cout << "\033[1;33m" << "threshold: " << SOBEL_THRESHOLD << "\033[0m\n";
+    std::cout << "\033[1;33m" << "scale: " << STRENGTH_RATIO << "\033[0m\n";
+    std::cout << "\033[1;33m" << "reduction: " << PREVIEW_REDUCTION << "\033[0m\n";
+    std::cout << "\033[1;33m" << "Example: ./sobel_preview_filter_runner.out - photo.jpg - 50 0.3 4" << "\033[0m\n";
+
+    std::cout << "\033[1;33m" << "----------------------------------------\n" << "\033[0m\n";
+}
+
+/**
+ * Decodes an image to gray scale at 1 / reduction of its size.
+ *
+ * JPEGs are decoded directly at the reduced size, other images are decoded at full size and reduced with area
+ * averaging.
+ */
+static int decode_reduced(const char *path, size_t reduction, ubyte **image, size_t *width, size_t *height) {
+    if (IS_JPEG(path)) {
+        std::vector<ubyte> data;
+        if (!read_file(path, data)) return 1;
+        return decode_jpeg_gray_scaled(data.data(), data.size(), reduction, image, width, height);
+    }
+
+    int full_width, full_height, bpp;
+    ubyte *full = stbi_load(path, &full_width, &full_height, &bpp, 1);
+    if (full == nullptr) return 1;
+
+    *width = ((size_t) full_width + reduction - 1) / reduction;
+    *height = ((size_t) full_height + reduction - 1) / reduction;
+    int result = resize_image(full, image, full_width, full_height, 1, *width, *height, RESIZE_AREA);
+    stbi_image_free(full);
+    return result;
+}
+
+int main(int argc, char *argv[]) {
+
+    char *input_filename = (char *) malloc(sizeof(char) * FILENAME_MAX);
+    char *result_path = (char *) malloc(sizeof(char) * (FILENAME_MAX + PATH_MAX));
+    char *input_path = (char *) malloc(sizeof(char) * (FILENAME_MAX + PATH_MAX));
+
+    ubyte threshold;
+    double scale;
+    long reduction;
+
+    if (argc == 7) {
+        SET_OR_DEFAULT(argv[1], input_path, DEFAULT_INPUT_PATH)
+        SET_OR_DEFAULT(argv[2], input_filename, DEFAULT_INPUT_FILENAME)
+        SET_OR_DEFAULT(argv[3], result_path, DEFAULT_RESULT_PATH)
+
+        if (!IS_IMAGE(input_filename)) { ERROR_COUT_AND_RETURN(INVALID_FILE_TYPE) }
+
+        // construct the input path
+        strcat(input_path, input_filename);
+
+        // check if the path is valid and the file exists
+        if (!PATH_EXISTS(input_path)) { ERROR_COUT_AND_RETURN(INVALID_FILE_PATH) }
+
+        // check if the result path is valid
+        if (!PATH_EXISTS(result_path)) { ERROR_COUT_AND_RETURN(INVALID_RESULT_PATH) }
+
+        // remove the extension
+        REMOVE_EXTENSION(input_filename)
+
+        strcat(result_path, input_filename);
+        strcat(result_path, "_sobel_preview.png");
+
+        // fourth arg is the threshold
+        int threshold_value = atoi(argv[4]);
+        if (threshold_value < 0 || threshold_value > 255) { ERROR_COUT_AND_RETURN(INVALID_THRESHOLD) }
+        threshold = (ubyte) threshold_value;
+
+        // fifth arg is the scale
+        scale = atof(argv[5]);
+        if (scale < 0 || scale > 1) { ERROR_COUT_AND_RETURN(INVALID_SCALE_FACTOR) }
+
+        // sixth arg is the reduction
+        reduction = strcmp(argv[6], "-") == 0 ? PREVIEW_REDUCTION : atol(argv[6]);
+        if (reduction != 1 && reduction != 2 && reduction != 4 && reduction != 8) {
+            ERROR_COUT_AND_RETURN(INVALID_REDUCTION)
+        }
+
+    } else if (argc == 1) {
+        // use default values
+        strcpy(input_path, DEFAULT_INPUT_PATH);
+        strcpy(input_filename, DEFAULT_INPUT_FILENAME);
+        strcat(input_path, input_filename);
+        strcpy(result_path, DEFAULT_RESULT_PATH);
+        threshold = SOBEL_THRESHOLD;
+        scale = STRENGTH_RATIO;
+        reduction = PREVIEW_REDUCTION;
+
+        if (!IS_IMAGE(input_path)) { ERROR_COUT_AND_RETURN(INVALID_FILE_TYPE) }
+        if (!PATH_EXISTS(input_path)) { ERROR_COUT_AND_RETURN(INVALID_FILE_PATH) }
+        if (!PATH_EXISTS(result_path)) { ERROR_COUT_AND_RETURN(INVALID_RESULT_PATH) }
+        if (scale < 0 || scale > 1) { ERROR_COUT_AND_RETURN(INVALID_SCALE_FACTOR) }
+        if (reduction != 1 && reduction != 2 && reduction != 4 && reduction != 8) {
+            ERROR_COUT_AND_RETURN(INVALID_REDUCTION)
+        }
+
+
+        // remove the extension
+        REMOVE_EXTENSION(input_filename)
+        strcat(result_path, input_filename);
+        strcat(result_path, "_sobel_preview.png");
+
+        guide();
+
+    } else {
+        ERROR_COUT_AND_RETURN(INVALID_ARGUMENTS)
+    }
+
+    // start the timer, the decoding is part of the work
+    auto start = std::chrono::high_resolution_clock::now();
+
+    // read the image at the reduced size
+    ubyte *image;
+    size_t width, height;
+    if (decode_reduced(input_path, (size_t) reduction, &image, &width, &height) != 0) {
+        ERROR_COUT_AND_RETURN(INVALID_IMAGE)
+    }
+
+    auto decoded = std::chrono::high_resolution_clock::now();
+
+    // apply the filters
+    ubyte *edge_detected_image;
+    detect_edges(
+            image,
+            &edge_detected_image,
+            width, height,
+            threshold, scale, 2);
+
+    // stop the timer
+    auto finish = std::chrono::high_resolution_clock::now();
+
+    // write the image
+    stbi_write_png(result_path, (int) width, (int) height, 1, edge_detected_image, (int) width);
+
+
+    std::cout << "\033[1;34m" << "----------------------------------------\n" << "\033[0m";
+    std::cout << "\033[1;34m" << "REPORT: " << "\033[0m\n";
+
+    std::cout << "\033[1;34m" << "Size: " << width << "x" << height << "\n" << "\033[0m";
+    std::cout << "\033[1;34m" << "Decode time: "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(decoded - start).count()
+              << "ms\n" << "\033[0m";
+    std::cout << "\033[1;34m" << "Time: "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(finish - start).count()
+              << "ms\n" << "\033[0m";
+    std::cout << "\033[1;34m" << "----------------------------------------\n" << "\033[0m\n";
+
+    std::cout << "\033[1;32m" << "----------------------------------------\n" << "\033[0m";
+    std::cout << "\033[1;32m" << "RESULT: " << "\033[0m\n";
+    std::cout << "\033[1;32m" << "Result saved in : " << result_path << "\033[0m\n";
+    std::cout << "\033[1;32m" << "----------------------------------------\n" << "\033[0m\n";
+
+    // free the memory
+    free(input_filename);
+    free(result_path);
+    free(input_path);
+    free(image);
+    free(edge_detected_image);
+
+    return 0;
+}
@@ -0,0 +1,214 @@
+
+#include <iostream>
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#define STB_IMAGE_IMPLEMENTATION
+
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+
+
+#include "../stb/stb_image.h"
+
+#include "../stb/stb_image_write.h"
+
+#include "../filters/roi_filter.h"
+
+#include "../config.h"
+
+#include "helper.cpp"
+
+namespace fs = std::filesystem;
+
+
+void guide() {
+    std::cout << "\033[1;33m" << "----------------------------------------\n" << "\033[0m";
+
+    std::cout << "\033[1;33m" << "GUIDE: " << "\033[0m\n";
+
+    std::cout << "\033[1;33m" << "No arguments were provided! Default values will be used!" << "\033[0m\n";
+    std::cout << "\033[1;33m"
+              << "Usage: ./sobel_roi_filter_runner.out <input_path> <input_filename> <result_path> <threshold> <scale> <regions>"
+              << "\033[0m\n";
+
+    std::cout << "\033[1;33m" << "Default values: " << "\033[0m\n";
+    std::cout << "\033[1;33m" << "input_path: " << DEFAULT_INPUT_PATH << "\033[0m\n";
+    std::cout << "\033[1;33m" << "input_filename: " << DEFAULT_INPUT_FILENAME << "\033[0m\n";
+    std::cout << "\033[1;33m" << "result_path: " << DEFAULT_RESULT_PATH << "\033[0m\n";
+    std::cout << "\033[1;33m" << "threshold: " << SOBEL_THRESHOLD << "\033[0m\n";
+    std::cout << "\033[1;33m" << "scale: " << STRENGTH_RATIO << "\033[0m\n";
+    std::cout << "\033[1;33m" << "regions: " << SOBEL_ROI_REGIONS << "\033[0m\n";
+    std::cout << "\033[1;33m" << "The regions are 'x,y,width,height' rectangles separated by ';', or a png mask in the input path!"
+              << "\033[0m\n";
+    std::cout << "\033[1;33m" << "Example: ./sobel_roi_filter_runner.out - - - 50 0.3 mask.png" << "\033[0m\n";
+
+    std::cout << "\033[1;33m" << "----------------------------------------\n" << "\033[0m\n";
+}
+
+/**
+ * Parses a list of rectangles.
+ *
+ * @param text Rectangles written as "x,y,width,height", separated by ';'.
+ * @param rois The parsed rectangles.
+ * @return false if the list is malformed.
+ */
+static bool parse_rois(const char *text, std::vector<roi> *rois) {
+    rois->clear();
+    while (*text != '\0') {
+        long x, y, w, h;
+        int consumed;
+        if (sscanf(text, "%ld,%ld,%ld,%ld%n", &x, &y, &w, &h, &consumed) != 4) return false;
+        if (x < 0 || y < 0 || w < 1 || h < 1) return false;
+        rois->push_back({(size_t) x, (size_t) y, (size_t) w, (size_t) h});
+
+        text += consumed;
+        if (*text == ';') text++;
+        else if (*text != '\0') return false;
+    }
+    return !rois->empty();
+}
+
+int main(int argc, char *argv[]) {
+
+    char *input_filename = (char *) malloc(sizeof(char) * FILENAME_MAX);
+    char *result_path = (char *) malloc(sizeof(char) * (FILENAME_MAX + PATH_MAX));
+    char *input_path = (char *) malloc(sizeof(char) * (FILENAME_MAX + PATH_MAX));
+
+    ubyte threshold;
+    double scale;
+    char *regions = (char *) malloc(sizeof(char) * (FILENAME_MAX + PATH_MAX));
+    std::vector<roi> rois;
+
+    if (argc == 7) {
+        SET_OR_DEFAULT(argv[1], input_path, DEFAULT_INPUT_PATH)
+        SET_OR_DEFAULT(argv[2], input_filename, DEFAULT_INPUT_FILENAME)
+        SET_OR_DEFAULT(argv[3], result_path, DEFAULT_RESULT_PATH)
+
+        if (!IS_IMAGE(input_filename)) { ERROR_COUT_AND_RETURN(INVALID_FILE_TYPE) }
+
+        // construct the input path
+        strcat(input_path, input_filename);
+
+        // check if the path is valid and the file exists
+        if (!PATH_EXISTS(input_path)) { ERROR_COUT_AND_RETURN(INVALID_FILE_PATH) }
+
+        // check if the result path is valid
+        if (!PATH_EXISTS(result_path)) { ERROR_COUT_AND_RETURN(INVALID_RESULT_PATH) }
+
+        // remove the extension
+        REMOVE_EXTENSION(input_filename)
+
+        strcat(result_path, input_filename);
+        strcat(result_path, "_sobel_roi.png");
+
+        // fourth arg is the threshold
+        int threshold_value = atoi(argv[4]);
+        if (threshold_value < 0 || threshold_value > 255) { ERROR_COUT_AND_RETURN(INVALID_THRESHOLD) }
+        threshold = (ubyte) threshold_value;
+
+        // fifth arg is the scale
+        scale = atof(argv[5]);
+        if (scale < 0 || scale > 1) { ERROR_COUT_AND_RETURN(INVALID_SCALE_FACTOR) }
+
+        // sixth arg is the regions, a list of rectangles or a mask
+        SET_OR_DEFAULT(argv[6], regions, SOBEL_ROI_REGIONS)
+
+    } else if (argc == 1) {
+        // use default values
+        strcpy(input_path, DEFAULT_INPUT_PATH);
+        strcpy(input_filename, DEFAULT_INPUT_FILENAME);
+        strcat(input_path, input_filename);
+        strcpy(result_path, DEFAULT_RESULT_PATH);
+        threshold = SOBEL_THRESHOLD;
+        scale = STRENGTH_RATIO;
+        strcpy(regions, SOBEL_ROI_REGIONS);
+
+        if (!IS_IMAGE(input_path)) { ERROR_COUT_AND_RETURN(INVALID_FILE_TYPE) }
+        if (!PATH_EXISTS(input_path)) { ERROR_COUT_AND_RETURN(INVALID_FILE_PATH) }
+        if (!PATH_EXISTS(result_path)) { ERROR_COUT_AND_RETURN(INVALID_RESULT_PATH) }
+        if (scale < 0 || scale > 1) { ERROR_COUT_AND_RETURN(INVALID_SCALE_FACTOR) }
+
+
+        // remove the extension
+        REMOVE_EXTENSION(input_filename)
+        strcat(result_path, input_filename);
+        strcat(result_path, "_sobel_roi.png");
+
+        guide();
+
+    } else {
+        ERROR_COUT_AND_RETURN(INVALID_ARGUMENTS)
+    }
+
+    // a png is a mask next to the input image, anything else a list of rectangles
+    bool use_mask = IS_PNG(regions);
+    std::string mask_path = (fs::path(input_path).parent_path() / regions).string();
+    if (use_mask && !PATH_EXISTS(mask_path)) { ERROR_COUT_AND_RETURN(INVALID_FILE_PATH) }
+    if (!use_mask && !parse_rois(regions, &rois)) { ERROR_COUT_AND_RETURN(INVALID_REGIONS) }
+
+    // read the image
+    int width, height, bpp;
+    ubyte *image = stbi_load(input_path, &width, &height, &bpp, 1);
+
+    // read the mask, it must have the size of the image
+    ubyte *mask = nullptr;
+    if (use_mask) {
+        int mask_width, mask_height;
+        mask = stbi_load(mask_path.c_str(), &mask_width, &mask_height, &bpp, 1);
+        if (mask == nullptr || mask_width != width || mask_height != height) { ERROR_COUT_AND_RETURN(INVALID_MASK) }
+    }
+
+    // start the timer
+    auto start = std::chrono::high_resolution_clock::now();
+
+    // apply the filters
+    ubyte *edge_detected_image;
+    if (use_mask) {
+        detect_edges_masked(
+                image,
+                &edge_detected_image,
+                width, height,
+                mask,
+                threshold, scale);
+    } else {
+        detect_edges_roi(
+                image,
+                &edge_detected_image,
+                width, height,
+                rois.data(), rois.size(),
+                threshold, scale);
+    }
+
+    // stop the timer
+    auto finish = std::chrono::high_resolution_clock::now();
+
+    // write the image
+    stbi_write_png(result_path, width, height, 1, edge_detected_image, width);
+
+
+    std::cout << "\033[1;34m" << "----------------------------------------\n" << "\033[0m";
+    std::cout << "\033[1;34m" << "REPORT: " << "\033[0m\n";
+
+    std::cout << "\033[1;34m" << "Time: "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(finish - start).count()
+              << "ms\n" << "\033[0m";
+    std::cout << "\033[1;34m" << "----------------------------------------\n" << "\033[0m\n";
+
+    std::cout << "\033[1;32m" << "----------------------------------------\n" << "\033[0m";
+    std::cout << "\033[1;32m" << "RESULT: " << "\033[0m\n";
+    std::cout << "\033[1;32m" << "Result saved in : " << result_path << "\033[0m\n";
+    std::cout << "\033[1;32m" << "----------------------------------------\n" << "\033[0m\n";
+
+    // free the memory
+    free(input_filename);
+    free(result_path);
+    free(input_path);
+    free(regions);
+    stbi_image_free(image);
+    stbi_image_free(mask);
+    stbi_image_free(edge_detected_image);
+
+    return 0;
+}
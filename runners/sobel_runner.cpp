@@ -2,6 +2,7 @@
 #include <iostream>
 #include <chrono>
 #include <filesystem>
+#include <string>
 
 #define STB_IMAGE_IMPLEMENTATION
 
@@ -14,6 +15,8 @@
 
 #include "../filters/sobel_filter.h"
 
+#include "../filters/image_hash.h"
+
 #include "../config.h"
 
 #include "helper.cpp"
@@ -28,7 +31,7 @@ void guide() {
 
     std::cout << "\033[1;33m" << "No arguments were provided! Default values will be used!" << "\033[0m\n";
     std::cout << "\033[1;33m"
-              << "Usage: ./sobel_filter_runner.out <input_path> <input_filename> <result_path> <threshold> <scale>"
+              << "Usage: ./sobel_filter_runner.out <input_path> <input_filename> <result_path> <threshold> <scale> [hash_method]"
               << "\033[0m\n";
 
     std::cout << "\033[1;33m" << "Default values: " << "\033[0m\n";
@@ -37,11 +40,28 @@ void guide() {
     std::cout << "\033[1;33m" << "result_path: " << DEFAULT_RESULT_PATH << "\033[0m\n";
     std::cout << "\033[1;33m" << "threshold: " << SOBEL_THRESHOLD << "\033[0m\n";
     std::cout << "\033[1;33m" << "scale: " << STRENGTH_RATIO << "\033[0m\n";
+    std::cout << "\033[1;33m" << "hash_method: none (ahash, dhash or phash appends the hash of the image to "
+              << HASH_FILENAME << ")" << "\033[0m\n";
     std::cout << "\033[1;33m" << "Example: ./sobel_filter_runner.out - - - 50 0.3" << "\033[0m\n";
 
     std::cout << "\033[1;33m" << "----------------------------------------\n" << "\033[0m\n";
 }
 
+/**
+ * Parses the name of a hash method.
+ *
+ * @param name "ahash", "dhash" or "phash".
+ * @param method The parsed method.
+ * @return false if the name is unknown.
+ */
+static bool parse_hash_method(const char *name, hash_method *method) {
+    if (strcmp(name, "ahash") == 0) *method = HASH_AVERAGE;
+    else if (strcmp(name, "dhash") == 0) *method = HASH_DIFFERENCE;
+    else if (strcmp(name, "phash") == 0) *method = HASH_PERCEPTUAL;
+    else return false;
+    return true;
+}
+
 int main(int argc, char *argv[]) {
 
     char *input_filename = (char *) malloc(sizeof(char) * FILENAME_MAX);
@@ -51,12 +71,17 @@ int main(int argc, char *argv[]) {
     ubyte threshold;
     double scale;
 
-    if (argc == 6) {
+    // the hash file and the name the image is recorded under, when the image is hashed
+    bool hash = false;
+    hash_method method;
+    std::string hash_path, hashed_filename;
+
+    if (argc == 6 || argc == 7) {
         SET_OR_DEFAULT(argv[1], input_path, DEFAULT_INPUT_PATH)
         SET_OR_DEFAULT(argv[2], input_filename, DEFAULT_INPUT_FILENAME)
         SET_OR_DEFAULT(argv[3], result_path, DEFAULT_RESULT_PATH)
 
-        if (!IS_PNG(input_filename)) { ERROR_COUT_AND_RETURN(INVALID_FILE_TYPE) }
+        if (!IS_IMAGE(input_filename)) { ERROR_COUT_AND_RETURN(INVALID_FILE_TYPE) }
 
         // construct the input path
         strcat(input_path, input_filename);
@@ -67,20 +92,32 @@ int main(int argc, char *argv[]) {
         // check if the result path is valid
         if (!PATH_EXISTS(result_path)) { ERROR_COUT_AND_RETURN(INVALID_RESULT_PATH) }
 
-        // remove the .png extension
-        input_filename[strlen(input_filename) - 4] = '\0';
+        hash_path = std::string(result_path) + HASH_FILENAME;
+        hashed_filename = input_filename;
+
+        // remove the extension
+        REMOVE_EXTENSION(input_filename)
 
         strcat(result_path, input_filename);
         strcat(result_path, "_sobel.png");
 
         // fourth arg is the threshold
-        threshold = (ubyte) atoi(argv[4]);
-        if (threshold < 0 || threshold > 255) { ERROR_COUT_AND_RETURN(INVALID_THRESHOLD) }
+        int threshold_value = atoi(argv[4]);
+        if (threshold_value < 0 || threshold_value > 255) { ERROR_COUT_AND_RETURN(INVALID_THRESHOLD) }
+        threshold = (ubyte) threshold_value;
 
         // fifth arg is the scale
         scale = atof(argv[5]);
         if (scale < 0 || scale > 1) { ERROR_COUT_AND_RETURN(INVALID_SCALE_FACTOR) }
 
+        // the optional sixth arg is the hash method
+        if (argc == 7) {
+            if (!parse_hash_method(strcmp(argv[6], "-") == 0 ? HASH_METHOD : argv[6], &method)) {
+                ERROR_COUT_AND_RETURN(INVALID_HASH_METHOD)
+            }
+            hash = true;
+        }
+
     } else if (argc == 1) {
         // use default values
         strcpy(input_path, DEFAULT_INPUT_PATH);
@@ -90,15 +127,14 @@ int main(int argc, char *argv[]) {
         threshold = SOBEL_THRESHOLD;
         scale = STRENGTH_RATIO;
 
-        if (!IS_PNG(input_path)) { ERROR_COUT_AND_RETURN(INVALID_FILE_TYPE) }
+        if (!IS_IMAGE(input_path)) { ERROR_COUT_AND_RETURN(INVALID_FILE_TYPE) }
         if (!PATH_EXISTS(input_path)) { ERROR_COUT_AND_RETURN(INVALID_FILE_PATH) }
         if (!PATH_EXISTS(result_path)) { ERROR_COUT_AND_RETURN(INVALID_RESULT_PATH) }
-        if (threshold < 0 || threshold > 255) { ERROR_COUT_AND_RETURN(INVALID_THRESHOLD) }
         if (scale < 0 || scale > 1) { ERROR_COUT_AND_RETURN(INVALID_SCALE_FACTOR) }
 
 
-        // remove the .png extension
-        input_filename[strlen(input_filename) - 4] = '\0';
+        // remove the extension
+        REMOVE_EXTENSION(input_filename)
         strcat(result_path, input_filename);
         strcat(result_path, "_sobel.png");
 
@@ -126,6 +162,22 @@ int main(int argc, char *argv[]) {
     // stop the timer
     auto finish = std::chrono::high_resolution_clock::now();
 
+    // hash the image that was already decoded, so finding duplicates needs no second decode
+    std::chrono::high_resolution_clock::duration hash_time{};
+    if (hash) {
+        auto hash_start = std::chrono::high_resolution_clock::now();
+        hash64 hash_value;
+        if (compute_image_hash(image, width, height, 1, method, &hash_value) != 0) {
+            ERROR_COUT_AND_RETURN(INVALID_FILE_PATH)
+        }
+        hash_time = std::chrono::high_resolution_clock::now() - hash_start;
+
+        FILE *hash_file = fopen(hash_path.c_str(), "a");
+        if (hash_file == nullptr) { ERROR_COUT_AND_RETURN(INVALID_RESULT_PATH) }
+        fprintf(hash_file, "%016llx %s\n", hash_value, hashed_filename.c_str());
+        if (fclose(hash_file) != 0) { ERROR_COUT_AND_RETURN(INVALID_RESULT_PATH) }
+    }
+
     // write the image
     stbi_write_png(result_path, width, height, 1, edge_detected_image, width);
 
@@ -136,11 +188,17 @@ int main(int argc, char *argv[]) {
     std::cout << "\033[1;34m" << "Time: "
               << std::chrono::duration_cast<std::chrono::milliseconds>(finish - start).count()
               << "ms\n" << "\033[0m";
+    if (hash) {
+        std::cout << "\033[1;34m" << "Hash time: "
+                  << std::chrono::duration_cast<std::chrono::milliseconds>(hash_time).count()
+                  << "ms\n" << "\033[0m";
+    }
     std::cout << "\033[1;34m" << "----------------------------------------\n" << "\033[0m\n";
 
     std::cout << "\033[1;32m" << "----------------------------------------\n" << "\033[0m";
     std::cout << "\033[1;32m" << "RESULT: " << "\033[0m\n";
     std::cout << "\033[1;32m" << "Result saved in : " << result_path << "\033[0m\n";
+    if (hash) std::cout << "\033[1;32m" << "Hash appended to : " << hash_path << "\033[0m\n";
     std::cout << "\033[1;32m" << "----------------------------------------\n" << "\033[0m\n";
 
     // free the memory
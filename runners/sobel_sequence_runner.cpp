@@ -0,0 +1,186 @@
+#include <iostream>
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#define STB_IMAGE_IMPLEMENTATION
+
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+
+
+#include "../stb/stb_image.h"
+
+#include "../stb/stb_image_write.h"
+
+#include "../filters/temporal_filter.h"
+
+#include "../config.h"
+
+#include "helper.cpp"
+
+namespace fs = std::filesystem;
+
+
+void guide() {
+    std::cout << "\033[1;33m" << "----------------------------------------\n" << "\033[0m";
+
+    std::cout << "\033[1;33m" << "GUIDE: " << "\033[0m\n";
+
+    std::cout << "\033[1;33m" << "No arguments were provided! Default values will be used!" << "\033[0m\n";
+    std::cout << "\033[1;33m"
+              << "Usage: ./sobel_sequence_filter_runner.out <input_path> <prefix> <result_path> <threshold> <scale> <tolerance>"
+              << "\033[0m\n";
+
+    std::cout << "\033[1;33m" << "Default values: " << "\033[0m\n";
+    std::cout << "\033[1;33m" << "input_path: " << DEFAULT_INPUT_PATH << "\033[0m\n";
+    std::cout << "\033[1;33m" << "prefix: " << SEQUENCE_PREFIX << "\033[0m\n";
+    std::cout << "\033[1;33m" << "result_path: " << DEFAULT_RESULT_PATH << "\033[0m\n";
+    std::cout << "\033[1;33m" << "threshold: " << SOBEL_THRESHOLD << "\033[0m\n";
+    std::cout << "\033[1;33m" << "scale: " << STRENGTH_RATIO << "\033[0m\n";
+    std::cout << "\033[1;33m" << "tolerance: " << (int) SEQUENCE_TOLERANCE << "\033[0m\n";
+    std::cout << "\033[1;33m" << "The frames are the png files of the input path starting with the prefix, in name order!"
+              << "\033[0m\n";
+    std::cout << "\033[1;33m" << "Example: ./sobel_sequence_filter_runner.out /home/user/frames/ frame_ - 50 0.3 2"
+              << "\033[0m\n";
+
+    std::cout << "\033[1;33m" << "----------------------------------------\n" << "\033[0m\n";
+}
+
+int main(int argc, char *argv[]) {
+
+    char *prefix = (char *) malloc(sizeof(char) * FILENAME_MAX);
+    char *result_path = (char *) malloc(sizeof(char) * (FILENAME_MAX + PATH_MAX));
+    char *input_path = (char *) malloc(sizeof(char) * (FILENAME_MAX + PATH_MAX));
+
+    ubyte threshold;
+    double scale;
+    long tolerance;
+
+    if (argc == 7) {
+        SET_OR_DEFAULT(argv[1], input_path, DEFAULT_INPUT_PATH)
+        SET_OR_DEFAULT(argv[2], prefix, SEQUENCE_PREFIX)
+        SET_OR_DEFAULT(argv[3], result_path, DEFAULT_RESULT_PATH)
+
+        // check if the paths are valid
+        if (!PATH_EXISTS(input_path)) { ERROR_COUT_AND_RETURN(INVALID_FILE_PATH) }
+        if (!PATH_EXISTS(result_path)) { ERROR_COUT_AND_RETURN(INVALID_RESULT_PATH) }
+
+        // fourth arg is the threshold
+        int threshold_value = atoi(argv[4]);
+        if (threshold_value < 0 || threshold_value > 255) { ERROR_COUT_AND_RETURN(INVALID_THRESHOLD) }
+        threshold = (ubyte) threshold_value;
+
+        // fifth arg is the scale
+        scale = atof(argv[5]);
+        if (scale < 0 || scale > 1) { ERROR_COUT_AND_RETURN(INVALID_SCALE_FACTOR) }
+
+        // sixth arg is the tolerance
+        tolerance = strcmp(argv[6], "-") == 0 ? SEQUENCE_TOLERANCE : atol(argv[6]);
+        if (tolerance < 0 || tolerance > 255) { ERROR_COUT_AND_RETURN(INVALID_TOLERANCE) }
+
+    } else if (argc == 1) {
+        // use default values
+        strcpy(input_path, DEFAULT_INPUT_PATH);
+        strcpy(prefix, SEQUENCE_PREFIX);
+        strcpy(result_path, DEFAULT_RESULT_PATH);
+        threshold = SOBEL_THRESHOLD;
+        scale = STRENGTH_RATIO;
+        tolerance = SEQUENCE_TOLERANCE;
+
+        if (!PATH_EXISTS(input_path)) { ERROR_COUT_AND_RETURN(INVALID_FILE_PATH) }
+        if (!PATH_EXISTS(result_path)) { ERROR_COUT_AND_RETURN(INVALID_RESULT_PATH) }
+
+        guide();
+
+    } else {
+        ERROR_COUT_AND_RETURN(INVALID_ARGUMENTS)
+    }
+
+    // the frames, in name order
+    std::vector<std::string> frames;
+    for (const auto &entry: fs::directory_iterator(input_path)) {
+        std::string filename = entry.path().filename().string();
+        if (entry.is_regular_file() && IS_IMAGE(filename.c_str()) && filename.rfind(prefix, 0) == 0)
+            frames.push_back(filename);
+    }
+    std::sort(frames.begin(), frames.end());
+    if (frames.empty()) { ERROR_COUT_AND_RETURN(INVALID_FILE_PATH) }
+
+    std::cout << "\033[1;34m" << "----------------------------------------\n" << "\033[0m";
+    std::cout << "\033[1;34m" << "REPORT: " << "\033[0m\n";
+
+    edge_sequence *sequence = nullptr;
+    std::chrono::high_resolution_clock::duration total{};
+    double total_reuse = 0;
+
+    for (const std::string &frame: frames) {
+        // read the frame
+        int width, height, bpp;
+        ubyte *image = stbi_load((std::string(input_path) + frame).c_str(), &width, &height, &bpp, 1);
+        if (image == nullptr) {
+            free_edge_sequence(sequence);
+            ERROR_COUT_AND_RETURN(INVALID_FILE_PATH)
+        }
+
+        // a frame of another size starts a new sequence
+        if (sequence != nullptr && (sequence->width != (size_t) width || sequence->height != (size_t) height)) {
+            free_edge_sequence(sequence);
+            sequence = nullptr;
+        }
+        if (sequence == nullptr &&
+            create_edge_sequence(width, height, threshold, scale, (ubyte) tolerance, &sequence) != 0) {
+            stbi_image_free(image);
+            return 1;
+        }
+
+        // start the timer
+        auto start = std::chrono::high_resolution_clock::now();
+
+        // apply the filters
+        ubyte *edge_detected_image;
+        double reuse_ratio;
+        if (detect_edges_sequence(sequence, image, &edge_detected_image, &reuse_ratio) != 0) {
+            stbi_image_free(image);
+            free_edge_sequence(sequence);
+            ERROR_COUT_AND_RETURN(EDGE_DETECTION_FAILED)
+        }
+
+        // stop the timer
+        auto finish = std::chrono::high_resolution_clock::now();
+        total += finish - start;
+        total_reuse += reuse_ratio;
+
+        // write the image
+        std::string result = std::string(result_path) + frame.substr(0, frame.rfind('.')) + "_sobel_sequence.png";
+        stbi_write_png(result.c_str(), width, height, 1, edge_detected_image, width);
+
+        std::cout << "\033[1;34m" << frame << ": "
+                  << std::chrono::duration_cast<std::chrono::microseconds>(finish - start).count() << "us, "
+                  << "reused " << reuse_ratio * 100 << "%\n" << "\033[0m";
+
+        stbi_image_free(image);
+        free(edge_detected_image);
+    }
+
+    std::cout << "\033[1;34m" << "Time: "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(total).count()
+              << "ms\n" << "\033[0m";
+    std::cout << "\033[1;34m" << "Average reuse: " << total_reuse / (double) frames.size() * 100 << "%\n"
+              << "\033[0m";
+    std::cout << "\033[1;34m" << "----------------------------------------\n" << "\033[0m\n";
+
+    std::cout << "\033[1;32m" << "----------------------------------------\n" << "\033[0m";
+    std::cout << "\033[1;32m" << "RESULT: " << "\033[0m\n";
+    std::cout << "\033[1;32m" << "Results saved in : " << result_path << "\033[0m\n";
+    std::cout << "\033[1;32m" << "----------------------------------------\n" << "\033[0m\n";
+
+    // free the memory
+    free_edge_sequence(sequence);
+    free(prefix);
+    free(result_path);
+    free(input_path);
+
+    return 0;
+}
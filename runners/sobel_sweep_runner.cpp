@@ -0,0 +1,206 @@
+#include <iostream>
+#include <chrono>
+#include <filesystem>
+#include <vector>
+
+#define STB_IMAGE_IMPLEMENTATION
+
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+
+
+#include "../stb/stb_image.h"
+
+#include "../stb/stb_image_write.h"
+
+#include "../filters/sobel_filter.h"
+
+#include "../filters/parallel.h"
+
+#include "../config.h"
+
+#include "helper.cpp"
+
+namespace fs = std::filesystem;
+
+
+void guide() {
+    std::cout << "\033[1;33m" << "----------------------------------------\n" << "\033[0m";
+
+    std::cout << "\033[1;33m" << "GUIDE: " << "\033[0m\n";
+
+    std::cout << "\033[1;33m" << "No arguments were provided! Default values will be used!" << "\033[0m\n";
+    std::cout << "\033[1;33m"
+              << "Usage: ./sobel_sweep_filter_runner.out <input_path> <input_filename> <result_path> <thresholds> <scales>"
+              << "\033[0m\n";
+
+    std::cout << "\033[1;33m" << "Default values: " << "\033[0m\n";
+    std::cout << "\033[1;33m" << "input_path: " << DEFAULT_INPUT_PATH << "\033[0m\n";
+    std::cout << "\033[1;33m" << "input_filename: " << DEFAULT_INPUT_FILENAME << "\033[0m\n";
+    std::cout << "\033[1;33m" << "result_path: " << DEFAULT_RESULT_PATH << "\033[0m\n";
+    std::cout << "\033[1;33m" << "thresholds: " << SOBEL_SWEEP_THRESHOLDS << "\033[0m\n";
+    std::cout << "\033[1;33m" << "scales: " << SOBEL_SWEEP_RATIOS << "\033[0m\n";
+    std::cout << "\033[1;33m" << "Every threshold is combined with every scale (comma separated lists)" << "\033[0m\n";
+    std::cout << "\033[1;33m" << "Example: ./sobel_sweep_filter_runner.out - - - 50,100,150 0.1,0.3" << "\033[0m\n";
+
+    std::cout << "\033[1;33m" << "----------------------------------------\n" << "\033[0m\n";
+}
+
+/**
+ * Parses a comma separated list of numbers.
+ *
+ * @param list The list to parse.
+ * @param values The parsed values are appended here.
+ * @param min The minimum allowed value.
+ * @param max The maximum allowed value.
+ * @return false if the list is empty or a value is out of range.
+ */
+static bool parse_list(const char *list, std::vector<double> &values, double min, double max) {
+    std::string items(list);
+    size_t begin = 0;
+
+    while (begin <= items.size()) {
+        size_t end = items.find(',', begin);
+        if (end == std::string::npos) end = items.size();
+
+        std::string item = items.substr(begin, end - begin);
+        if (item.empty()) return false;
+
+        double value = atof(item.c_str());
+        if (value < min || value > max) return false;
+        values.push_back(value);
+
+        begin = end + 1;
+    }
+
+    return !values.empty();
+}
+
+int main(int argc, char *argv[]) {
+
+    char *input_filename = (char *) malloc(sizeof(char) * FILENAME_MAX);
+    char *result_path = (char *) malloc(sizeof(char) * (FILENAME_MAX + PATH_MAX));
+    char *input_path = (char *) malloc(sizeof(char) * (FILENAME_MAX + PATH_MAX));
+
+    std::vector<double> thresholds, scales;
+
+    if (argc == 6) {
+        SET_OR_DEFAULT(argv[1], input_path, DEFAULT_INPUT_PATH)
+        SET_OR_DEFAULT(argv[2], input_filename, DEFAULT_INPUT_FILENAME)
+        SET_OR_DEFAULT(argv[3], result_path, DEFAULT_RESULT_PATH)
+
+        if (!IS_IMAGE(input_filename)) { ERROR_COUT_AND_RETURN(INVALID_FILE_TYPE) }
+
+        // construct the input path
+        strcat(input_path, input_filename);
+
+        // check if the path is valid and the file exists
+        if (!PATH_EXISTS(input_path)) { ERROR_COUT_AND_RETURN(INVALID_FILE_PATH) }
+
+        // check if the result path is valid
+        if (!PATH_EXISTS(result_path)) { ERROR_COUT_AND_RETURN(INVALID_RESULT_PATH) }
+
+        // remove the extension
+        REMOVE_EXTENSION(input_filename)
+
+        // fourth arg is the list of thresholds
+        const char *threshold_list = strcmp(argv[4], "-") == 0 ? SOBEL_SWEEP_THRESHOLDS : argv[4];
+        if (!parse_list(threshold_list, thresholds, 0, 255)) { ERROR_COUT_AND_RETURN(INVALID_THRESHOLD) }
+
+        // fifth arg is the list of scales
+        const char *scale_list = strcmp(argv[5], "-") == 0 ? SOBEL_SWEEP_RATIOS : argv[5];
+        if (!parse_list(scale_list, scales, 0, 1)) { ERROR_COUT_AND_RETURN(INVALID_SCALE_FACTOR) }
+
+    } else if (argc == 1) {
+        // use default values
+        strcpy(input_path, DEFAULT_INPUT_PATH);
+        strcpy(input_filename, DEFAULT_INPUT_FILENAME);
+        strcat(input_path, input_filename);
+        strcpy(result_path, DEFAULT_RESULT_PATH);
+
+        if (!IS_IMAGE(input_path)) { ERROR_COUT_AND_RETURN(INVALID_FILE_TYPE) }
+        if (!PATH_EXISTS(input_path)) { ERROR_COUT_AND_RETURN(INVALID_FILE_PATH) }
+        if (!PATH_EXISTS(result_path)) { ERROR_COUT_AND_RETURN(INVALID_RESULT_PATH) }
+        if (!parse_list(SOBEL_SWEEP_THRESHOLDS, thresholds, 0, 255)) { ERROR_COUT_AND_RETURN(INVALID_THRESHOLD) }
+        if (!parse_list(SOBEL_SWEEP_RATIOS, scales, 0, 1)) { ERROR_COUT_AND_RETURN(INVALID_SCALE_FACTOR) }
+
+        // remove the extension
+        REMOVE_EXTENSION(input_filename)
+
+        guide();
+
+    } else {
+        ERROR_COUT_AND_RETURN(INVALID_ARGUMENTS)
+    }
+
+    // build the (threshold, scale) pairs
+    size_t count = thresholds.size() * scales.size();
+    std::vector<ubyte> pair_thresholds;
+    std::vector<double> pair_scales;
+    for (double threshold: thresholds) {
+        for (double scale: scales) {
+            pair_thresholds.push_back((ubyte) threshold);
+            pair_scales.push_back(scale);
+        }
+    }
+
+    // read the image
+    int width, height, bpp;
+    ubyte *image = stbi_load(input_path, &width, &height, &bpp, 1);
+
+    // start the timer
+    auto start = std::chrono::high_resolution_clock::now();
+
+    // compute the magnitudes once
+    unsigned short *magnitudes;
+    if (compute_magnitudes(image, &magnitudes, width, height, nullptr) != 0) return 1;
+
+    // apply every pair over the cached magnitudes
+    std::vector<ubyte *> edge_detected_images(count);
+    if (apply_edge_strength_sweep(magnitudes, edge_detected_images.data(), count,
+                                  width, height,
+                                  pair_thresholds.data(), pair_scales.data()) != 0)
+        return 1;
+
+    // stop the timer
+    auto finish = std::chrono::high_resolution_clock::now();
+
+    // write the images, one encoder per thread
+    std::vector<std::string> result_paths(count);
+    for (size_t k = 0; k < count; k++) {
+        char suffix[64];
+        snprintf(suffix, sizeof(suffix), "_sobel_t%d_s%g.png", (int) pair_thresholds[k], pair_scales[k]);
+        result_paths[k] = std::string(result_path) + input_filename + suffix;
+    }
+
+    parallel_for(0, count, [&](size_t begin, size_t end, size_t) {
+        for (size_t k = begin; k < end; k++)
+            stbi_write_png(result_paths[k].c_str(), width, height, 1, edge_detected_images[k], width);
+    });
+
+
+    std::cout << "\033[1;34m" << "----------------------------------------\n" << "\033[0m";
+    std::cout << "\033[1;34m" << "REPORT: " << "\033[0m\n";
+
+    std::cout << "\033[1;34m" << "Time: "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(finish - start).count()
+              << "ms\n" << "\033[0m";
+    std::cout << "\033[1;34m" << "Combinations: " << count << "\n" << "\033[0m";
+    std::cout << "\033[1;34m" << "----------------------------------------\n" << "\033[0m\n";
+
+    std::cout << "\033[1;32m" << "----------------------------------------\n" << "\033[0m";
+    std::cout << "\033[1;32m" << "RESULT: " << "\033[0m\n";
+    for (auto &path: result_paths) {
+        std::cout << "\033[1;32m" << "Result saved in : " << path << "\033[0m\n";
+    }
+    std::cout << "\033[1;32m" << "----------------------------------------\n" << "\033[0m\n";
+
+    // free the memory
+    free(input_filename);
+    free(result_path);
+    free(input_path);
+    free(magnitudes);
+    stbi_image_free(image);
+    for (ubyte *edge_detected_image: edge_detected_images) stbi_image_free(edge_detected_image);
+
+    return 0;
+}
@@ -0,0 +1,226 @@
+#include <iostream>
+#include <chrono>
+#include <filesystem>
+#include <cstring>
+#include <climits>
+#include <string>
+#include <thread>
+
+#include "../filters/video_io.h"
+
+#include "../filters/edge_operators.h"
+
+#include "../config.h"
+
+#include "helper.cpp"
+
+namespace fs = std::filesystem;
+
+
+void guide() {
+    std::cerr << "\033[1;33m" << "----------------------------------------\n" << "\033[0m";
+
+    std::cerr << "\033[1;33m" << "GUIDE: " << "\033[0m\n";
+
+    std::cerr << "\033[1;33m" << "No arguments were provided! Default values will be used!" << "\033[0m\n";
+    std::cerr << "\033[1;33m"
+              << "Usage: ./sobel_video_filter_runner.out <input_file> <result_file> <format> <width> <height> <threshold> <scale>"
+              << "\033[0m\n";
+
+    std::cerr << "\033[1;33m" << "Default values: " << "\033[0m\n";
+    std::cerr << "\033[1;33m" << "input_file: " << DEFAULT_INPUT_PATH << VIDEO_INPUT_FILENAME << "\033[0m\n";
+    std::cerr << "\033[1;33m" << "result_file: " << DEFAULT_RESULT_PATH << VIDEO_RESULT_FILENAME << "\033[0m\n";
+    std::cerr << "\033[1;33m" << "format: " << VIDEO_FORMAT << "\033[0m\n";
+    std::cerr << "\033[1;33m" << "threshold: " << SOBEL_THRESHOLD << "\033[0m\n";
+    std::cerr << "\033[1;33m" << "scale: " << STRENGTH_RATIO << "\033[0m\n";
+    std::cerr << "\033[1;33m" << "Use '-' as the input or result file for stdin or stdout!" << "\033[0m\n";
+    std::cerr << "\033[1;33m" << "The width and height are only needed for raw i420 and nv12 input!" << "\033[0m\n";
+    std::cerr << "\033[1;33m"
+              << "Example: ffmpeg -i in.mp4 -f yuv4mpegpipe - | ./sobel_video_filter_runner.out - out.y4m y4m - - 50 0.3"
+              << "\033[0m\n";
+
+    std::cerr << "\033[1;33m" << "----------------------------------------\n" << "\033[0m\n";
+}
+
+/**
+ * Parses the name of a video format.
+ *
+ * @param name "y4m", "i420" or "nv12".
+ * @param format The parsed format.
+ * @return false if the name is unknown.
+ */
+static bool parse_format(const char *name, video_format *format) {
+    if (strcmp(name, "y4m") == 0) *format = VIDEO_Y4M;
+    else if (strcmp(name, "i420") == 0) *format = VIDEO_I420;
+    else if (strcmp(name, "nv12") == 0) *format = VIDEO_NV12;
+    else return false;
+    return true;
+}
+
+// errors go to stderr when the frames go to stdout, so that they never end up in the video stream
+#define VIDEO_ERROR_AND_RETURN(message) \
+    if (to_stdout) { ERROR_CERR_AND_RETURN(message) } \
+    ERROR_COUT_AND_RETURN(message)
+
+int main(int argc, char *argv[]) {
+
+    bool to_stdout = argc == 8 && strcmp(argv[2], "-") == 0;
+
+    char *input_path = (char *) malloc(sizeof(char) * (FILENAME_MAX + PATH_MAX));
+    char *result_path = (char *) malloc(sizeof(char) * (FILENAME_MAX + PATH_MAX));
+
+    video_format format;
+    long width = 0, height = 0;
+    ubyte threshold;
+    double scale;
+
+    if (argc == 8) {
+        if (strcmp(argv[1], "-") == 0) strcpy(input_path, "-");
+        else strcpy(input_path, argv[1]);
+        if (strcmp(argv[2], "-") == 0) strcpy(result_path, "-");
+        else strcpy(result_path, argv[2]);
+
+        // check if the input file exists
+        if (strcmp(input_path, "-") != 0 && !PATH_EXISTS(input_path)) { VIDEO_ERROR_AND_RETURN(INVALID_FILE_PATH) }
+
+        // third arg is the format
+        if (!parse_format(strcmp(argv[3], "-") == 0 ? VIDEO_FORMAT : argv[3], &format)) {
+            VIDEO_ERROR_AND_RETURN(INVALID_VIDEO_FORMAT)
+        }
+
+        // fourth and fifth args are the size of raw frames
+        if (format != VIDEO_Y4M) {
+            width = atol(argv[4]);
+            height = atol(argv[5]);
+            if (width < 1 || height < 1) { VIDEO_ERROR_AND_RETURN(INVALID_SIZE) }
+        }
+
+        // sixth arg is the threshold
+        int threshold_value = atoi(argv[6]);
+        if (threshold_value < 0 || threshold_value > 255) { VIDEO_ERROR_AND_RETURN(INVALID_THRESHOLD) }
+        threshold = (ubyte) threshold_value;
+
+        // seventh arg is the scale
+        scale = atof(argv[7]);
+        if (scale < 0 || scale > 1) { VIDEO_ERROR_AND_RETURN(INVALID_SCALE_FACTOR) }
+
+    } else if (argc == 1) {
+        // use default values
+        strcpy(input_path, DEFAULT_INPUT_PATH);
+        strcat(input_path, VIDEO_INPUT_FILENAME);
+        strcpy(result_path, DEFAULT_RESULT_PATH);
+        strcat(result_path, VIDEO_RESULT_FILENAME);
+        threshold = SOBEL_THRESHOLD;
+        scale = STRENGTH_RATIO;
+
+        guide();
+
+        if (!PATH_EXISTS(input_path)) { VIDEO_ERROR_AND_RETURN(INVALID_FILE_PATH) }
+        if (!parse_format(VIDEO_FORMAT, &format)) { VIDEO_ERROR_AND_RETURN(INVALID_VIDEO_FORMAT) }
+        if (format != VIDEO_Y4M) { VIDEO_ERROR_AND_RETURN(INVALID_SIZE) }
+
+    } else {
+        VIDEO_ERROR_AND_RETURN(INVALID_ARGUMENTS)
+    }
+
+    // the report and the messages of the filters go to stderr when the frames go to stdout
+    std::ostream &report = to_stdout ? std::cerr : std::cout;
+    std::streambuf *cout_buffer = std::cout.rdbuf();
+    if (to_stdout) std::cout.rdbuf(std::cerr.rdbuf());
+
+    video_reader *reader;
+    if (open_video_reader(input_path, format, width, height, &reader) != 0) {
+        std::cout.rdbuf(cout_buffer);
+        return 1;
+    }
+
+    // y4m output for a .y4m result or y4m piped to stdout, raw frames in the layout of the input otherwise
+    size_t length = strlen(result_path);
+    bool y4m_output = (length >= 4 && strcmp(result_path + length - 4, ".y4m") == 0) ||
+                      (to_stdout && format == VIDEO_Y4M);
+    video_format output_format = y4m_output ? VIDEO_Y4M : (format == VIDEO_NV12 ? VIDEO_NV12 : VIDEO_I420);
+
+    video_writer *writer;
+    if (open_video_writer(result_path, output_format, reader->width, reader->height, reader->parameters, &writer) != 0) {
+        close_video_reader(reader);
+        std::cout.rdbuf(cout_buffer);
+        return 1;
+    }
+
+    size_t frame_size = reader->width * reader->height;
+    auto *current = (ubyte *) malloc(frame_size);
+    auto *next = (ubyte *) malloc(frame_size);
+
+    bool end_of_stream, next_end = false;
+    int state = read_video_frame(reader, current, &end_of_stream);
+    int next_state = 0;
+
+    size_t frames = 0;
+    std::chrono::high_resolution_clock::duration total{};
+    auto wall_start = std::chrono::high_resolution_clock::now();
+
+    while (state == 0 && !end_of_stream) {
+        // read the next frame while this one is processed
+        std::thread prefetch([&]() { next_state = read_video_frame(reader, next, &next_end); });
+
+        // start the timer
+        auto start = std::chrono::high_resolution_clock::now();
+
+        // the luma plane is the gray scale input
+        ubyte *edge_detected_image;
+        state = detect_edges_operator(
+                current,
+                &edge_detected_image,
+                reader->width, reader->height,
+                OPERATOR_SOBEL, threshold, scale);
+
+        // stop the timer
+        auto finish = std::chrono::high_resolution_clock::now();
+        total += finish - start;
+
+        if (state == 0) {
+            state = write_video_frame(writer, edge_detected_image);
+            free(edge_detected_image);
+            frames++;
+        }
+
+        prefetch.join();
+        std::swap(current, next);
+        if (state == 0) state = next_state;
+        end_of_stream = next_end;
+    }
+
+    auto wall_finish = std::chrono::high_resolution_clock::now();
+
+    close_video_writer(writer);
+    close_video_reader(reader);
+    free(current);
+    free(next);
+    std::cout.rdbuf(cout_buffer);
+
+    if (state != 0) { VIDEO_ERROR_AND_RETURN(INVALID_VIDEO) }
+
+
+    report << "\033[1;34m" << "----------------------------------------\n" << "\033[0m";
+    report << "\033[1;34m" << "REPORT: " << "\033[0m\n";
+
+    report << "\033[1;34m" << "Frames: " << frames << "\n" << "\033[0m";
+    report << "\033[1;34m" << "Time: "
+           << std::chrono::duration_cast<std::chrono::milliseconds>(total).count()
+           << "ms\n" << "\033[0m";
+    report << "\033[1;34m" << "Time with reading and writing: "
+           << std::chrono::duration_cast<std::chrono::milliseconds>(wall_finish - wall_start).count()
+           << "ms\n" << "\033[0m";
+    report << "\033[1;34m" << "----------------------------------------\n" << "\033[0m\n";
+
+    report << "\033[1;32m" << "----------------------------------------\n" << "\033[0m";
+    report << "\033[1;32m" << "RESULT: " << "\033[0m\n";
+    report << "\033[1;32m" << "Result saved in : " << (to_stdout ? "stdout" : result_path) << "\033[0m\n";
+    report << "\033[1;32m" << "----------------------------------------\n" << "\033[0m\n";
+
+    // free the memory
+    free(input_path);
+    free(result_path);
+
+    return 0;
+}